@@ -1,37 +1,65 @@
 ﻿#include "SFT_FloatingTextComponent.h"
 
 #include "SFT_FloatingTextActor.h"
+#include "SFT_FloatingTextProxyBlock.h"
+#include "SFT_FloatingTextSubsystem.h"
 
 USFT_FloatingTextComponent::USFT_FloatingTextComponent()
 {
-    FloatingTextActorClass = ASFT_FloatingTextActor::StaticClass();
+}
+
+void USFT_FloatingTextComponent::AddFloatingText(const FVector &Location, const FText &Text)
+{
+    USFT_FloatingTextSubsystem *Subsystem = GetFloatingTextSubsystem();
+    if (IsValid(Subsystem))
+    {
+        Subsystem->AddText(this, Location, Text.ToString(), StyleIndex);
+    }
+}
+
+void USFT_FloatingTextComponent::AddFloatingNumber(const FVector &Location, float Value, AActor *Target)
+{
+    USFT_FloatingTextSubsystem *Subsystem = GetFloatingTextSubsystem();
+    if (IsValid(Subsystem))
+    {
+        const UObject *Source = (IsValid(Target)) ? (static_cast<const UObject*>(Target)) : (this);
+        Subsystem->AddNumber(Source, Location, Value, StyleIndex, Aggregation);
+    }
 }
 
 void USFT_FloatingTextComponent::SpawnFloatingText(const FVector &SpawnLocation,
     ASFT_FloatingTextActor *&OutFloatingTextActor, UCommonTextBlock *&OutTextBlock)
 {
-    if (!FloatingTextActorClass)
+    OutFloatingTextActor = nullptr;
+    OutTextBlock = nullptr;
+
+    USFT_FloatingTextSubsystem *Subsystem = GetFloatingTextSubsystem();
+    if (!IsValid(Subsystem))
     {
-        UE_LOG(LogScreenFloatingText, Warning, TEXT("Floating Text Actor Class is NULL."));
         return;
     }
-    
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-    UWorld *World = GetWorld();
-    AActor *Actor = World->SpawnActor(FloatingTextActorClass, &SpawnLocation, nullptr, SpawnParams);
-    if (!IsValid(Actor))
+    // Callers set the text right away, hence a single proxy is enough to route it into the subsystem
+    USFT_FloatingTextProxyBlock *ProxyTextBlock = Subsystem->GetProxyTextBlock();
+    ProxyTextBlock->SetPendingText(this, SpawnLocation);
+
+    OutFloatingTextActor = Subsystem->GetProxyActor();
+    OutTextBlock = ProxyTextBlock;
+}
+
+USFT_FloatingTextSubsystem *USFT_FloatingTextComponent::GetFloatingTextSubsystem()
+{
+    USFT_FloatingTextSubsystem *Subsystem = USFT_FloatingTextSubsystem::Get(this);
+    if (!IsValid(Subsystem))
     {
-        UE_LOG(LogScreenFloatingText, Warning, TEXT("Failed to spawn a Floating Text Actor."));
-        return;
+        // There is no subsystem on dedicated servers, nothing to warn about
+        return nullptr;
     }
 
-    auto FloatingTextActor = Cast<ASFT_FloatingTextActor>(Actor);
-    UCommonTextBlock *TextBlock = FloatingTextActor->GetTextBlock();
-
-    OutFloatingTextActor = FloatingTextActor;
-    OutTextBlock = TextBlock;
+    if (StyleIndex == INDEX_NONE)
+    {
+        StyleIndex = Subsystem->RegisterStyle(Style);
+    }
 
-    FloatingTextActors.Add(FloatingTextActor);
+    return Subsystem;
 }
@@ -0,0 +1,38 @@
+﻿#include "SFT_FloatingTextProxyBlock.h"
+
+#include "Internationalization/FastDecimalFormat.h"
+#include "SFT_FloatingTextComponent.h"
+
+void USFT_FloatingTextProxyBlock::SetPendingText(USFT_FloatingTextComponent *InComponent, const FVector &InLocation)
+{
+    PendingComponent = InComponent;
+    PendingLocation = InLocation;
+}
+
+void USFT_FloatingTextProxyBlock::SetText(FText InText)
+{
+    Super::SetText(InText);
+
+    // The block is shared, hence a text is displayed only once per request
+    USFT_FloatingTextComponent *Component = PendingComponent.Get();
+    PendingComponent = nullptr;
+
+    if (!IsValid(Component))
+    {
+        return;
+    }
+
+    // Numbers formatted as texts are turned back into numbers, so that they are aggregated like the new API does
+    double Value = 0.0;
+    const FString String = InText.ToString();
+    const FDecimalNumberFormattingRules &FormattingRules =
+        FInternationalization::Get().GetCurrentCulture()->GetDecimalNumberFormattingRules();
+    if ((InText.IsNumeric()) && (FastDecimalFormat::StringToNumber(*String, String.Len(), FormattingRules,
+        FNumberParsingOptions::DefaultWithGrouping(), Value)))
+    {
+        Component->AddFloatingNumber(PendingLocation, static_cast<float>(Value));
+        return;
+    }
+
+    Component->AddFloatingText(PendingLocation, InText);
+}
@@ -0,0 +1,451 @@
+﻿#include "SFT_FloatingTextSubsystem.h"
+
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "SceneView.h"
+#include "UnrealClient.h"
+#include "SFT_FloatingTextActor.h"
+#include "SFT_FloatingTextProxyBlock.h"
+#include "SSFT_FloatingTextCanvas.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tick"), STAT_SftTick, STATGROUP_ScreenFloatingText);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Texts"), STAT_SftActiveTexts, STATGROUP_ScreenFloatingText);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Added Texts"), STAT_SftAddedTexts, STATGROUP_ScreenFloatingText);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Merged Texts"), STAT_SftMergedTexts, STATGROUP_ScreenFloatingText);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aggregated Texts"), STAT_SftAggregatedTexts, STATGROUP_ScreenFloatingText);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Texts"), STAT_SftDroppedTexts, STATGROUP_ScreenFloatingText);
+
+/** Canvas is put above the regular HUD widgets. */
+constexpr int32 CanvasZOrder = 10;
+
+USFT_FloatingTextSubsystem *USFT_FloatingTextSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<USFT_FloatingTextSubsystem>()) : (nullptr);
+}
+
+bool USFT_FloatingTextSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    if (IsRunningDedicatedServer())
+    {
+        return false;
+    }
+
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void USFT_FloatingTextSubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+    Super::Initialize(Collection);
+
+    MaxEntries = FMath::Max(MaxEntries, 1);
+    Entries.Reserve(MaxEntries);
+}
+
+void USFT_FloatingTextSubsystem::Deinitialize()
+{
+    DestroyCanvas();
+    Entries.Empty();
+
+    ProxyTextBlock = nullptr;
+    ProxyActor = nullptr;
+
+    Super::Deinitialize();
+}
+
+void USFT_FloatingTextSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SftTick);
+
+#if !UE_BUILD_SHIPPING
+    TickStressTest(DeltaTime);
+#endif
+
+    UpdateEntries(DeltaTime);
+    SET_DWORD_STAT(STAT_SftActiveTexts, Entries.Num());
+
+    if (Entries.IsEmpty())
+    {
+        return;
+    }
+
+    if (!Canvas.IsValid())
+    {
+        CreateCanvas();
+    }
+
+    ProjectEntries();
+}
+
+TStatId USFT_FloatingTextSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USFT_FloatingTextSubsystem, STATGROUP_Tickables);
+}
+
+int32 USFT_FloatingTextSubsystem::RegisterStyle(const FSFT_FloatingTextStyle &Style)
+{
+    return Styles.AddUnique(Style);
+}
+
+void USFT_FloatingTextSubsystem::AddText(const UObject *Source, const FVector &WorldLocation, const FString &Text,
+    int32 StyleIndex)
+{
+    check(Styles.IsValidIndex(StyleIndex));
+
+    bool bMerged = false;
+    FSFT_FloatingTextEntry *Entry = AllocateEntry(Source, false, StyleIndex, bMerged);
+    if (!Entry)
+    {
+        INC_DWORD_STAT(STAT_SftDroppedTexts);
+        return;
+    }
+
+    INC_DWORD_STAT(STAT_SftAddedTexts);
+
+    Entry->WorldLocation = WorldLocation;
+    Entry->Source = Source;
+    Entry->StyleIndex = StyleIndex;
+    Entry->bNumeric = false;
+    Entry->Value = 0.f;
+    SetEntryText(*Entry, FString(Text));
+}
+
+USFT_FloatingTextProxyBlock *USFT_FloatingTextSubsystem::GetProxyTextBlock()
+{
+    if (!IsValid(ProxyTextBlock))
+    {
+        ProxyTextBlock = NewObject<USFT_FloatingTextProxyBlock>(this);
+    }
+
+    return ProxyTextBlock;
+}
+
+ASFT_FloatingTextActor *USFT_FloatingTextSubsystem::GetProxyActor()
+{
+    if (!IsValid(ProxyActor))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnParams.ObjectFlags |= RF_Transient;
+
+        ProxyActor = GetWorld()->SpawnActor<ASFT_FloatingTextActor>(SpawnParams);
+        if (IsValid(ProxyActor))
+        {
+            ProxyActor->SetActorHiddenInGame(true);
+        }
+    }
+
+    return ProxyActor;
+}
+
+void USFT_FloatingTextSubsystem::AddNumber(const UObject *Source, const FVector &WorldLocation, float Value,
+    int32 StyleIndex, const FSFT_NumberAggregation &Aggregation)
+{
+    check(Styles.IsValidIndex(StyleIndex));
+
+    FSFT_FloatingTextEntry *Entry = FindAggregationEntry(Source, StyleIndex, Aggregation);
+    if (Entry)
+    {
+        INC_DWORD_STAT(STAT_SftAggregatedTexts);
+        MergeIntoEntry(*Entry, Value);
+        return;
+    }
+
+    bool bMerged = false;
+    Entry = AllocateEntry(Source, true, StyleIndex, bMerged);
+    if (!Entry)
+    {
+        INC_DWORD_STAT(STAT_SftDroppedTexts);
+        return;
+    }
+
+    if (bMerged)
+    {
+        INC_DWORD_STAT(STAT_SftMergedTexts);
+        MergeIntoEntry(*Entry, Value);
+        return;
+    }
+
+    INC_DWORD_STAT(STAT_SftAddedTexts);
+
+    Entry->WorldLocation = WorldLocation;
+    Entry->Source = Source;
+    Entry->StyleIndex = StyleIndex;
+    Entry->bNumeric = true;
+    Entry->Value = Value;
+    SetEntryText(*Entry, FString::FromInt(FMath::RoundToInt(Entry->Value)));
+}
+
+FSFT_FloatingTextEntry *USFT_FloatingTextSubsystem::FindAggregationEntry(const UObject *Source, int32 StyleIndex,
+    const FSFT_NumberAggregation &Aggregation)
+{
+    const bool bHasWindow = (Aggregation.Window > 0.f);
+    const bool bHasCap = (Aggregation.MaxPerSource > 0);
+    if ((!bHasWindow) && (!bHasCap))
+    {
+        return nullptr;
+    }
+
+    int32 Count = 0;
+    FSFT_FloatingTextEntry *Youngest = nullptr;
+    for (FSFT_FloatingTextEntry &Entry : Entries)
+    {
+        if ((Entry.bNumeric) && (Entry.StyleIndex == StyleIndex) && (Entry.Source == Source))
+        {
+            Count++;
+            if ((!Youngest) || (Entry.AggregationAge < Youngest->AggregationAge))
+            {
+                Youngest = &Entry;
+            }
+        }
+    }
+
+    if (!Youngest)
+    {
+        return nullptr;
+    }
+
+    const bool bInWindow = ((bHasWindow) && (Youngest->AggregationAge < Aggregation.Window));
+    const bool bCapReached = ((bHasCap) && (Count >= Aggregation.MaxPerSource));
+    return ((bInWindow) || (bCapReached)) ? (Youngest) : (nullptr);
+}
+
+void USFT_FloatingTextSubsystem::MergeIntoEntry(FSFT_FloatingTextEntry &Entry, float Value) const
+{
+    const FSFT_FloatingTextStyle &Style = Styles[Entry.StyleIndex];
+
+    // Don't restart the lifetime to avoid the text jumping back down, just prevent it from fading out
+    Entry.Age = FMath::Min(Entry.Age, FMath::Max(Style.Lifetime - Style.FadeOutTime, 0.f));
+    Entry.Value += Value;
+    SetEntryText(Entry, FString::FromInt(FMath::RoundToInt(Entry.Value)));
+}
+
+FSFT_FloatingTextEntry *USFT_FloatingTextSubsystem::AllocateEntry(const UObject *Source, bool bNumeric,
+    int32 StyleIndex, bool &bOutMerged)
+{
+    bOutMerged = false;
+
+    if (Entries.Num() < MaxEntries)
+    {
+        FSFT_FloatingTextEntry &Entry = Entries.AddDefaulted_GetRef();
+        return &Entry;
+    }
+
+    switch (OverflowPolicy)
+    {
+    case ESFT_OverflowPolicy::ReplaceOldest:
+    {
+        int32 OldestIndex = 0;
+        for (int32 Index = 1; Index < Entries.Num(); Index++)
+        {
+            if (Entries[Index].Age > Entries[OldestIndex].Age)
+            {
+                OldestIndex = Index;
+            }
+        }
+
+        FSFT_FloatingTextEntry &Entry = Entries[OldestIndex];
+        Entry = FSFT_FloatingTextEntry();
+        return &Entry;
+    }
+    case ESFT_OverflowPolicy::MergeOrDrop:
+    {
+        if (!bNumeric)
+        {
+            return nullptr;
+        }
+
+        // Merge into the youngest number of the same source, so that the sum stays on screen for the longest
+        FSFT_FloatingTextEntry *Youngest = nullptr;
+        for (FSFT_FloatingTextEntry &Entry : Entries)
+        {
+            if ((Entry.bNumeric) && (Entry.StyleIndex == StyleIndex) && (Entry.Source == Source) &&
+                ((!Youngest) || (Entry.AggregationAge < Youngest->AggregationAge)))
+            {
+                Youngest = &Entry;
+            }
+        }
+
+        bOutMerged = (Youngest != nullptr);
+        return Youngest;
+    }
+    case ESFT_OverflowPolicy::Drop:
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+void USFT_FloatingTextSubsystem::SetEntryText(FSFT_FloatingTextEntry &Entry, FString &&Text) const
+{
+    Entry.Text = MoveTemp(Text);
+
+    // Measure once here, rather than on each paint
+    if (FSlateApplication::IsInitialized())
+    {
+        const TSharedRef<FSlateFontMeasure> FontMeasure =
+            FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+        Entry.TextSize = FontMeasure->Measure(Entry.Text, Styles[Entry.StyleIndex].Font);
+    }
+}
+
+void USFT_FloatingTextSubsystem::UpdateEntries(float DeltaTime)
+{
+    for (int32 Index = Entries.Num() - 1; Index >= 0; Index--)
+    {
+        FSFT_FloatingTextEntry &Entry = Entries[Index];
+        const FSFT_FloatingTextStyle &Style = Styles[Entry.StyleIndex];
+
+        Entry.Age += DeltaTime;
+        Entry.AggregationAge += DeltaTime;
+        if (Entry.Age >= Style.Lifetime)
+        {
+            // Order doesn't matter, and swapping keeps the pool compact without shifting
+            Entries.RemoveAtSwap(Index, 1, false);
+            continue;
+        }
+
+        const float TimeLeft = Style.Lifetime - Entry.Age;
+        Entry.Opacity = ((Style.FadeOutTime > 0.f) && (TimeLeft < Style.FadeOutTime)) ?
+            (TimeLeft / Style.FadeOutTime) : (1.f);
+    }
+}
+
+void USFT_FloatingTextSubsystem::ProjectEntries()
+{
+    const UWorld *World = GetWorld();
+    const APlayerController *PlayerController = World->GetFirstPlayerController();
+    const ULocalPlayer *LocalPlayer = (IsValid(PlayerController)) ? (PlayerController->GetLocalPlayer()) : (nullptr);
+
+    FSceneViewProjectionData ProjectionData;
+    const bool bHasProjection = ((IsValid(LocalPlayer)) && (IsValid(LocalPlayer->ViewportClient)) &&
+        (LocalPlayer->ViewportClient->Viewport) &&
+        (LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)));
+
+    if (!bHasProjection)
+    {
+        ViewportSize = FIntPoint::ZeroValue;
+        return;
+    }
+
+    ViewportSize = LocalPlayer->ViewportClient->Viewport->GetSizeXY();
+
+    // Compute the matrix once, and project all the entries with it
+    const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+    const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+    for (FSFT_FloatingTextEntry &Entry : Entries)
+    {
+        const FSFT_FloatingTextStyle &Style = Styles[Entry.StyleIndex];
+        const FVector Location = Entry.WorldLocation + FVector(0.f, 0.f, Style.RiseSpeed * Entry.Age);
+
+        Entry.bOnScreen = FSceneView::ProjectWorldToScreen(
+            Location, ViewRect, ViewProjectionMatrix, Entry.ScreenPosition);
+    }
+}
+
+void USFT_FloatingTextSubsystem::CreateCanvas()
+{
+    UGameViewportClient *ViewportClient = GetWorld()->GetGameViewport();
+    if (!IsValid(ViewportClient))
+    {
+        return;
+    }
+
+    Canvas = SNew(SSFT_FloatingTextCanvas).Subsystem(this);
+    ViewportClient->AddViewportWidgetContent(Canvas.ToSharedRef(), CanvasZOrder);
+}
+
+void USFT_FloatingTextSubsystem::DestroyCanvas()
+{
+    if (!Canvas.IsValid())
+    {
+        return;
+    }
+
+    UGameViewportClient *ViewportClient = GetWorld()->GetGameViewport();
+    if (IsValid(ViewportClient))
+    {
+        ViewportClient->RemoveViewportWidgetContent(Canvas.ToSharedRef());
+    }
+
+    Canvas.Reset();
+}
+
+#if !UE_BUILD_SHIPPING
+void USFT_FloatingTextSubsystem::StartStressTest(int32 TextsPerSecond, float Seconds)
+{
+    StressTextsPerSecond = FMath::Max(TextsPerSecond, 0);
+    StressTimeRemaining = FMath::Max(Seconds, 0.f);
+    StressSpawnAccumulator = 0.f;
+
+    if (StressStyleIndex == INDEX_NONE)
+    {
+        StressStyleIndex = RegisterStyle(FSFT_FloatingTextStyle());
+    }
+
+    UE_LOG(LogScreenFloatingText, Display, TEXT("Stress test: %d texts per second for %.1f seconds."),
+        StressTextsPerSecond, StressTimeRemaining);
+}
+
+void USFT_FloatingTextSubsystem::TickStressTest(float DeltaTime)
+{
+    if (StressTimeRemaining <= 0.f)
+    {
+        return;
+    }
+
+    StressTimeRemaining -= DeltaTime;
+    StressSpawnAccumulator += StressTextsPerSecond * DeltaTime;
+
+    const APlayerController *PlayerController = GetWorld()->GetFirstPlayerController();
+    const APawn *Pawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+    const FVector Center = (IsValid(Pawn)) ? (Pawn->GetActorLocation()) : (FVector::ZeroVector);
+
+    // Numbers are not aggregated, so that every one of them takes an entry and the pool gets filled up
+    FSFT_NumberAggregation NoAggregation;
+    NoAggregation.Window = 0.f;
+    NoAggregation.MaxPerSource = 0;
+
+    constexpr float SpawnRadius = 1000.f;
+    while (StressSpawnAccumulator >= 1.f)
+    {
+        StressSpawnAccumulator -= 1.f;
+
+        // Spread the numbers between a few sources to exercise merging on overflow
+        const FVector Offset = FMath::VRand() * FMath::FRandRange(0.f, SpawnRadius);
+        const UObject *Source = (FMath::RandBool()) ? (static_cast<const UObject*>(this)) : (Pawn);
+        AddNumber(Source, Center + Offset, FMath::FRandRange(1.f, 999.f), StressStyleIndex, NoAggregation);
+    }
+
+    if (StressTimeRemaining <= 0.f)
+    {
+        UE_LOG(LogScreenFloatingText, Display, TEXT("Stress test has finished."));
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs StressTestCommand(
+    TEXT("SFT.StressTest"),
+    TEXT("Spawn floating texts around the first player. Usage: SFT.StressTest [TextsPerSecond=1000] [Seconds=10]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        USFT_FloatingTextSubsystem *Subsystem = USFT_FloatingTextSubsystem::Get(World);
+        if (!IsValid(Subsystem))
+        {
+            UE_LOG(LogScreenFloatingText, Warning, TEXT("Floating text subsystem is unavailable in this world."));
+            return;
+        }
+
+        const int32 TextsPerSecond = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (1000);
+        const float Seconds = (Args.IsValidIndex(1)) ? (FCString::Atof(*Args[1])) : (10.f);
+        Subsystem->StartStressTest(TextsPerSecond, Seconds);
+    }));
+#endif
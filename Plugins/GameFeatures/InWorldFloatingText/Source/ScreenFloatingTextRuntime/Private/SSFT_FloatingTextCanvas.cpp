@@ -0,0 +1,66 @@
+﻿#include "SSFT_FloatingTextCanvas.h"
+
+#include "Rendering/DrawElements.h"
+#include "SFT_FloatingTextSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Paint"), STAT_SftPaint, STATGROUP_ScreenFloatingText);
+
+void SSFT_FloatingTextCanvas::Construct(const FArguments &InArgs)
+{
+    Subsystem = InArgs._Subsystem;
+
+    SetVisibility(EVisibility::HitTestInvisible);
+    SetCanTick(false);
+}
+
+int32 SSFT_FloatingTextCanvas::OnPaint(const FPaintArgs &Args, const FGeometry &AllottedGeometry,
+    const FSlateRect &MyCullingRect, FSlateWindowElementList &OutDrawElements, int32 LayerId,
+    const FWidgetStyle &InWidgetStyle, bool bParentEnabled) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SftPaint);
+
+    const USFT_FloatingTextSubsystem *FloatingTextSubsystem = Subsystem.Get();
+    if (!IsValid(FloatingTextSubsystem))
+    {
+        return LayerId;
+    }
+
+    const FIntPoint ViewportSize = FloatingTextSubsystem->GetViewportSize();
+    if ((ViewportSize.X <= 0) || (ViewportSize.Y <= 0))
+    {
+        return LayerId;
+    }
+
+    // Entries are projected in viewport pixels, while the canvas is laid out in slate units
+    const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+    const FVector2D PixelToLocal = LocalSize / FVector2D(ViewportSize);
+
+    for (const FSFT_FloatingTextEntry &Entry : FloatingTextSubsystem->GetEntries())
+    {
+        if ((!Entry.bOnScreen) || (Entry.Opacity <= 0.f))
+        {
+            continue;
+        }
+
+        const FSFT_FloatingTextStyle &Style = FloatingTextSubsystem->GetStyle(Entry.StyleIndex);
+        const FVector2D Position = (Entry.ScreenPosition * PixelToLocal) - (Entry.TextSize * 0.5f);
+        const FLinearColor Color = Style.Color.CopyWithNewOpacity(Style.Color.A * Entry.Opacity);
+
+        FSlateDrawElement::MakeText(
+            OutDrawElements,
+            LayerId,
+            AllottedGeometry.ToPaintGeometry(Position, Entry.TextSize),
+            Entry.Text,
+            Style.Font,
+            ESlateDrawEffect::None,
+            Color * InWidgetStyle.GetColorAndOpacityTint());
+    }
+
+    return LayerId;
+}
+
+FVector2D SSFT_FloatingTextCanvas::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    // The canvas is stretched over the whole viewport, hence doesn't desire anything
+    return FVector2D::ZeroVector;
+}
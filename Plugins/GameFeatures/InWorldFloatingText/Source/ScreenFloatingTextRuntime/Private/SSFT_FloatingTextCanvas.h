@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include "Widgets/SLeafWidget.h"
+#include "ScreenFloatingTextRuntime/sft.h"
+
+class USFT_FloatingTextSubsystem;
+
+/** Leaf widget that draws every floating text of a subsystem in a single paint pass. */
+class SSFT_FloatingTextCanvas : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SSFT_FloatingTextCanvas)
+        {
+        }
+        SLATE_ARGUMENT(TWeakObjectPtr<const USFT_FloatingTextSubsystem>, Subsystem)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments &InArgs);
+
+    //~SWidget Interface
+    virtual int32 OnPaint(const FPaintArgs &Args, const FGeometry &AllottedGeometry,
+        const FSlateRect &MyCullingRect, FSlateWindowElementList &OutDrawElements, int32 LayerId,
+        const FWidgetStyle &InWidgetStyle, bool bParentEnabled) const override;
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+    //~End of SWidget Interface
+
+private:
+    TWeakObjectPtr<const USFT_FloatingTextSubsystem> Subsystem = nullptr;
+};
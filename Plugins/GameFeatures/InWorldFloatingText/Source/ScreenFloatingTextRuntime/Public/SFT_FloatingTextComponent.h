@@ -1,12 +1,14 @@
 ﻿#pragma once
 
 #include "Components/ActorComponent.h"
+#include "SFT_FloatingTextCoreTypes.h"
 #include "ScreenFloatingTextRuntime/sft.h"
 
 #include "SFT_FloatingTextComponent.generated.h"
 
 class ASFT_FloatingTextActor;
 class UCommonTextBlock;
+class USFT_FloatingTextSubsystem;
 class UWidgetComponent;
 
 UCLASS(BlueprintType, Blueprintable, meta=(BlueprintSpawnableComponent))
@@ -17,14 +19,40 @@ class SCREENFLOATINGTEXTRUNTIME_API USFT_FloatingTextComponent : public UActorCo
 public:
     USFT_FloatingTextComponent();
 
+    /** Display a text at the given location. All texts are drawn by the floating text subsystem in a single batch. */
     UFUNCTION(BlueprintCallable, Category="SFT|Floating Text Component")
+    void AddFloatingText(const FVector &Location, const FText &Text);
+
+    /**
+     * Display a number at the given location. Unlike AddFloatingText(), numbers against the same target are summed up
+     * into a single text according to the aggregation rules, and may be merged together when there are too many texts
+     * on screen.
+     * @param  Target  Actor the number relates to, e.g. the damaged one. If null, the component itself is used.
+     */
+    UFUNCTION(BlueprintCallable, Category="SFT|Floating Text Component")
+    void AddFloatingNumber(const FVector &Location, float Value, AActor *Target = nullptr);
+
+    /**
+     * Kept for existing Blueprints. Hands out a shared proxy actor and text block instead of spawning them; setting
+     * the text block's text adds the text to the floating text subsystem at the given location.
+     */
+    UFUNCTION(BlueprintCallable, Category="SFT|Floating Text Component",
+        meta=(DeprecatedFunction, DeprecationMessage="Use AddFloatingText or AddFloatingNumber instead."))
     void SpawnFloatingText(const FVector &SpawnLocation, ASFT_FloatingTextActor *&OutFloatingTextActor,
         UCommonTextBlock *&OutTextBlock);
 
 private:
-    UPROPERTY(EditDefaultsOnly)
-    TSubclassOf<ASFT_FloatingTextActor> FloatingTextActorClass = nullptr;
-    
-    UPROPERTY()
-    TArray<TObjectPtr<ASFT_FloatingTextActor>> FloatingTextActors;
+    /** Find the subsystem and register the style within it if it hasn't been done yet. */
+    USFT_FloatingTextSubsystem *GetFloatingTextSubsystem();
+
+private:
+    /** Look of all the texts spawned by this component. */
+    UPROPERTY(EditDefaultsOnly, Category="SFT|Floating Text Component")
+    FSFT_FloatingTextStyle Style;
+
+    /** How numbers against the same target are summed up. */
+    UPROPERTY(EditDefaultsOnly, Category="SFT|Floating Text Component")
+    FSFT_NumberAggregation Aggregation;
+
+    int32 StyleIndex = INDEX_NONE;
 };
@@ -0,0 +1,82 @@
+﻿#pragma once
+
+#include "Fonts/SlateFontInfo.h"
+#include "Styling/CoreStyle.h"
+#include "ScreenFloatingTextRuntime/sft.h"
+
+#include "SFT_FloatingTextCoreTypes.generated.h"
+
+/** What to do with a new floating text when the subsystem has reached its entry cap. */
+UENUM(BlueprintType)
+enum class ESFT_OverflowPolicy : uint8
+{
+    /** Discard the new text. */
+    Drop,
+
+    /** Recycle the oldest entry for the new text. */
+    ReplaceOldest,
+
+    /** Add numeric texts up to an entry from the same source, discard the rest. */
+    MergeOrDrop
+};
+
+/** Look of a floating text. Shared by all the texts spawned by a single floating text component. */
+USTRUCT(BlueprintType)
+struct FSFT_FloatingTextStyle
+{
+    GENERATED_BODY()
+
+public:
+    FSFT_FloatingTextStyle();
+
+    bool operator==(const FSFT_FloatingTextStyle &Other) const;
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Floating Text Style")
+    FSlateFontInfo Font;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Floating Text Style")
+    FLinearColor Color = FLinearColor::White;
+
+    /** Seconds a text stays on screen for. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Floating Text Style", meta=(ClampMin="0.0"))
+    float Lifetime = 1.f;
+
+    /** Seconds at the end of the lifetime during which a text fades out. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Floating Text Style", meta=(ClampMin="0.0"))
+    float FadeOutTime = 0.3f;
+
+    /** World units per second a text rises with. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Floating Text Style")
+    float RiseSpeed = 100.f;
+};
+
+/** Rules to sum numbers coming from the same source into a single text. */
+USTRUCT(BlueprintType)
+struct FSFT_NumberAggregation
+{
+    GENERATED_BODY()
+
+public:
+    /** Seconds since a number has appeared during which new numbers are added up to it. Zero disables the window. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Number Aggregation", meta=(ClampMin="0.0"))
+    float Window = 0.25f;
+
+    /**
+     * Maximum amount of numbers a single source may have on screen. Once reached, new numbers are added up to the
+     * youngest one. Zero means no limit.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="SFT|Number Aggregation", meta=(ClampMin="0"))
+    int32 MaxPerSource = 3;
+};
+
+inline FSFT_FloatingTextStyle::FSFT_FloatingTextStyle()
+    : Font(FCoreStyle::GetDefaultFontStyle("Bold", 24))
+{
+}
+
+inline bool FSFT_FloatingTextStyle::operator==(const FSFT_FloatingTextStyle &Other) const
+{
+    return ((Font == Other.Font) && (Color == Other.Color) && (Lifetime == Other.Lifetime) &&
+        (FadeOutTime == Other.FadeOutTime) && (RiseSpeed == Other.RiseSpeed));
+}
@@ -0,0 +1,31 @@
+﻿#pragma once
+
+#include "CommonTextBlock.h"
+#include "ScreenFloatingTextRuntime/sft.h"
+
+#include "SFT_FloatingTextProxyBlock.generated.h"
+
+class USFT_FloatingTextComponent;
+
+/**
+ * Text block handed out by the deprecated USFT_FloatingTextComponent::SpawnFloatingText(). It's never displayed;
+ * setting its text adds the text to the floating text subsystem at the location it has been requested at. Numeric texts
+ * are added as numbers, hence they are aggregated per component.
+ */
+UCLASS(NotBlueprintable)
+class SCREENFLOATINGTEXTRUNTIME_API USFT_FloatingTextProxyBlock : public UCommonTextBlock
+{
+    GENERATED_BODY()
+
+public:
+    /** Make the next text set on the block be displayed by the component at the given location. */
+    void SetPendingText(USFT_FloatingTextComponent *InComponent, const FVector &InLocation);
+
+    //~UTextBlock Interface
+    virtual void SetText(FText InText) override;
+    //~End of UTextBlock Interface
+
+private:
+    TWeakObjectPtr<USFT_FloatingTextComponent> PendingComponent = nullptr;
+    FVector PendingLocation = FVector::ZeroVector;
+};
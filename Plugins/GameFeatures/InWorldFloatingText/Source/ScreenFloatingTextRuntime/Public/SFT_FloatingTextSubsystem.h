@@ -0,0 +1,167 @@
+﻿#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "SFT_FloatingTextCoreTypes.h"
+#include "ScreenFloatingTextRuntime/sft.h"
+
+#include "SFT_FloatingTextSubsystem.generated.h"
+
+class ASFT_FloatingTextActor;
+class SSFT_FloatingTextCanvas;
+class USFT_FloatingTextProxyBlock;
+
+/** Single floating text living in the subsystem pool. */
+struct FSFT_FloatingTextEntry
+{
+    /** Location the text has been spawned at. */
+    FVector WorldLocation = FVector::ZeroVector;
+
+    /** Projected location in viewport pixels. Valid only if bOnScreen is true. */
+    FVector2D ScreenPosition = FVector2D::ZeroVector;
+
+    /** Text size in slate units, measured once the text changes. */
+    FVector2D TextSize = FVector2D::ZeroVector;
+
+    FString Text;
+
+    /** Object that has spawned the text. Used to merge texts on overflow. */
+    TWeakObjectPtr<const UObject> Source = nullptr;
+
+    /** Seconds the text has been alive for. May be pushed back to keep an updated number visible. */
+    float Age = 0.f;
+
+    /** Seconds since the text has been spawned. Unlike Age, it's never pushed back. */
+    float AggregationAge = 0.f;
+
+    float Value = 0.f;
+    float Opacity = 1.f;
+    int32 StyleIndex = INDEX_NONE;
+
+    /** Whether the text has been created with a value, rather than with an arbitrary text. */
+    bool bNumeric = false;
+    bool bOnScreen = false;
+};
+
+/**
+ * World subsystem that owns all the floating texts. Entries are stored in a pool of a fixed capacity, animated and
+ * projected to the screen in a single batch per frame, and drawn by a single Slate widget added to the game viewport.
+ */
+UCLASS(Config=Game)
+class SCREENFLOATINGTEXTRUNTIME_API USFT_FloatingTextSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USFT_FloatingTextSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    //~End of FTickableGameObject Interface
+
+    /**
+     * Find an equal style, or store a new one.
+     * @return Index to pass along with texts.
+     */
+    int32 RegisterStyle(const FSFT_FloatingTextStyle &Style);
+
+    /** Add an arbitrary text to display. */
+    void AddText(const UObject *Source, const FVector &WorldLocation, const FString &Text, int32 StyleIndex);
+
+    /**
+     * Add a number to display. Numbers from the same source are summed up according to the aggregation rules, and may
+     * be merged on overflow.
+     */
+    void AddNumber(const UObject *Source, const FVector &WorldLocation, float Value, int32 StyleIndex,
+        const FSFT_NumberAggregation &Aggregation = FSFT_NumberAggregation());
+
+    /** Text block shared by all the deprecated spawn requests. */
+    USFT_FloatingTextProxyBlock *GetProxyTextBlock();
+
+    /** Hidden actor shared by all the deprecated spawn requests, so that callers moving it have something to move. */
+    ASFT_FloatingTextActor *GetProxyActor();
+
+    const TArray<FSFT_FloatingTextEntry> &GetEntries() const;
+    const FSFT_FloatingTextStyle &GetStyle(int32 StyleIndex) const;
+    FIntPoint GetViewportSize() const;
+
+#if !UE_BUILD_SHIPPING
+    /** Spawn the given amount of texts per second around the first player for the given amount of seconds. */
+    void StartStressTest(int32 TextsPerSecond, float Seconds);
+#endif
+
+private:
+    /** Find a number of the same source the new value should be added up to, if any. */
+    FSFT_FloatingTextEntry *FindAggregationEntry(const UObject *Source, int32 StyleIndex,
+        const FSFT_NumberAggregation &Aggregation);
+
+    /** Add a value up to an existing number, and keep it readable for a bit longer if it's fading out. */
+    void MergeIntoEntry(FSFT_FloatingTextEntry &Entry, float Value) const;
+
+    /** Find a free entry respecting the overflow policy. May return nullptr if the text should be dropped. */
+    FSFT_FloatingTextEntry *AllocateEntry(const UObject *Source, bool bNumeric, int32 StyleIndex,
+        bool &bOutMerged);
+
+    void SetEntryText(FSFT_FloatingTextEntry &Entry, FString &&Text) const;
+    void UpdateEntries(float DeltaTime);
+    void ProjectEntries();
+
+    void CreateCanvas();
+    void DestroyCanvas();
+
+#if !UE_BUILD_SHIPPING
+    void TickStressTest(float DeltaTime);
+#endif
+
+private:
+    /** Maximum amount of texts alive at the same time. */
+    UPROPERTY(Config)
+    int32 MaxEntries = 256;
+
+    UPROPERTY(Config)
+    ESFT_OverflowPolicy OverflowPolicy = ESFT_OverflowPolicy::MergeOrDrop;
+
+    /** Pool of entries. Reserved to MaxEntries, hence it never reallocates. */
+    TArray<FSFT_FloatingTextEntry> Entries;
+
+    UPROPERTY()
+    TArray<FSFT_FloatingTextStyle> Styles;
+
+    FIntPoint ViewportSize = FIntPoint::ZeroValue;
+
+    TSharedPtr<SSFT_FloatingTextCanvas> Canvas = nullptr;
+
+    UPROPERTY()
+    TObjectPtr<USFT_FloatingTextProxyBlock> ProxyTextBlock = nullptr;
+
+    UPROPERTY()
+    TObjectPtr<ASFT_FloatingTextActor> ProxyActor = nullptr;
+
+#if !UE_BUILD_SHIPPING
+    int32 StressTextsPerSecond = 0;
+    float StressTimeRemaining = 0.f;
+    float StressSpawnAccumulator = 0.f;
+    int32 StressStyleIndex = INDEX_NONE;
+#endif
+};
+
+inline const TArray<FSFT_FloatingTextEntry> &USFT_FloatingTextSubsystem::GetEntries() const
+{
+    return Entries;
+}
+
+inline const FSFT_FloatingTextStyle &USFT_FloatingTextSubsystem::GetStyle(int32 StyleIndex) const
+{
+    return Styles[StyleIndex];
+}
+
+inline FIntPoint USFT_FloatingTextSubsystem::GetViewportSize() const
+{
+    return ViewportSize;
+}
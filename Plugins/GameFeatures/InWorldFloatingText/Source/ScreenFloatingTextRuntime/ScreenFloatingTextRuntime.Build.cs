@@ -26,6 +26,7 @@ public class ScreenFloatingTextRuntime : ModuleRules
 			new string[]
 			{
 				"Core",
+				"SlateCore",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -36,6 +37,7 @@ public class ScreenFloatingTextRuntime : ModuleRules
 			{
                 "CoreUObject",
                 "Engine",
+                "Slate",
                 "UMG",
                 
                 "CommonUI",
@@ -1,3 +1,5 @@
 ﻿#pragma once
 
 DECLARE_LOG_CATEGORY_CLASS(LogScreenFloatingText, Warning, All);
+
+DECLARE_STATS_GROUP(TEXT("ScreenFloatingText"), STATGROUP_ScreenFloatingText, STATCAT_Advanced);
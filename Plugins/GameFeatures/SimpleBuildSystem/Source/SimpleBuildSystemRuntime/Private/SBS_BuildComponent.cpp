@@ -1,12 +1,20 @@
 #include "SBS_BuildComponent.h"
 
 #include "Camera/CameraComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/AssetManager.h"
 #include "EnhancedInputSubsystems.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
+#include "Materials/Material.h"
+#include "SBS_BuildableData.h"
 #include "SBS_BuildGhostActor.h"
 
-DECLARE_LOG_CATEGORY_CLASS(LogSimpleBuildSystem, All, All);
+DECLARE_CYCLE_STAT(TEXT("Move Ghost"), STAT_SbsMoveGhost, STATGROUP_SimpleBuildSystem);
+DECLARE_CYCLE_STAT(TEXT("Change Building Data"), STAT_SbsChangeBuildingData, STATGROUP_SimpleBuildSystem);
+DECLARE_CYCLE_STAT(TEXT("Spawn Building"), STAT_SbsSpawnBuilding, STATGROUP_SimpleBuildSystem);
+DECLARE_CYCLE_STAT(TEXT("Spawn Queue"), STAT_SbsSpawnQueue, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Placements"), STAT_SbsQueuedPlacements, STATGROUP_SimpleBuildSystem);
 
 bool FSBS_BuildingData::IsValid() const
 {
@@ -46,13 +54,43 @@ void USBS_BuildComponent::BeginPlay()
 
     OwnerController = Owner->GetLocalViewingPlayerController();
     check(IsValid(OwnerController));
+
+    BuildGrid = USBS_BuildGridSubsystem::Get(this);
+
+    LoadBuildableSet();
+}
+
+void USBS_BuildComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ClearPlacementQueue();
+
+    // Buildings that haven't been spawned yet are dropped, and their cells released
+    FinishSpawnQueue();
+
+    DestroyGhostBuildActor();
+
+    if (BuildableSetHandle.IsValid())
+    {
+        BuildableSetHandle->CancelHandle();
+        BuildableSetHandle.Reset();
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void USBS_BuildComponent::BuildStart_Implementation()
 {
     ensure(!bIsBuildModeActive);
 
+    SetupBuildGrid();
     CreateGhostBuildActor();
+
+    GhostActorYaw = Owner->GetActorRotation().Yaw;
+    BuildGhostActor->SetActorRotation(FRotator(0.f, GhostActorYaw, 0.f));
+    BuildGhostActor->SetGhostActive(true);
+    ApplyBuildingDataToGhost();
+
+    ShowBuiltVisionCoverage();
     SetComponentTickEnabled(true);
 
     SetBuildState(ESBS_BuildState::Moving);
@@ -60,9 +98,18 @@ void USBS_BuildComponent::BuildStart_Implementation()
 
 void USBS_BuildComponent::BuildAbort_Implementation()
 {
+    ClearPlacementQueue();
+
     if (IsValid(BuildGhostActor))
     {
-        BuildGhostActor->Destroy();
+        BuildGhostActor->SetGhostActive(false);
+    }
+
+    HideBuiltVisionCoverage();
+
+    if (IsValid(BuildGrid))
+    {
+        BuildGrid->RemoveIgnoredActor(Owner);
     }
 
     SetBuildState(ESBS_BuildState::Invalid);
@@ -77,24 +124,64 @@ void USBS_BuildComponent::MoveBuildGhostActor_Implementation()
 {
     ensure(BuildState == ESBS_BuildState::Moving);
 
+    SCOPE_CYCLE_COUNTER(STAT_SbsMoveGhost);
+
+    // Nothing the ghost depends on has changed, hence there is no need to trace again
+    const FTransform CameraTransform = OwnerCamera->GetComponentTransform();
+    if ((bGhostPlaced) && (GhostActorYaw == LastGhostActorYaw) &&
+        (CameraTransform.Equals(LastCameraTransform, KINDA_SMALL_NUMBER)))
+    {
+        return;
+    }
+
+    bGhostPlaced = true;
+    LastCameraTransform = CameraTransform;
+    LastGhostActorYaw = GhostActorYaw;
+
     FHitResult Hit;
     const FVector ObservedPoint = FindObservedPoint(MoveTraceLength, &Hit);
 
     // Fix some issues with ground placing by adding an offset
     const FVector GroundOffset = FVector::UpVector + Hit.ImpactNormal;
-    const FVector SurfaceLocation = ObservedPoint + GroundOffset;
-    
-    FHitResult GroundHitResult;
-    const FVector GroundLocation = FindGround(SurfaceLocation, &GroundHitResult);
+    FVector SurfaceLocation = ObservedPoint + GroundOffset;
+
+    FVector GroundLocation;
+    FVector GroundNormal;
+    if (IsValid(BuildGrid))
+    {
+        if (bSnapToGrid)
+        {
+            SurfaceLocation = BuildGrid->CellToLocation(BuildGrid->LocationToCell(SurfaceLocation), SurfaceLocation.Z);
+        }
+
+        // Ground is cached per cell, hence moving within a single cell doesn't trace anything
+        const FSBS_BuildGridCell &Cell = BuildGrid->FindOrSampleCell(SurfaceLocation);
+        GroundLocation = FVector(SurfaceLocation.X, SurfaceLocation.Y, Cell.GroundZ);
+        GroundNormal = Cell.Normal;
+    }
+    else
+    {
+        FHitResult GroundHitResult;
+        GroundLocation = FindGround(SurfaceLocation, &GroundHitResult);
+        GroundNormal = GroundHitResult.ImpactNormal;
+    }
 
     const FQuat DefaultRot = FRotator(0.f, GhostActorYaw, 0.f).Quaternion();
-    const FRotator ImpactRot = GroundHitResult.ImpactNormal.ToOrientationRotator();
+    const FRotator ImpactRot = GroundNormal.ToOrientationRotator();
     const FRotator RotAlongSurface = ImpactRot + FRotator(-90.f, 0.f, 0.f);
     const FQuat SurfaceRot = RotAlongSurface.Quaternion();
     const FRotator FinalRot = FQuat(SurfaceRot * DefaultRot).Rotator();
 
-    BuildGhostActor->SetActorLocation(GroundLocation);
-    BuildGhostActor->SetActorRotation(FinalRot);
+    BuildGhostActor->SetActorLocationAndRotation(GroundLocation, FinalRot);
+
+    if (IsValid(BuildGrid))
+    {
+        // Path check is the most expensive one, hence do it only if the area itself is fine
+        const FBox Footprint = BuildGhostActor->GetFootprintBounds();
+        bGridAllowsPlacement = ((BuildGrid->IsAreaBuildable(Footprint, GroundLocation.Z)) &&
+            (!BuildGrid->WouldBlockPaths(Footprint)));
+        RefreshPlacementValidity();
+    }
 }
 
 void USBS_BuildComponent::RotateBuildGhostActor_Implementation()
@@ -188,8 +275,75 @@ void USBS_BuildComponent::BindBuildDelegates()
     BuildGhostActor->OnBuildForbidDelegate.AddUObject(this, &ThisClass::OnBuildForbid);
 }
 
+void USBS_BuildComponent::LoadBuildableSet()
+{
+    TArray<FSoftObjectPath> Paths;
+    for (const USBS_BuildableData *Buildable : BuildableSet)
+    {
+        if (IsValid(Buildable))
+        {
+            Buildable->GetAssetPaths(Paths);
+        }
+    }
+
+    if (Paths.IsEmpty())
+    {
+        OnBuildableSetLoaded();
+        return;
+    }
+
+    BuildableSetLoadStartSeconds = FPlatformTime::Seconds();
+    BuildableSetHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths),
+        FStreamableDelegate::CreateUObject(this, &ThisClass::OnBuildableSetLoaded),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    // No handle means there was nothing to load
+    if (!BuildableSetHandle.IsValid())
+    {
+        OnBuildableSetLoaded();
+    }
+}
+
+void USBS_BuildComponent::OnBuildableSetLoaded()
+{
+    if (bBuildableSetLoaded)
+    {
+        return;
+    }
+
+    bBuildableSetLoaded = true;
+
+    if (BuildableSetHandle.IsValid())
+    {
+        UE_LOG(LogSimpleBuildSystem, Display, TEXT("Buildable set has been loaded in %.3f seconds."),
+            FPlatformTime::Seconds() - BuildableSetLoadStartSeconds);
+    }
+
+    OnBuildableSetLoadedDelegate.Broadcast();
+}
+
+bool USBS_BuildComponent::IsBuildableSetLoaded() const
+{
+    return bBuildableSetLoaded;
+}
+
+float USBS_BuildComponent::GetBuildableSetLoadProgress() const
+{
+    if (bBuildableSetLoaded)
+    {
+        return 1.f;
+    }
+
+    return (BuildableSetHandle.IsValid()) ? (BuildableSetHandle->GetProgress()) : (0.f);
+}
+
 void USBS_BuildComponent::CreateGhostBuildActor()
 {
+    if (IsValid(BuildGhostActor))
+    {
+        return;
+    }
+
     FActorSpawnParameters SpawnParameters;
     SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
@@ -201,55 +355,223 @@ void USBS_BuildComponent::CreateGhostBuildActor()
     // Bind as soon as possible
     BindBuildDelegates();
 
-    GhostActorYaw = Owner->GetActorRotation().Yaw;
+    if (IsValid(BuildGrid))
+    {
+        BuildGrid->AddIgnoredActor(BuildGhostActor);
+    }
+
+    BuildGhostActor->SetVisionMaterial(GetVisionConeMaterial());
+    BuildGhostActor->SetGhostActive(false);
+}
+
+void USBS_BuildComponent::ApplyBuildingDataToGhost()
+{
+    check(BuildGhostActor);
+
+    bGridAllowsPlacement = true;
+    bGhostPlaced = false;
 
-    BuildGhostActor->SetActorRotation(FRotator(0.f, GhostActorYaw, 0.f));
-    BuildGhostActor->SetStaticMesh(ActiveBuildingData.StaticMesh);
-    BuildGhostActor->SetDrawVision(ActiveBuildingData.bDrawVision);
     BuildGhostActor->SetVision(ActiveBuildingData.VisionRange, ActiveBuildingData.VisionDegrees);
+    BuildGhostActor->SetDrawVision(ActiveBuildingData.bDrawVision);
+
+    // Broadcasts the overlap state of the new mesh, which applies the right material
+    BuildGhostActor->SetStaticMesh(ActiveBuildingData.StaticMesh);
 }
 
-AActor *USBS_BuildComponent::SpawnBuilding() const
+void USBS_BuildComponent::DestroyGhostBuildActor()
 {
+    if (!IsValid(BuildGhostActor))
+    {
+        return;
+    }
+
+    if (IsValid(BuildGrid))
+    {
+        BuildGrid->RemoveIgnoredActor(BuildGhostActor);
+    }
+
+    BuildGhostActor->Destroy();
+    BuildGhostActor = nullptr;
+}
+
+FSBS_Placement USBS_BuildComponent::CapturePlacement() const
+{
+    check(BuildGhostActor);
+
     const FVector Offset(0.f, 0.f, BuildGhostActor->GetOffsetZ());
-    
-    FTransform Transform = BuildGhostActor->GetTransform();
-    Transform.AddToTranslation(Offset);
+
+    FSBS_Placement Placement;
+    Placement.SpawnTransform = BuildGhostActor->GetTransform();
+    Placement.SpawnTransform.AddToTranslation(Offset);
+    Placement.MeshTransform = BuildGhostActor->GetMeshTransform();
+    Placement.VisionTransform = BuildGhostActor->GetVisionTransform();
+    Placement.Footprint = BuildGhostActor->GetFootprintBounds();
+    Placement.VisionHeight = BuildGhostActor->GetVisionHeight();
+
+    return Placement;
+}
+
+AActor *USBS_BuildComponent::FinishPlacement(const FSBS_BuildingData &Data, const FSBS_Placement &Placement)
+{
+    AActor *Actor = SpawnBuilding(Data, Placement.SpawnTransform);
+
+    // Let the next placements know the cells are taken without sampling them again
+    if (IsValid(BuildGrid))
+    {
+        BuildGrid->AddOccupant(Actor, Placement.Footprint);
+    }
+
+    AddBuiltVisionCone(Actor, Data, Placement);
+
+    OnBuildFinishedDelegate.Broadcast(Actor);
+    return Actor;
+}
+
+AActor *USBS_BuildComponent::SpawnBuilding(const FSBS_BuildingData &Data, const FTransform &Transform) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SbsSpawnBuilding);
 
     const auto HdlMethod = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-    AActor *Actor = GetWorld()->SpawnActorDeferred<AActor>(
-        ActiveBuildingData.ObjectClass, Transform, Owner, Owner, HdlMethod);
+    AActor *Actor = GetWorld()->SpawnActorDeferred<AActor>(Data.ObjectClass, Transform, Owner, Owner, HdlMethod);
 
     if (bTryCreateDefaultControllersOnSpawn)
     {
-        if (ActiveBuildingData.ObjectClass->IsChildOf(APawn::StaticClass()))
+        if (Data.ObjectClass->IsChildOf(APawn::StaticClass()))
         {
             auto Pawn = Cast<APawn>(Actor);
             Pawn->SpawnDefaultController();
         }
     }
 
+    // Gather navmesh rebuilds caused by placed objects into batches
+    if (IsValid(BuildGrid))
+    {
+        BuildGrid->DeferNavigationUpdate(Actor);
+    }
+
     UGameplayStatics::FinishSpawningActor(Actor, Transform);
 
     return Actor;
 }
 
-void USBS_BuildComponent::OnBuildAllowed()
+void USBS_BuildComponent::SetupBuildGrid()
 {
-    check(BuildGhostActor);
+    if (!IsValid(BuildGrid))
+    {
+        return;
+    }
+
+    FSBS_BuildGridSettings Settings = GridSettings;
+    if (Settings.GroundObjectTypes.IsEmpty())
+    {
+        Settings.GroundObjectTypes = ObjectTypesToQueryOnTraces;
+    }
+
+    BuildGrid->Configure(Settings);
+    BuildGrid->AddIgnoredActor(Owner);
+
+    if (GridPrewarmRadius > 0.f)
+    {
+        BuildGrid->PrewarmArea(Owner->GetActorLocation(), GridPrewarmRadius);
+    }
+}
+
+void USBS_BuildComponent::AddBuiltVisionCone(
+    AActor *Actor,
+    const FSBS_BuildingData &Data,
+    const FSBS_Placement &Placement)
+{
+    if ((!bShowBuiltVisionCoverage) || (!IsValid(Actor)) || (!Data.bDrawVision))
+    {
+        return;
+    }
+
+    FSBS_VisionCone Cone;
+    Cone.Transform = Placement.VisionTransform;
+    Cone.Range = Data.VisionRange;
+    Cone.Degrees = Data.VisionDegrees;
+    Cone.Height = Placement.VisionHeight;
+
+    BuiltVisionCones.Add(Actor, Cone);
+    bBuiltVisionCoverageDirty = true;
+}
+
+UMaterialInterface *USBS_BuildComponent::GetVisionConeMaterial() const
+{
+    return (IsValid(VisionConeMaterial)) ? (VisionConeMaterial.Get()) : (UMaterial::GetDefaultMaterial(MD_Surface));
+}
+
+void USBS_BuildComponent::ShowBuiltVisionCoverage()
+{
+    if (!bShowBuiltVisionCoverage)
+    {
+        return;
+    }
+
+    if (!IsValid(BuiltVisionCoverage))
+    {
+        BuiltVisionCoverage = NewObject<USBS_VisionConeComponent>(Owner, TEXT("Built Vision Coverage"));
+        BuiltVisionCoverage->SetupAttachment(Owner->GetRootComponent());
+        BuiltVisionCoverage->RegisterComponent();
+        BuiltVisionCoverage->SetMaterial(0, GetVisionConeMaterial());
+    }
+
+    // Forget objects that have been destroyed since
+    for (auto It = BuiltVisionCones.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+            bBuiltVisionCoverageDirty = true;
+        }
+    }
+
+    if (bBuiltVisionCoverageDirty)
+    {
+        TArray<FSBS_VisionCone> Cones;
+        BuiltVisionCones.GenerateValueArray(Cones);
+
+        BuiltVisionCoverage->SetCones(Cones);
+        bBuiltVisionCoverageDirty = false;
+    }
+
+    BuiltVisionCoverage->SetVisibility(true);
+}
 
-    bCanPlaceBuilding = true;
-    BuildGhostActor->SetMaterial(ActiveBuildingData.AllowMaterial);
+void USBS_BuildComponent::HideBuiltVisionCoverage()
+{
+    if (IsValid(BuiltVisionCoverage))
+    {
+        BuiltVisionCoverage->SetVisibility(false);
+    }
+}
+
+void USBS_BuildComponent::OnBuildAllowed()
+{
+    bGhostOverlapping = false;
+    RefreshPlacementValidity(true);
 }
 
 void USBS_BuildComponent::OnBuildForbid()
+{
+    bGhostOverlapping = true;
+    RefreshPlacementValidity(true);
+}
+
+void USBS_BuildComponent::RefreshPlacementValidity(bool bForceMaterial)
 {
     check(BuildGhostActor);
-    ensure(bCanPlaceBuilding);
 
-    bCanPlaceBuilding = false;
-    BuildGhostActor->SetMaterial(ActiveBuildingData.ForbidMaterial);
+    const bool bNewCanPlaceBuilding = ((!bGhostOverlapping) && (bGridAllowsPlacement));
+    if ((bNewCanPlaceBuilding == bCanPlaceBuilding) && (!bForceMaterial))
+    {
+        return;
+    }
+
+    bCanPlaceBuilding = bNewCanPlaceBuilding;
+    BuildGhostActor->SetMaterial((bCanPlaceBuilding) ?
+        (ActiveBuildingData.AllowMaterial.Get()) : (ActiveBuildingData.ForbidMaterial.Get()));
 }
 
 void USBS_BuildComponent::AddInputContext(const UInputMappingContext *InputMappingContext)
@@ -345,6 +667,13 @@ bool USBS_BuildComponent::BuildModeEnable(FSBS_BuildingData Data)
         return false;
     }
 
+    // Placing a building whose assets are still streaming would load them synchronously
+    if (!IsBuildableSetLoaded())
+    {
+        UE_LOG(LogSimpleBuildSystem, Warning, TEXT("Buildable set is still loading."));
+        return false;
+    }
+
     ActiveBuildingData = Data;
 
     BuildStart();
@@ -374,25 +703,95 @@ void USBS_BuildComponent::ChangeBuildingData(FSBS_BuildingData Data)
     ensure(BuildProgressRatio == 0.f);
     check(BuildGhostActor);
 
+    SCOPE_CYCLE_COUNTER(STAT_SbsChangeBuildingData);
+
+    // A batch is made of a single building type
+    ClearPlacementQueue();
+
     ActiveBuildingData = Data;
     if (BuildState != ESBS_BuildState::Moving)
     {
         SetBuildState(ESBS_BuildState::Moving);
     }
 
-    // New building may have new mesh and different height, hence re-create it
-    BuildGhostActor->Destroy();
-    bCanPlaceBuilding = true;
-    CreateGhostBuildActor();
+    // Reuse the ghost, only its mesh, height offset and vision change
+    ApplyBuildingDataToGhost();
 
     OnBuildingDataChangedDelegate.Broadcast();
 }
 
+void USBS_BuildComponent::PreloadBuildingData(const TArray<FSBS_BuildingData> &Data)
+{
+    PreloadedBuildingData.Reset(Data.Num());
+    for (const FSBS_BuildingData &Item : Data)
+    {
+        if (Item.IsValid())
+        {
+            PreloadedBuildingData.Add(Item);
+        }
+    }
+
+    if (IsValid(Owner))
+    {
+        CreateGhostBuildActor();
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+void USBS_BuildComponent::RunSwitchBuildingsBenchmark(int32 Count)
+{
+    if ((!bIsBuildModeActive) || (PreloadedBuildingData.IsEmpty()))
+    {
+        UE_LOG(LogSimpleBuildSystem, Warning, TEXT("Build mode must be active, and building data preloaded."));
+        return;
+    }
+
+    double WorstSeconds = 0.0;
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < Count; i++)
+    {
+        const double SwitchStartSeconds = FPlatformTime::Seconds();
+        ChangeBuildingData(PreloadedBuildingData[i % PreloadedBuildingData.Num()]);
+        WorstSeconds = FMath::Max(WorstSeconds, FPlatformTime::Seconds() - SwitchStartSeconds);
+    }
+
+    const double TotalSeconds = FPlatformTime::Seconds() - StartSeconds;
+    UE_LOG(LogSimpleBuildSystem, Display, TEXT("%d switches: %.3f ms total, %.3f ms average, %.3f ms worst."),
+        Count, TotalSeconds * 1000.0, TotalSeconds * 1000.0 / FMath::Max(Count, 1), WorstSeconds * 1000.0);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SwitchBuildingsBenchmarkCommand(
+    TEXT("SBS.SwitchBuildingsBenchmark"),
+    TEXT("Switch between the preloaded buildings of the first player. Usage: SBS.SwitchBuildingsBenchmark [Count=100]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        const APlayerController *PlayerController = (IsValid(World)) ? (World->GetFirstPlayerController()) : (nullptr);
+        const APawn *Pawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+        USBS_BuildComponent *BuildComponent =
+            (IsValid(Pawn)) ? (Pawn->FindComponentByClass<USBS_BuildComponent>()) : (nullptr);
+
+        if (!IsValid(BuildComponent))
+        {
+            UE_LOG(LogSimpleBuildSystem, Warning, TEXT("First player has no build component."));
+            return;
+        }
+
+        const int32 Count = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (100);
+        BuildComponent->RunSwitchBuildingsBenchmark(Count);
+    }));
+#endif
+
 void USBS_BuildComponent::BuildModeDisable()
 {
     if (!bIsBuildModeActive)
     {
-        return SetComponentTickEnabled(false);
+        // Keep ticking until the confirmed placements have been spawned
+        if (SpawnQueue.IsEmpty())
+        {
+            SetComponentTickEnabled(false);
+        }
+        return;
     }
     RemoveInputContext(BuildModeMappingContext.Get());
 
@@ -431,9 +830,238 @@ void USBS_BuildComponent::BuildConfirm_Implementation()
 
 void USBS_BuildComponent::BuildFinish_Implementation()
 {
-    AActor *Actor = SpawnBuilding();
+    FinishPlacement(ActiveBuildingData, CapturePlacement());
+}
 
-    OnBuildFinishedDelegate.Broadcast(Actor);
+bool USBS_BuildComponent::QueuePlacement()
+{
+    if ((!bIsBuildModeActive) || (BuildState != ESBS_BuildState::Moving) || (!bCanPlaceBuilding))
+    {
+        return false;
+    }
+
+    AddQueuedPlacement(CapturePlacement());
+    return true;
+}
+
+int32 USBS_BuildComponent::QueuePlacementLine()
+{
+    if ((!bIsBuildModeActive) || (BuildState != ESBS_BuildState::Moving))
+    {
+        return 0;
+    }
+
+    if ((PlacementQueue.IsEmpty()) || (!IsValid(BuildGrid)))
+    {
+        return (QueuePlacement()) ? (1) : (0);
+    }
+
+    const FSBS_Placement GhostPlacement = CapturePlacement();
+    const FVector GhostLocation = BuildGhostActor->GetActorLocation();
+    const FVector Extent = GhostPlacement.Footprint.GetExtent();
+    const float Step = FMath::Max(Extent.X, Extent.Y) * 2.f;
+    if (Step <= KINDA_SMALL_NUMBER)
+    {
+        return 0;
+    }
+
+    // Queued placements are spawn transforms, hence go back to the ghost location the offset has been applied to
+    const float OffsetZ = BuildGhostActor->GetOffsetZ();
+    const FVector LineStart = PlacementQueue.Last().SpawnTransform.GetLocation() - FVector(0.f, 0.f, OffsetZ);
+    const FVector Line = FVector(GhostLocation.X - LineStart.X, GhostLocation.Y - LineStart.Y, 0.f);
+    const FVector Direction = Line.GetSafeNormal();
+    const int32 Steps = FMath::FloorToInt(Line.Size() / Step);
+
+    int32 Queued = 0;
+    for (int32 i = 1; i <= Steps; i++)
+    {
+        FVector Location = LineStart + Direction * Step * i;
+        Location.Z = BuildGrid->FindOrSampleCell(Location).GroundZ;
+
+        // Same shape as the ghost, only moved
+        const FVector Delta = Location - GhostLocation;
+
+        FSBS_Placement Placement = GhostPlacement;
+        Placement.SpawnTransform.AddToTranslation(Delta);
+        Placement.MeshTransform.AddToTranslation(Delta);
+        Placement.VisionTransform.AddToTranslation(Delta);
+        Placement.Footprint = Placement.Footprint.ShiftBy(Delta);
+
+        if ((!BuildGrid->IsAreaBuildable(Placement.Footprint, Location.Z)) ||
+            (BuildGrid->WouldBlockPaths(Placement.Footprint)))
+        {
+            continue;
+        }
+
+        AddQueuedPlacement(MoveTemp(Placement));
+        Queued++;
+    }
+
+    return Queued;
+}
+
+void USBS_BuildComponent::AddQueuedPlacement(FSBS_Placement &&Placement)
+{
+    if (IsValid(BuildGrid))
+    {
+        Placement.ReservationHandle = BuildGrid->ReserveArea(Placement.Footprint);
+    }
+
+    if (!IsValid(QueuedPlacementPreview))
+    {
+        QueuedPlacementPreview = NewObject<UInstancedStaticMeshComponent>(Owner, TEXT("Queued Placement Preview"));
+        QueuedPlacementPreview->SetupAttachment(Owner->GetRootComponent());
+        QueuedPlacementPreview->SetUsingAbsoluteLocation(true);
+        QueuedPlacementPreview->SetUsingAbsoluteRotation(true);
+        QueuedPlacementPreview->SetUsingAbsoluteScale(true);
+        QueuedPlacementPreview->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        QueuedPlacementPreview->SetCanEverAffectNavigation(false);
+        QueuedPlacementPreview->RegisterComponent();
+    }
+
+    if (QueuedPlacementPreview->GetStaticMesh() != ActiveBuildingData.StaticMesh)
+    {
+        QueuedPlacementPreview->ClearInstances();
+        QueuedPlacementPreview->SetStaticMesh(ActiveBuildingData.StaticMesh);
+        QueuedPlacementPreview->SetMaterial(0, ActiveBuildingData.AllowMaterial);
+    }
+
+    QueuedPlacementPreview->AddInstance(Placement.MeshTransform, true);
+    PlacementQueue.Add(MoveTemp(Placement));
+
+    INC_DWORD_STAT(STAT_SbsQueuedPlacements);
+
+    // Reserved cells aren't buildable anymore, hence validate the ghost again
+    bGhostPlaced = false;
+}
+
+void USBS_BuildComponent::ClearPlacementQueue()
+{
+    if (IsValid(BuildGrid))
+    {
+        for (const FSBS_Placement &Placement : PlacementQueue)
+        {
+            BuildGrid->ReleaseReservedArea(Placement.ReservationHandle);
+        }
+    }
+
+    DEC_DWORD_STAT_BY(STAT_SbsQueuedPlacements, PlacementQueue.Num());
+    PlacementQueue.Reset();
+
+    if (IsValid(QueuedPlacementPreview))
+    {
+        QueuedPlacementPreview->ClearInstances();
+    }
+
+    bGhostPlaced = false;
+}
+
+void USBS_BuildComponent::ConfirmPlacementQueue()
+{
+    if (PlacementQueue.IsEmpty())
+    {
+        return;
+    }
+
+    if (SpawnQueue.IsEmpty())
+    {
+        // Released on FinishSpawnQueue, so that the navmesh is rebuilt once for the whole queue
+        if (IsValid(BuildGrid))
+        {
+            BuildGrid->LockNavigationUpdates();
+        }
+    }
+    else if (SpawnQueueHead > 0)
+    {
+        // Drop the spawned placements so that the queue doesn't keep growing while batches are chained
+        SpawnQueue.RemoveAt(0, SpawnQueueHead, false);
+        SpawnQueueHead = 0;
+    }
+
+    // Append the batch to whatever is still being spawned, so confirming never spawns synchronously
+    const int32 BuildingDataIndex = SpawnQueueBuildingData.Add(ActiveBuildingData);
+    for (FSBS_Placement &Placement : PlacementQueue)
+    {
+        Placement.BuildingDataIndex = BuildingDataIndex;
+    }
+
+    SpawnQueue.Append(MoveTemp(PlacementQueue));
+    PlacementQueue.Reset();
+
+    // Reservations are kept until the buildings are spawned
+    if (IsValid(QueuedPlacementPreview))
+    {
+        QueuedPlacementPreview->ClearInstances();
+    }
+
+    SetComponentTickEnabled(true);
+    BuildStop();
+}
+
+void USBS_BuildComponent::TickSpawnQueue()
+{
+    SCOPE_CYCLE_COUNTER(STAT_SbsSpawnQueue);
+
+    const double EndSeconds = FPlatformTime::Seconds() + SpawnFrameBudgetMs / 1000.0;
+
+    // Spawn at least one building per frame so that the queue always drains
+    int32 Spawned = 0;
+    do
+    {
+        SpawnQueuedBuilding();
+        Spawned++;
+    }
+    while ((SpawnQueueHead < SpawnQueue.Num()) && (Spawned < MaxSpawnsPerFrame) &&
+        (FPlatformTime::Seconds() < EndSeconds));
+
+    if (SpawnQueueHead >= SpawnQueue.Num())
+    {
+        FinishSpawnQueue();
+    }
+}
+
+void USBS_BuildComponent::SpawnQueuedBuilding()
+{
+    check(SpawnQueue.IsValidIndex(SpawnQueueHead));
+
+    const FSBS_Placement &Placement = SpawnQueue[SpawnQueueHead++];
+    if (IsValid(BuildGrid))
+    {
+        BuildGrid->ReleaseReservedArea(Placement.ReservationHandle);
+    }
+
+    DEC_DWORD_STAT(STAT_SbsQueuedPlacements);
+
+    check(SpawnQueueBuildingData.IsValidIndex(Placement.BuildingDataIndex));
+    FinishPlacement(SpawnQueueBuildingData[Placement.BuildingDataIndex], Placement);
+}
+
+void USBS_BuildComponent::FinishSpawnQueue()
+{
+    if (SpawnQueue.IsEmpty())
+    {
+        return;
+    }
+
+    // Release cells of the buildings that haven't been spawned, if any
+    if (IsValid(BuildGrid))
+    {
+        for (int32 i = SpawnQueueHead; i < SpawnQueue.Num(); i++)
+        {
+            BuildGrid->ReleaseReservedArea(SpawnQueue[i].ReservationHandle);
+        }
+
+        BuildGrid->UnlockNavigationUpdates();
+    }
+
+    SpawnQueue.Reset();
+    SpawnQueueHead = 0;
+    SpawnQueueBuildingData.Reset();
+
+    if (!bIsBuildModeActive)
+    {
+        SetComponentTickEnabled(false);
+    }
 }
 
 void USBS_BuildComponent::TickComponent(
@@ -443,6 +1071,11 @@ void USBS_BuildComponent::TickComponent(
 {
     Super::TickComponent(DeltaSeconds, TickType, ThisTickFunction);
 
+    if (!SpawnQueue.IsEmpty())
+    {
+        TickSpawnQueue();
+    }
+
     switch (BuildState)
     {
     case ESBS_BuildState::Moving:
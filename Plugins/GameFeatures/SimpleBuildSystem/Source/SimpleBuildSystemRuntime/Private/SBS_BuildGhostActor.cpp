@@ -1,11 +1,11 @@
 ﻿#include "SBS_BuildGhostActor.h"
 
-#include "CollisionDebugDrawingPublic.h"
 #include "Components/ArrowComponent.h"
+#include "SBS_VisionConeComponent.h"
 
 ASBS_BuildGhostActor::ASBS_BuildGhostActor()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bCanEverTick = false;
     PrimaryActorTick.bStartWithTickEnabled = false;
 
     SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("Scene Root"));
@@ -19,12 +19,10 @@ ASBS_BuildGhostActor::ASBS_BuildGhostActor()
 
     StaticMesh->SetCollisionProfileName("OverlapAll");
     StaticMesh->SetGenerateOverlapEvents(true);
-}
 
-void ASBS_BuildGhostActor::Tick(float DeltaSeconds)
-{
-    Super::Tick(DeltaSeconds);
-    DrawVision();
+    VisionCone = CreateDefaultSubobject<USBS_VisionConeComponent>(TEXT("Vision Cone"));
+    VisionCone->SetupAttachment(StaticMesh);
+    VisionCone->SetVisibility(false);
 }
 
 void ASBS_BuildGhostActor::SetStaticMesh(UStaticMesh *Mesh)
@@ -34,19 +32,19 @@ void ASBS_BuildGhostActor::SetStaticMesh(UStaticMesh *Mesh)
         return;
     }
 
-    // Fix floating point error, otherwise the object will likely overlap with the ground it's standing on
-    StaticMesh->AddLocalOffset(FVector(0.f, 0.f, BaseOffsetZ));
+    // Fix floating point error, otherwise the object will likely overlap with the ground it's standing on. Set rather
+    // than add the offset, since the mesh is swapped on the same ghost many times
+    StaticMesh->SetRelativeLocation(FVector(0.f, 0.f, BaseOffsetZ));
 
-    const UStaticMesh *OldMesh = StaticMesh->GetStaticMesh();
-    StaticMesh->SetStaticMesh(Mesh);
-
-    // After a mesh has been set up it may call begin/end overlap events depending if there was a mesh and if the new
-    // one is overlapping with something. In case of absence of any mesh previous mesh and no overlapping actor at the
-    // frame the mesh has been set, broadcast the possibility to build
-    if ((!OldMesh) && (OverlappingActors.IsEmpty()))
+    if (StaticMesh->GetStaticMesh() != Mesh)
     {
-        OnBuildAllowedDelegate.Broadcast();
+        StaticMesh->SetStaticMesh(Mesh);
+
+        // Cone height follows the mesh one
+        UpdateVisionCone();
     }
+
+    RefreshOverlaps();
 }
 
 void ASBS_BuildGhostActor::SetMaterial(UMaterialInterface *MaterialInterface)
@@ -59,6 +57,82 @@ void ASBS_BuildGhostActor::SetMaterial(UMaterialInterface *MaterialInterface)
     StaticMesh->SetMaterial(0, MaterialInterface);
 }
 
+void ASBS_BuildGhostActor::SetGhostActive(bool bActive)
+{
+    SetActorHiddenInGame(!bActive);
+    SetActorEnableCollision(bActive);
+
+    if (bActive)
+    {
+        RefreshOverlaps();
+    }
+    else
+    {
+        OverlappingActors.Reset();
+    }
+}
+
+void ASBS_BuildGhostActor::RefreshOverlaps()
+{
+    if (!GetActorEnableCollision())
+    {
+        return;
+    }
+
+    TGuardValue<bool> RefreshingGuard(bRefreshingOverlaps, true);
+
+    StaticMesh->UpdateOverlaps();
+
+    TArray<AActor*> Actors;
+    StaticMesh->GetOverlappingActors(Actors);
+
+    OverlappingActors.Reset();
+    OverlappingActors.Append(Actors);
+
+    if (OverlappingActors.IsEmpty())
+    {
+        OnBuildAllowedDelegate.Broadcast();
+    }
+    else
+    {
+        OnBuildForbidDelegate.Broadcast();
+    }
+}
+
+void ASBS_BuildGhostActor::SetDrawVision(bool Flag)
+{
+    bDrawVision = Flag;
+    VisionCone->SetVisibility(bDrawVision);
+    UpdateVisionCone();
+}
+
+void ASBS_BuildGhostActor::SetVision(float Range, float Degrees)
+{
+    VisionRange = Range;
+    VisionDegrees = Degrees;
+    UpdateVisionCone();
+}
+
+void ASBS_BuildGhostActor::SetVisionMaterial(UMaterialInterface *MaterialInterface)
+{
+    if (!IsValid(MaterialInterface))
+    {
+        return;
+    }
+
+    VisionCone->SetMaterial(0, MaterialInterface);
+}
+
+FTransform ASBS_BuildGhostActor::GetVisionTransform() const
+{
+    return VisionCone->GetComponentTransform();
+}
+
+FTransform ASBS_BuildGhostActor::GetMeshTransform() const
+{
+    return StaticMesh->GetComponentTransform();
+}
+
 float ASBS_BuildGhostActor::GetOffsetZ() const
 {
     if (!IsValid(StaticMesh))
@@ -72,6 +146,11 @@ float ASBS_BuildGhostActor::GetOffsetZ() const
     return HalfHeight + BaseOffsetZ;
 }
 
+FBox ASBS_BuildGhostActor::GetFootprintBounds() const
+{
+    return StaticMesh->Bounds.GetBox();
+}
+
 void ASBS_BuildGhostActor::BeginPlay()
 {
     Super::BeginPlay();
@@ -88,9 +167,9 @@ void ASBS_BuildGhostActor::OnMeshBeginOverlap(
     bool bFromSweep,
     const FHitResult &SweepResult)
 {
-    OverlappingActors.Add(OtherActor);
+    OverlappingActors.AddUnique(OtherActor);
 
-    if (OverlappingActors.Num() == 1)
+    if ((!bRefreshingOverlaps) && (OverlappingActors.Num() == 1))
     {
         OnBuildForbidDelegate.Broadcast();
     }
@@ -104,89 +183,20 @@ void ASBS_BuildGhostActor::OnMeshEndOverlap(
 {
     OverlappingActors.Remove(OtherActor);
 
-    if (OverlappingActors.IsEmpty())
+    if ((!bRefreshingOverlaps) && (OverlappingActors.IsEmpty()))
     {
         OnBuildAllowedDelegate.Broadcast();
     }
 }
 
-#define DRAW_LINE(P1, P2) DrawDebugLine(World, P1, P2, Color, bPersistentLines, LifeTime, DepthPriority, Thickness)
-#define COMPUTE_DIRECTION(RAD) FVector(FMath::Cos(RAD), FMath::Sin(RAD), 0.f)
-#define COMPUTE_VERTEX(RAD, OFFSET_VECTOR) \
-    Transform.TransformPosition((COMPUTE_DIRECTION(CurrentAngle) * VisionRange) + OFFSET_VECTOR)
-#define DRAW_ARC(OFFSET_VECTOR) \
-    do { \
-        CurrentAngle = MinAngle; \
-        FVector LastVertex = COMPUTE_VERTEX(CurrentAngle, OFFSET_VECTOR); \
-        CurrentAngle += AngleStep; \
-        for (int32 i = 0; i < Sections; i++) \
-        { \
-            const FVector ThisVertex = COMPUTE_VERTEX(CurrentAngle, OFFSET_VECTOR); \
-            DRAW_LINE(LastVertex, ThisVertex); \
-            LastVertex = ThisVertex; \
-            CurrentAngle += AngleStep; \
-        } \
-    } while(0)
-
-void ASBS_BuildGhostActor::DrawVision()
-{
-    UWorld *World = GetWorld();
-
-    const FTransform Transform = StaticMesh->GetComponentTransform();
-    const float VisionHeight = GetMeshHeight();
-    const FVector HeightVector = FVector::UpVector * VisionHeight;
-    const FVector RotatedHeightVector = Transform.GetUnitAxis(EAxis::Z) * VisionHeight;
-
-    const FVector BottomRootPosition = Transform.GetLocation();
-    const FVector TopRootPosition = BottomRootPosition + RotatedHeightVector;
-
-    const float HalfVisionRad = FMath::DegreesToRadians(VisionDegrees / 2.f);
-    const float X = FMath::Cos(HalfVisionRad);
-    const float Y = FMath::Sin(HalfVisionRad);
-    
-    const FVector LeftSide = FVector(X, -Y, 0.f) * VisionRange;
-    const FVector RightSide = FVector(X, Y, 0.f) * VisionRange;
-    
-    const FVector BottomFront = Transform.TransformPosition(FVector::ForwardVector * VisionRange);
-    const FVector TopFront = BottomFront + RotatedHeightVector;
-
-    const FVector TopLeft = Transform.TransformPosition(HeightVector + LeftSide);
-    const FVector TopRight = Transform.TransformPosition(HeightVector + RightSide);
-
-    const FVector BottomLeft = Transform.TransformPosition(LeftSide);
-    const FVector BottomRight = Transform.TransformPosition(RightSide);
-
-    const FColor Color = FColor::Cyan;
-    const bool bPersistentLines = false;
-    const float LifeTime = -1.f;
-    const uint8 DepthPriority = 0;
-    const float Thickness = 2.5f;
-
-    const int32 Sections = 24;
-    const float MinAngle = -HalfVisionRad;
-    const float MaxAngle = +HalfVisionRad;
-    float AngleStep = (MaxAngle - MinAngle) / static_cast<float>(Sections);
-    float CurrentAngle = MinAngle;
-
-    // Middle
-    DRAW_LINE(BottomRootPosition, TopRootPosition);
-
-    // Left side
-    DRAW_LINE(BottomRootPosition, BottomLeft);
-    DRAW_LINE(TopRootPosition, TopLeft);
-    DRAW_LINE(BottomLeft, TopLeft);
-
-    // Right side
-    DRAW_LINE(BottomRootPosition, BottomRight);
-    DRAW_LINE(TopRootPosition, TopRight);
-    DRAW_LINE(BottomRight, TopRight);
-
-    // Front side
-    DRAW_ARC(FVector::ZeroVector);
-    DRAW_ARC(HeightVector);
-    DRAW_LINE(BottomRootPosition, BottomFront);
-    DRAW_LINE(TopRootPosition, TopFront);
-    DRAW_LINE(BottomFront, TopFront);
+void ASBS_BuildGhostActor::UpdateVisionCone()
+{
+    if ((!bDrawVision) || (!StaticMesh->GetStaticMesh()))
+    {
+        return;
+    }
+
+    VisionCone->SetCone(VisionRange, VisionDegrees, GetMeshHeight());
 }
 
 float ASBS_BuildGhostActor::GetMeshHeight() const
@@ -194,8 +204,3 @@ float ASBS_BuildGhostActor::GetMeshHeight() const
     const FBox Box = StaticMesh->GetStaticMesh()->GetBoundingBox();
     return Box.Max.Z;
 }
-
-#undef DRAW_ARC
-#undef COMPUTE_VERTEX
-#undef COMPUTE_DIRECTION
-#undef DRAW_LINE
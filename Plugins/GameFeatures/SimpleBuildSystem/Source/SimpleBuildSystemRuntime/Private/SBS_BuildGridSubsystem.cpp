@@ -0,0 +1,795 @@
+#include "SBS_BuildGridSubsystem.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Grid Prewarm"), STAT_SbsGridPrewarm, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grid Cells Sampled"), STAT_SbsGridCellsSampled, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grid Cache Hits"), STAT_SbsGridCacheHits, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Grid Cached Cells"), STAT_SbsGridCachedCells, STATGROUP_SimpleBuildSystem);
+DECLARE_CYCLE_STAT(TEXT("Path Check"), STAT_SbsPathCheck, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Searches"), STAT_SbsPathSearches, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Cells Assumed Passable"), STAT_SbsPathCellsAssumed, STATGROUP_SimpleBuildSystem);
+DECLARE_CYCLE_STAT(TEXT("Navigation Flush"), STAT_SbsNavigationFlush, STATGROUP_SimpleBuildSystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Navigation Components Flushed"), STAT_SbsNavigationComponentsFlushed,
+    STATGROUP_SimpleBuildSystem);
+
+/** Path region is a flat array, hence keep it from eating memory if endpoints are spread too far apart. */
+static constexpr int32 MaxPathRegionCells = 1 << 20;
+
+bool FSBS_BuildGridSettings::operator==(const FSBS_BuildGridSettings &Other) const
+{
+    return ((CellSize == Other.CellSize) &&
+        (MaxSlopeDegrees == Other.MaxSlopeDegrees) &&
+        (MaxHeightDifference == Other.MaxHeightDifference) &&
+        (LayerTolerance == Other.LayerTolerance) &&
+        (TraceLength == Other.TraceLength) &&
+        (PrewarmCellsPerFrame == Other.PrewarmCellsPerFrame) &&
+        (GroundObjectTypes == Other.GroundObjectTypes) &&
+        (OccupancyObjectTypes == Other.OccupancyObjectTypes) &&
+        (PathSourceClasses == Other.PathSourceClasses) &&
+        (PathTargetClasses == Other.PathTargetClasses) &&
+        (PathSearchMargin == Other.PathSearchMargin) &&
+        (MaxPathStepHeight == Other.MaxPathStepHeight) &&
+        (MaxPathSlopeDegrees == Other.MaxPathSlopeDegrees) &&
+        (MaxPathCellsSampledPerSearch == Other.MaxPathCellsSampledPerSearch) &&
+        (NavigationUpdateDelay == Other.NavigationUpdateDelay));
+}
+
+bool FSBS_BuildGridSettings::operator!=(const FSBS_BuildGridSettings &Other) const
+{
+    return !(*this == Other);
+}
+
+USBS_BuildGridSubsystem *USBS_BuildGridSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<USBS_BuildGridSubsystem>()) : (nullptr);
+}
+
+bool USBS_BuildGridSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void USBS_BuildGridSubsystem::Deinitialize()
+{
+    FlushNavigationUpdates();
+
+    for (const auto &Pair : Occupants)
+    {
+        if (Pair.Key.IsValid())
+        {
+            Pair.Key->OnDestroyed.RemoveDynamic(this, &ThisClass::OnOccupantDestroyed);
+        }
+    }
+
+    Occupants.Empty();
+    ReservedAreas.Empty();
+    OccupiedCells.Empty();
+    InvalidateAll();
+
+    Super::Deinitialize();
+}
+
+void USBS_BuildGridSubsystem::Tick(float DeltaTime)
+{
+    if ((!PendingNavigationComponents.IsEmpty()) && (NavigationUpdateLocks == 0))
+    {
+        NavigationUpdateTimeRemaining -= DeltaTime;
+        if (NavigationUpdateTimeRemaining <= 0.f)
+        {
+            FlushNavigationUpdates();
+        }
+    }
+
+    if (!PendingPrewarm.IsEmpty())
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SbsGridPrewarm);
+
+        const int32 Count = FMath::Min(Settings.PrewarmCellsPerFrame, PendingPrewarm.Num());
+        for (int32 i = 0; i < Count; i++)
+        {
+            const TPair<FIntPoint, float> Pending = PendingPrewarm.Pop(false);
+            if (!Cells.Contains(Pending.Key))
+            {
+                SampleCell(Pending.Key, Pending.Value);
+            }
+        }
+    }
+}
+
+TStatId USBS_BuildGridSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USBS_BuildGridSubsystem, STATGROUP_Tickables);
+}
+
+void USBS_BuildGridSubsystem::Configure(const FSBS_BuildGridSettings &InSettings)
+{
+    if (Settings != InSettings)
+    {
+        Settings = InSettings;
+        InvalidateAll();
+    }
+
+    GroundQueryParams = FCollisionObjectQueryParams();
+    for (const ECollisionChannel CollisionChannel : Settings.GroundObjectTypes)
+    {
+        GroundQueryParams.AddObjectTypesToQuery(CollisionChannel);
+    }
+
+    OccupancyQueryParams = FCollisionObjectQueryParams();
+    for (const ECollisionChannel CollisionChannel : Settings.OccupancyObjectTypes)
+    {
+        OccupancyQueryParams.AddObjectTypesToQuery(CollisionChannel);
+    }
+
+    PathMinNormalZ = FMath::Cos(FMath::DegreesToRadians(Settings.MaxPathSlopeDegrees));
+
+    GatherPathEndpoints();
+}
+
+void USBS_BuildGridSubsystem::AddIgnoredActor(const AActor *Actor)
+{
+    if (IsValid(Actor))
+    {
+        IgnoredActors.AddUnique(Actor);
+        QueryParams.AddIgnoredActor(Actor);
+    }
+}
+
+void USBS_BuildGridSubsystem::RemoveIgnoredActor(const AActor *Actor)
+{
+    IgnoredActors.Remove(Actor);
+
+    // Collision query params can't remove a single actor, hence rebuild them
+    QueryParams.ClearIgnoredActors();
+    for (const TWeakObjectPtr<const AActor> &IgnoredActor : IgnoredActors)
+    {
+        if (IgnoredActor.IsValid())
+        {
+            QueryParams.AddIgnoredActor(IgnoredActor.Get());
+        }
+    }
+}
+
+FIntPoint USBS_BuildGridSubsystem::LocationToCell(const FVector &Location) const
+{
+    return FIntPoint(
+        FMath::FloorToInt(Location.X / Settings.CellSize),
+        FMath::FloorToInt(Location.Y / Settings.CellSize));
+}
+
+FVector USBS_BuildGridSubsystem::CellToLocation(const FIntPoint &Cell, float Z) const
+{
+    return FVector(
+        (static_cast<float>(Cell.X) + 0.5f) * Settings.CellSize,
+        (static_cast<float>(Cell.Y) + 0.5f) * Settings.CellSize,
+        Z);
+}
+
+const FSBS_BuildGridCell &USBS_BuildGridSubsystem::FindOrSampleCell(const FVector &Location)
+{
+    const FSBS_BuildGridCell *Cell = FindCachedCell(Location);
+    if (Cell)
+    {
+        INC_DWORD_STAT(STAT_SbsGridCacheHits);
+        return *Cell;
+    }
+
+    return SampleCell(LocationToCell(Location), Location.Z);
+}
+
+const FSBS_BuildGridCell *USBS_BuildGridSubsystem::FindCachedCell(const FVector &Location) const
+{
+    const FSBS_BuildGridCell *Cell = Cells.Find(LocationToCell(Location));
+    return ((Cell) && ((!Cell->bHasGround) || (FMath::Abs(Location.Z - Cell->GroundZ) <= Settings.LayerTolerance))) ?
+        (Cell) : (nullptr);
+}
+
+void USBS_BuildGridSubsystem::PrewarmArea(const FVector &Center, float Radius)
+{
+    const FIntPoint CenterCell = LocationToCell(Center);
+    const int32 CellRadius = FMath::CeilToInt(Radius / Settings.CellSize);
+    const int32 CellRadiusSquared = FMath::Square(CellRadius);
+
+    // Pending cells are popped from the back, hence push the farthest ones first
+    TArray<TPair<FIntPoint, float>> NewCells;
+    for (int32 X = -CellRadius; X <= CellRadius; X++)
+    {
+        for (int32 Y = -CellRadius; Y <= CellRadius; Y++)
+        {
+            const FIntPoint CellIndex = CenterCell + FIntPoint(X, Y);
+            if ((X * X + Y * Y <= CellRadiusSquared) && (!Cells.Contains(CellIndex)))
+            {
+                NewCells.Emplace(CellIndex, Center.Z);
+            }
+        }
+    }
+
+    NewCells.Sort([CenterCell](const TPair<FIntPoint, float> &Lhs, const TPair<FIntPoint, float> &Rhs)
+    {
+        return ((Lhs.Key - CenterCell).SizeSquared() > (Rhs.Key - CenterCell).SizeSquared());
+    });
+
+    PendingPrewarm.Append(MoveTemp(NewCells));
+}
+
+bool USBS_BuildGridSubsystem::IsAreaBuildable(const FBox &Bounds, float ReferenceZ)
+{
+    const FIntPoint Min = LocationToCell(Bounds.Min);
+    const FIntPoint Max = LocationToCell(Bounds.Max);
+
+    float MinZ = TNumericLimits<float>::Max();
+    float MaxZ = TNumericLimits<float>::Lowest();
+
+    for (int32 X = Min.X; X <= Max.X; X++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            const FIntPoint CellIndex(X, Y);
+            if (IsCellOccupied(CellIndex))
+            {
+                return false;
+            }
+
+            const FSBS_BuildGridCell &Cell = FindOrSampleCell(CellToLocation(CellIndex, ReferenceZ));
+            if (!Cell.IsBuildable())
+            {
+                return false;
+            }
+
+            MinZ = FMath::Min(MinZ, Cell.GroundZ);
+            MaxZ = FMath::Max(MaxZ, Cell.GroundZ);
+        }
+    }
+
+    return ((MaxZ - MinZ) <= Settings.MaxHeightDifference);
+}
+
+void USBS_BuildGridSubsystem::AddOccupant(AActor *Actor, const FBox &Bounds)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    if (Occupants.Contains(Actor))
+    {
+        UE_LOG(LogSimpleBuildSystem, Warning, TEXT("Actor [%s] already occupies the grid."), *Actor->GetName());
+        return;
+    }
+
+    Occupants.Add(Actor, Bounds);
+    AddOccupiedCells(Bounds, 1);
+    InvalidatePaths();
+
+    Actor->OnDestroyed.AddDynamic(this, &ThisClass::OnOccupantDestroyed);
+}
+
+void USBS_BuildGridSubsystem::RemoveOccupant(AActor *Actor)
+{
+    FBox Bounds;
+    if (!Occupants.RemoveAndCopyValue(Actor, Bounds))
+    {
+        return;
+    }
+
+    AddOccupiedCells(Bounds, -1);
+    InvalidatePaths();
+
+    if (IsValid(Actor))
+    {
+        Actor->OnDestroyed.RemoveDynamic(this, &ThisClass::OnOccupantDestroyed);
+    }
+}
+
+int32 USBS_BuildGridSubsystem::ReserveArea(const FBox &Bounds)
+{
+    const int32 Handle = NextReservationHandle++;
+
+    ReservedAreas.Add(Handle, Bounds);
+    AddOccupiedCells(Bounds, 1);
+    InvalidatePaths();
+
+    return Handle;
+}
+
+void USBS_BuildGridSubsystem::ReleaseReservedArea(int32 Handle)
+{
+    FBox Bounds;
+    if (ReservedAreas.RemoveAndCopyValue(Handle, Bounds))
+    {
+        AddOccupiedCells(Bounds, -1);
+        InvalidatePaths();
+    }
+}
+
+void USBS_BuildGridSubsystem::InvalidateArea(const FBox &Bounds)
+{
+    TArray<FIntPoint> AreaCells;
+    GetCellsInBox(Bounds, AreaCells);
+
+    for (const FIntPoint &CellIndex : AreaCells)
+    {
+        if (Cells.Remove(CellIndex) > 0)
+        {
+            DEC_DWORD_STAT(STAT_SbsGridCachedCells);
+        }
+    }
+
+    InvalidatePaths();
+}
+
+void USBS_BuildGridSubsystem::InvalidateAll()
+{
+    DEC_DWORD_STAT_BY(STAT_SbsGridCachedCells, Cells.Num());
+    Cells.Empty();
+    PendingPrewarm.Empty();
+
+    // Cell size may have changed, hence lay the objects that are still standing on the grid again
+    OccupiedCells.Empty();
+    for (const auto &Pair : Occupants)
+    {
+        AddOccupiedCells(Pair.Value, 1);
+    }
+    for (const auto &Pair : ReservedAreas)
+    {
+        AddOccupiedCells(Pair.Value, 1);
+    }
+
+    InvalidatePaths();
+}
+
+void USBS_BuildGridSubsystem::GatherPathEndpoints()
+{
+    InvalidatePaths();
+
+    PathRegion = FIntRect();
+    PathSourceBounds.Reset();
+    PathTargetBounds.Reset();
+    PathSourceCells.Reset();
+    PathSourceZ.Reset();
+    PathTargetOfCell.Reset();
+    PathEndpointCells.Reset();
+
+    const auto GatherBounds = [this](const TArray<TSubclassOf<AActor>> &Classes, TArray<FBox> &OutBounds)
+    {
+        for (const TSubclassOf<AActor> &Class : Classes)
+        {
+            if (!Class)
+            {
+                continue;
+            }
+
+            for (TActorIterator<AActor> It(GetWorld(), Class); It; ++It)
+            {
+                const AActor *Actor = *It;
+                const FVector Location = Actor->GetActorLocation();
+                const FBox Bounds = Actor->GetComponentsBoundingBox(true);
+
+                OutBounds.Add((Bounds.IsValid) ? (Bounds) : (FBox(Location, Location)));
+            }
+        }
+    };
+
+    GatherBounds(Settings.PathSourceClasses, PathSourceBounds);
+    GatherBounds(Settings.PathTargetClasses, PathTargetBounds);
+
+    if ((PathSourceBounds.IsEmpty()) || (PathTargetBounds.IsEmpty()))
+    {
+        return;
+    }
+
+    FBox RegionBounds(ForceInit);
+    for (const FBox &Bounds : PathSourceBounds)
+    {
+        RegionBounds += Bounds;
+    }
+    for (const FBox &Bounds : PathTargetBounds)
+    {
+        RegionBounds += Bounds;
+    }
+    RegionBounds = RegionBounds.ExpandBy(FVector(Settings.PathSearchMargin, Settings.PathSearchMargin, 0.f));
+
+    const FIntRect Region(LocationToCell(RegionBounds.Min), LocationToCell(RegionBounds.Max) + FIntPoint(1, 1));
+    const int32 NumCells = Region.Area();
+    if (NumCells > MaxPathRegionCells)
+    {
+        UE_LOG(LogSimpleBuildSystem, Warning, TEXT("Path region is too big (%d cells), path check is disabled."),
+            NumCells);
+        PathSourceBounds.Reset();
+        PathTargetBounds.Reset();
+        return;
+    }
+
+    PathRegion = Region;
+    PathTargetOfCell.Init(INDEX_NONE, NumCells);
+    PathEndpointCells.Init(false, NumCells);
+
+    TArray<FIntPoint> EndpointCells;
+    for (int32 i = 0; i < PathTargetBounds.Num(); i++)
+    {
+        EndpointCells.Reset();
+        GetCellsInBox(PathTargetBounds[i], EndpointCells);
+
+        for (const FIntPoint &CellIndex : EndpointCells)
+        {
+            const int32 PathIndex = CellToPathIndex(CellIndex);
+            PathTargetOfCell[PathIndex] = i;
+            PathEndpointCells[PathIndex] = true;
+        }
+    }
+
+    for (const FBox &Bounds : PathSourceBounds)
+    {
+        EndpointCells.Reset();
+        GetCellsInBox(Bounds, EndpointCells);
+
+        for (const FIntPoint &CellIndex : EndpointCells)
+        {
+            const int32 PathIndex = CellToPathIndex(CellIndex);
+            if (!PathSourceCells.Contains(PathIndex))
+            {
+                PathSourceCells.Add(PathIndex);
+                PathSourceZ.Add(Bounds.Min.Z);
+            }
+            PathEndpointCells[PathIndex] = true;
+        }
+    }
+
+    // Sample the whole region in advance, so that the first path search doesn't have to
+    const FVector RegionCenter = RegionBounds.GetCenter();
+    PrewarmArea(RegionCenter, RegionBounds.GetExtent().Size2D());
+}
+
+bool USBS_BuildGridSubsystem::WouldBlockPaths(const FBox &Bounds)
+{
+    if ((PathSourceCells.IsEmpty()) || (PathTargetBounds.IsEmpty()))
+    {
+        return false;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_SbsPathCheck);
+
+    if (!bPathBaselineValid)
+    {
+        SearchPaths(FIntRect(), true);
+        bPathBaselineValid = true;
+    }
+
+    const FIntRect Footprint(LocationToCell(Bounds.Min), LocationToCell(Bounds.Max) + FIntPoint(1, 1));
+    if ((bLastPathCheckValid) && (LastPathCheckFootprint == Footprint))
+    {
+        return bLastPathCheckResult;
+    }
+
+    // Paths found by the baseline search stay open if the footprint doesn't touch any of them
+    bool bTouchesPath = false;
+    for (int32 X = FMath::Max(Footprint.Min.X, PathRegion.Min.X); (X < FMath::Min(Footprint.Max.X, PathRegion.Max.X)) &&
+        (!bTouchesPath); X++)
+    {
+        for (int32 Y = FMath::Max(Footprint.Min.Y, PathRegion.Min.Y); Y < FMath::Min(Footprint.Max.Y, PathRegion.Max.Y);
+            Y++)
+        {
+            if (BaselinePathCells[CellToPathIndex(FIntPoint(X, Y))])
+            {
+                bTouchesPath = true;
+                break;
+            }
+        }
+    }
+
+    LastPathCheckFootprint = Footprint;
+    bLastPathCheckResult = ((bTouchesPath) && (!SearchPaths(Footprint, false)));
+    bLastPathCheckValid = true;
+
+    return bLastPathCheckResult;
+}
+
+void USBS_BuildGridSubsystem::DeferNavigationUpdate(AActor *Actor)
+{
+    if ((!IsValid(Actor)) || ((Settings.NavigationUpdateDelay <= 0.f) && (NavigationUpdateLocks == 0)))
+    {
+        return;
+    }
+
+    const bool bWasEmpty = PendingNavigationComponents.IsEmpty();
+
+    TInlineComponentArray<UActorComponent*> Components(Actor);
+    for (UActorComponent *Component : Components)
+    {
+        if (Component->CanEverAffectNavigation())
+        {
+            Component->SetCanEverAffectNavigation(false);
+            PendingNavigationComponents.Add(Component);
+        }
+    }
+
+    // Don't postpone the update with each new actor, otherwise a steady stream of them would never be applied
+    if ((bWasEmpty) && (!PendingNavigationComponents.IsEmpty()))
+    {
+        NavigationUpdateTimeRemaining = Settings.NavigationUpdateDelay;
+    }
+}
+
+void USBS_BuildGridSubsystem::FlushNavigationUpdates()
+{
+    if (PendingNavigationComponents.IsEmpty())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_SbsNavigationFlush);
+    INC_DWORD_STAT_BY(STAT_SbsNavigationComponentsFlushed, PendingNavigationComponents.Num());
+
+    // All the dirty areas reach the navigation system within the same frame, hence shared tiles are rebuilt once
+    for (const TWeakObjectPtr<UActorComponent> &Component : PendingNavigationComponents)
+    {
+        if (Component.IsValid())
+        {
+            Component->SetCanEverAffectNavigation(true);
+        }
+    }
+
+    PendingNavigationComponents.Reset();
+    NavigationUpdateTimeRemaining = 0.f;
+}
+
+void USBS_BuildGridSubsystem::LockNavigationUpdates()
+{
+    NavigationUpdateLocks++;
+}
+
+void USBS_BuildGridSubsystem::UnlockNavigationUpdates()
+{
+    if (!ensure(NavigationUpdateLocks > 0))
+    {
+        return;
+    }
+
+    NavigationUpdateLocks--;
+    if (NavigationUpdateLocks == 0)
+    {
+        FlushNavigationUpdates();
+    }
+}
+
+FSBS_BuildGridCell &USBS_BuildGridSubsystem::SampleCell(const FIntPoint &CellIndex, float ReferenceZ)
+{
+    INC_DWORD_STAT(STAT_SbsGridCellsSampled);
+
+    const UWorld *World = GetWorld();
+    const FVector Center = CellToLocation(CellIndex, ReferenceZ);
+
+    // Start a bit above the reference, so that the ground the reference point lies on is found
+    const FVector LineStart = Center + FVector(0.f, 0.f, Settings.LayerTolerance);
+    const FVector LineEnd = LineStart - FVector(0.f, 0.f, Settings.TraceLength);
+
+    FCollisionQueryParams GroundParams = QueryParams;
+    GroundParams.bTraceComplex = true;
+
+    FHitResult Hit;
+    World->LineTraceSingleByObjectType(Hit, LineStart, LineEnd, GroundQueryParams, GroundParams);
+
+    FSBS_BuildGridCell *Cell = Cells.Find(CellIndex);
+    if (!Cell)
+    {
+        Cell = &Cells.Add(CellIndex);
+        INC_DWORD_STAT(STAT_SbsGridCachedCells);
+    }
+
+    Cell->bHasGround = Hit.bBlockingHit;
+    Cell->GroundZ = (Hit.bBlockingHit) ? (Hit.ImpactPoint.Z) : (LineEnd.Z);
+    Cell->Normal = (Hit.bBlockingHit) ? (FVector(Hit.ImpactNormal)) : (FVector::UpVector);
+
+    const float MinNormalZ = FMath::Cos(FMath::DegreesToRadians(Settings.MaxSlopeDegrees));
+    Cell->bWalkable = ((Cell->bHasGround) && (Cell->Normal.Z >= MinNormalZ));
+
+    Cell->bBlocked = false;
+    if ((Cell->bHasGround) && (OccupancyQueryParams.IsValid()))
+    {
+        // Leave a small gap, so that objects on the neighbouring cells aren't caught
+        const float HalfCell = Settings.CellSize * 0.5f - 1.f;
+        const FVector BoxCenter(Center.X, Center.Y, Cell->GroundZ + Settings.CellSize * 0.5f);
+        const FCollisionShape Box = FCollisionShape::MakeBox(FVector(HalfCell, HalfCell, Settings.CellSize * 0.5f));
+
+        Cell->bBlocked = World->OverlapAnyTestByObjectType(
+            BoxCenter, FQuat::Identity, OccupancyQueryParams, Box, QueryParams);
+    }
+
+    return *Cell;
+}
+
+void USBS_BuildGridSubsystem::GetCellsInBox(const FBox &Bounds, TArray<FIntPoint> &OutCells) const
+{
+    const FIntPoint Min = LocationToCell(Bounds.Min);
+    const FIntPoint Max = LocationToCell(Bounds.Max);
+
+    OutCells.Reserve(OutCells.Num() + (Max.X - Min.X + 1) * (Max.Y - Min.Y + 1));
+    for (int32 X = Min.X; X <= Max.X; X++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            OutCells.Emplace(X, Y);
+        }
+    }
+}
+
+void USBS_BuildGridSubsystem::AddOccupiedCells(const FBox &Bounds, int32 Delta)
+{
+    TArray<FIntPoint> AreaCells;
+    GetCellsInBox(Bounds, AreaCells);
+
+    for (const FIntPoint &CellIndex : AreaCells)
+    {
+        int32 &Count = OccupiedCells.FindOrAdd(CellIndex);
+        Count += Delta;
+
+        if (Count <= 0)
+        {
+            OccupiedCells.Remove(CellIndex);
+        }
+    }
+}
+
+bool USBS_BuildGridSubsystem::SearchPaths(const FIntRect &BlockedCells, bool bBaseline)
+{
+    INC_DWORD_STAT(STAT_SbsPathSearches);
+
+    const int32 NumCells = PathRegion.Area();
+    const int32 NumTargets = PathTargetBounds.Num();
+
+    TBitArray<> Visited(false, NumCells);
+    TBitArray<> Reached(false, NumTargets);
+
+    TArray<float> GroundZ;
+    GroundZ.SetNumUninitialized(NumCells);
+
+    // Parents are needed only to find the cells the baseline paths go through
+    TArray<int32> Parents;
+    if (bBaseline)
+    {
+        Parents.Init(INDEX_NONE, NumCells);
+        BaselinePathCells.Init(false, NumCells);
+    }
+
+    int32 RequiredLeft = (bBaseline) ? (NumTargets) : (ReachableTargets.CountSetBits());
+
+    TArray<int32> Queue;
+    Queue.Reserve(NumCells);
+
+    PathSamplesLeft = Settings.MaxPathCellsSampledPerSearch;
+
+    for (int32 i = 0; i < PathSourceCells.Num(); i++)
+    {
+        const int32 PathIndex = PathSourceCells[i];
+        const FIntPoint CellIndex = PathIndexToCell(PathIndex);
+        const float SourceZ = PathSourceZ[i];
+
+        // Source cells may lay above the ground, hence take the height the cell has been sampled with
+        const FSBS_BuildGridCell &Cell = FindOrSampleCell(CellToLocation(CellIndex, SourceZ));
+
+        Visited[PathIndex] = true;
+        GroundZ[PathIndex] = (Cell.bHasGround) ? (Cell.GroundZ) : (SourceZ);
+        Queue.Add(PathIndex);
+    }
+
+    static const FIntPoint Directions[] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+
+    for (int32 Head = 0; (Head < Queue.Num()) && (RequiredLeft > 0); Head++)
+    {
+        const int32 PathIndex = Queue[Head];
+
+        const int32 TargetIndex = PathTargetOfCell[PathIndex];
+        if ((TargetIndex != INDEX_NONE) && (!Reached[TargetIndex]))
+        {
+            Reached[TargetIndex] = true;
+
+            if (bBaseline)
+            {
+                RequiredLeft--;
+                for (int32 Index = PathIndex; Index != INDEX_NONE; Index = Parents[Index])
+                {
+                    BaselinePathCells[Index] = true;
+                }
+            }
+            else if (ReachableTargets[TargetIndex])
+            {
+                RequiredLeft--;
+            }
+        }
+
+        const FIntPoint CellIndex = PathIndexToCell(PathIndex);
+        for (const FIntPoint &Direction : Directions)
+        {
+            const FIntPoint NextCellIndex = CellIndex + Direction;
+            if (!PathRegion.Contains(NextCellIndex))
+            {
+                continue;
+            }
+
+            const int32 NextPathIndex = CellToPathIndex(NextCellIndex);
+            if (Visited[NextPathIndex])
+            {
+                continue;
+            }
+
+            float NextGroundZ;
+            if (!IsPathCellPassable(NextCellIndex, NextPathIndex, GroundZ[PathIndex], BlockedCells, NextGroundZ))
+            {
+                continue;
+            }
+
+            Visited[NextPathIndex] = true;
+            GroundZ[NextPathIndex] = NextGroundZ;
+            if (bBaseline)
+            {
+                Parents[NextPathIndex] = PathIndex;
+            }
+            Queue.Add(NextPathIndex);
+        }
+    }
+
+    if (bBaseline)
+    {
+        ReachableTargets = Reached;
+    }
+
+    return (RequiredLeft == 0);
+}
+
+bool USBS_BuildGridSubsystem::IsPathCellPassable(const FIntPoint &CellIndex, int32 PathIndex, float FromZ,
+    const FIntRect &BlockedCells, float &OutGroundZ)
+{
+    const bool bEndpoint = PathEndpointCells[PathIndex];
+    if ((!bEndpoint) && ((BlockedCells.Contains(CellIndex)) || (IsCellOccupied(CellIndex))))
+    {
+        return false;
+    }
+
+    // Sampling is synchronous, hence once the budget is spent the cells that haven't been sampled yet are assumed to
+    // be passable rather than traced, which may only let a blocking placement through
+    const FVector Location = CellToLocation(CellIndex, FromZ);
+    if (!FindCachedCell(Location))
+    {
+        if (PathSamplesLeft <= 0)
+        {
+            INC_DWORD_STAT(STAT_SbsPathCellsAssumed);
+            OutGroundZ = FromZ;
+            return true;
+        }
+
+        PathSamplesLeft--;
+    }
+
+    const FSBS_BuildGridCell &Cell = FindOrSampleCell(Location);
+
+    // Endpoints are usually obstacles themselves, yet paths must be able to reach them
+    if (bEndpoint)
+    {
+        OutGroundZ = (Cell.bHasGround) ? (Cell.GroundZ) : (FromZ);
+        return true;
+    }
+
+    if ((!Cell.IsPassable(PathMinNormalZ)) || (FMath::Abs(Cell.GroundZ - FromZ) > Settings.MaxPathStepHeight))
+    {
+        return false;
+    }
+
+    OutGroundZ = Cell.GroundZ;
+    return true;
+}
+
+void USBS_BuildGridSubsystem::InvalidatePaths()
+{
+    bPathBaselineValid = false;
+    bLastPathCheckValid = false;
+}
+
+void USBS_BuildGridSubsystem::OnOccupantDestroyed(AActor *Actor)
+{
+    RemoveOccupant(Actor);
+}
@@ -0,0 +1,40 @@
+#include "SBS_BuildableData.h"
+
+bool USBS_BuildableData::IsLoaded() const
+{
+    return ((!ObjectClass.IsPending()) && (!StaticMesh.IsPending()) && (!AllowMaterial.IsPending()) &&
+        (!ForbidMaterial.IsPending()));
+}
+
+void USBS_BuildableData::GetAssetPaths(TArray<FSoftObjectPath> &OutPaths) const
+{
+    // The object class pulls in whatever it references itself, e.g. its data assets and projectiles
+    for (const FSoftObjectPath &Path : { ObjectClass.ToSoftObjectPath(), StaticMesh.ToSoftObjectPath(),
+        AllowMaterial.ToSoftObjectPath(), ForbidMaterial.ToSoftObjectPath() })
+    {
+        if (!Path.IsNull())
+        {
+            OutPaths.AddUnique(Path);
+        }
+    }
+}
+
+FSBS_BuildingData USBS_BuildableData::ToBuildingData() const
+{
+    FSBS_BuildingData Data;
+    Data.ObjectClass = ObjectClass.Get();
+    Data.StaticMesh = StaticMesh.Get();
+    Data.AllowMaterial = AllowMaterial.Get();
+    Data.ForbidMaterial = ForbidMaterial.Get();
+    Data.Duration = Duration;
+    Data.bDrawVision = bDrawVision;
+    Data.VisionRange = VisionRange;
+    Data.VisionDegrees = VisionDegrees;
+
+    if (!Data.IsValid())
+    {
+        UE_LOG(LogSimpleBuildSystem, Warning, TEXT("Buildable [%s] is either not loaded or incomplete."), *GetName());
+    }
+
+    return Data;
+}
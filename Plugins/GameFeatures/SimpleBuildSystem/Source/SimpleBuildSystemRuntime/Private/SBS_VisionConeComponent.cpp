@@ -0,0 +1,145 @@
+#include "SBS_VisionConeComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Vision Cone Rebuild"), STAT_SbsVisionConeRebuild, STATGROUP_SimpleBuildSystem);
+
+USBS_VisionConeComponent::USBS_VisionConeComponent(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+
+    SetCollisionProfileName("NoCollision");
+    SetGenerateOverlapEvents(false);
+    SetCanEverAffectNavigation(false);
+    CastShadow = false;
+    bUseAsyncCooking = false;
+}
+
+void USBS_VisionConeComponent::SetCone(float Range, float Degrees, float Height)
+{
+    FSBS_VisionCone Cone;
+    Cone.Range = Range;
+    Cone.Degrees = Degrees;
+    Cone.Height = Height;
+
+    if ((bHasSingleCone) && (BuiltCone == Cone))
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_SbsVisionConeRebuild);
+
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    AppendCone(Cone, ArcSegments, Vertices, Triangles);
+
+    UpdateMeshSection(Vertices, Triangles);
+
+    BuiltCone = Cone;
+    bHasSingleCone = true;
+}
+
+void USBS_VisionConeComponent::SetCones(const TArray<FSBS_VisionCone> &Cones)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SbsVisionConeRebuild);
+
+    // Vertices are in the world space, hence the component must stay at the world origin
+    SetUsingAbsoluteLocation(true);
+    SetUsingAbsoluteRotation(true);
+    SetUsingAbsoluteScale(true);
+    SetWorldTransform(FTransform::Identity);
+
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    for (const FSBS_VisionCone &Cone : Cones)
+    {
+        AppendCone(Cone, ArcSegments, Vertices, Triangles);
+    }
+
+    UpdateMeshSection(Vertices, Triangles);
+    bHasSingleCone = false;
+}
+
+void USBS_VisionConeComponent::ClearCones()
+{
+    ClearAllMeshSections();
+    bHasSingleCone = false;
+}
+
+void USBS_VisionConeComponent::AppendCone(const FSBS_VisionCone &Cone, int32 Segments, TArray<FVector> &Vertices,
+    TArray<int32> &Triangles)
+{
+    if ((Cone.Range <= 0.f) || (Cone.Degrees <= 0.f))
+    {
+        return;
+    }
+
+    const float HalfRad = FMath::DegreesToRadians(FMath::Min(Cone.Degrees, 360.f) / 2.f);
+    const float AngleStep = HalfRad * 2.f / static_cast<float>(Segments);
+    const FVector HeightVector = FVector::UpVector * Cone.Height;
+
+    // Layout: bottom root, top root, then a bottom and a top vertex per arc point
+    const int32 First = Vertices.Num();
+    Vertices.Reserve(First + 2 + (Segments + 1) * 2);
+    Triangles.Reserve(Triangles.Num() + Segments * 12 + 12);
+
+    Vertices.Add(Cone.Transform.TransformPosition(FVector::ZeroVector));
+    Vertices.Add(Cone.Transform.TransformPosition(HeightVector));
+
+    for (int32 i = 0; i <= Segments; i++)
+    {
+        const float Angle = -HalfRad + AngleStep * static_cast<float>(i);
+        const FVector Point = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Cone.Range;
+
+        Vertices.Add(Cone.Transform.TransformPosition(Point));
+        Vertices.Add(Cone.Transform.TransformPosition(Point + HeightVector));
+    }
+
+    const auto AddQuad = [&Triangles](int32 A, int32 B, int32 C, int32 D)
+    {
+        Triangles.Append({ A, B, C, A, C, D });
+    };
+
+    const int32 BottomRoot = First;
+    const int32 TopRoot = First + 1;
+    for (int32 i = 0; i < Segments; i++)
+    {
+        const int32 Bottom = First + 2 + i * 2;
+        const int32 Top = Bottom + 1;
+        const int32 NextBottom = Bottom + 2;
+        const int32 NextTop = Bottom + 3;
+
+        // Bottom and top caps
+        Triangles.Append({ BottomRoot, Bottom, NextBottom });
+        Triangles.Append({ TopRoot, NextTop, Top });
+
+        // Front arc
+        AddQuad(Bottom, Top, NextTop, NextBottom);
+    }
+
+    // Side walls are hidden inside a full circle
+    if (Cone.Degrees < 360.f)
+    {
+        const int32 LeftBottom = First + 2;
+        const int32 RightBottom = First + 2 + Segments * 2;
+
+        AddQuad(BottomRoot, TopRoot, LeftBottom + 1, LeftBottom);
+        AddQuad(BottomRoot, RightBottom, RightBottom + 1, TopRoot);
+    }
+}
+
+void USBS_VisionConeComponent::UpdateMeshSection(const TArray<FVector> &Vertices, const TArray<int32> &Triangles)
+{
+    static const TArray<FVector> Normals;
+    static const TArray<FVector2D> UV0;
+    static const TArray<FLinearColor> VertexColors;
+    static const TArray<FProcMeshTangent> Tangents;
+
+    if (Vertices.IsEmpty())
+    {
+        ClearAllMeshSections();
+        return;
+    }
+
+    CreateMeshSection_LinearColor(0, Vertices, Triangles, Normals, UV0, VertexColors, Tangents, false);
+}
@@ -2,12 +2,18 @@
 
 #include "CoreMinimal.h"
 #include "Components/PawnComponent.h"
+#include "SBS_BuildGridSubsystem.h"
+#include "SBS_VisionConeComponent.h"
+#include "SimpleBuildSystemRuntime/sbs.h"
 
 #include "SBS_BuildComponent.generated.h"
 
 class ASBS_BuildGhostActor;
 class UCameraComponent;
 class UInputMappingContext;
+class UInstancedStaticMeshComponent;
+class USBS_BuildableData;
+struct FStreamableHandle;
 
 /** Enumeration defining build state. */
 UENUM(BlueprintType)
@@ -67,6 +73,26 @@ public:
     float VisionDegrees = 0.f;
 };
 
+/** Where and how a building is going to be placed. */
+struct FSBS_Placement
+{
+    /** Transform the building is spawned with. */
+    FTransform SpawnTransform = FTransform::Identity;
+
+    /** Transforms of the ghost mesh and its vision cone at the moment of placing. */
+    FTransform MeshTransform = FTransform::Identity;
+    FTransform VisionTransform = FTransform::Identity;
+
+    FBox Footprint = FBox(ForceInit);
+    float VisionHeight = 0.f;
+
+    /** Build grid reservation that keeps the cells taken until the building is spawned. */
+    int32 ReservationHandle = INDEX_NONE;
+
+    /** Index of the building data the placement has been confirmed with in the spawn queue. */
+    int32 BuildingDataIndex = INDEX_NONE;
+};
+
 /**
  * Simple build component that gives a player the possibility to build an object.
  * There are 4 steps before finishing the building process:
@@ -104,7 +130,10 @@ public:
     virtual void TickComponent(
         float DeltaSeconds, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
-    /** Enable build mode by initializing everything related and giving the new inputs. */
+    /**
+     * Enable build mode by initializing everything related and giving the new inputs. Fails until the buildable set
+     * has been streamed in.
+     */
     UFUNCTION(BlueprintCallable, Category="Build Component")
     bool BuildModeEnable(FSBS_BuildingData Data);
 
@@ -120,11 +149,63 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category="Build Component")
     void BuildConfirm();
 
+    /**
+     * Keep the assets of every building the player can select referenced, and spawn the ghost in advance, so that
+     * enabling build mode and switching between the buildings doesn't hitch.
+     */
+    UFUNCTION(BlueprintCallable, Category="Build Component")
+    void PreloadBuildingData(const TArray<FSBS_BuildingData> &Data);
+
+    /** Whether the assets of every building in the buildable set are in memory, hence placing them won't hitch. */
+    UFUNCTION(BlueprintPure, Category="Build Component|Streaming")
+    bool IsBuildableSetLoaded() const;
+
+    /** Normalized progress of streaming the buildable set in. */
+    UFUNCTION(BlueprintPure, Category="Build Component|Streaming")
+    float GetBuildableSetLoadProgress() const;
+
+    /**
+     * Remember the current ghost placement instead of building it right away. Queued placements are validated against
+     * each other, and are all spawned at once on ConfirmPlacementQueue.
+     * @return True if the placement has been queued.
+     */
+    UFUNCTION(BlueprintCallable, Category="Build Component|Batch")
+    bool QueuePlacement();
+
+    /**
+     * Queue placements along the line from the last queued placement to the ghost, a footprint apart from each other.
+     * Placements that aren't valid are skipped.
+     * @return Amount of queued placements.
+     */
+    UFUNCTION(BlueprintCallable, Category="Build Component|Batch")
+    int32 QueuePlacementLine();
+
+    /** Forget all the queued placements. */
+    UFUNCTION(BlueprintCallable, Category="Build Component|Batch")
+    void ClearPlacementQueue();
+
+    /**
+     * Spawn all the queued placements, a few per frame, and stop building. The build duration doesn't apply to them.
+     * A batch confirmed while the previous one is still spawning is appended to it. Navigation is updated once the
+     * last of them has been spawned.
+     */
+    UFUNCTION(BlueprintCallable, Category="Build Component|Batch")
+    void ConfirmPlacementQueue();
+
+    UFUNCTION(BlueprintPure, Category="Build Component|Batch")
+    int32 GetQueuedPlacementCount() const;
+
+#if !UE_BUILD_SHIPPING
+    /** Switch between the preloaded buildings the given amount of times in a row, and log how long it took. */
+    void RunSwitchBuildingsBenchmark(int32 Count);
+#endif
+
 protected:
     virtual void BuildConfirm_Implementation();
 
     //~AActor interface
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     //~End of AActor interface
 
     /** Spawn and setup ghost build actor. */
@@ -177,12 +258,52 @@ protected:
 private:
     void BindBuildDelegates();
 
+    /** Start streaming the buildable set in through the asset manager's streamable manager. */
+    void LoadBuildableSet();
+    void OnBuildableSetLoaded();
+
+    /** Spawn the ghost if it hasn't been done yet. The ghost is kept around between builds, and hidden once unused. */
     void CreateGhostBuildActor();
-    AActor *SpawnBuilding() const;
+    void DestroyGhostBuildActor();
+
+    /** Placement the ghost is at right now. */
+    FSBS_Placement CapturePlacement() const;
+
+    /** Spawn the building, and let the build grid and the vision coverage know about it. */
+    AActor *FinishPlacement(const FSBS_BuildingData &Data, const FSBS_Placement &Placement);
+
+    /** Add a placement to the queue, and reserve its cells. */
+    void AddQueuedPlacement(FSBS_Placement &&Placement);
+
+    /** Spawn queued buildings until either the per-frame count or the time budget is exhausted. */
+    void TickSpawnQueue();
+    void SpawnQueuedBuilding();
+    void FinishSpawnQueue();
+
+    /** Make the ghost visualize the active building data. */
+    void ApplyBuildingDataToGhost();
+    AActor *SpawnBuilding(const FSBS_BuildingData &Data, const FTransform &Transform) const;
+
+    /** Configure the build grid and start sampling the cells around the owner. */
+    void SetupBuildGrid();
+
+    /** Remember the vision of a built object, so that it's shown along with the others while in build mode. */
+    void AddBuiltVisionCone(AActor *Actor, const FSBS_BuildingData &Data, const FSBS_Placement &Placement);
+    void ShowBuiltVisionCoverage();
+    void HideBuiltVisionCoverage();
+
+    /** Material vision cones are drawn with, or the engine default one if none is set. */
+    UMaterialInterface *GetVisionConeMaterial() const;
 
     void OnBuildAllowed();
     void OnBuildForbid();
 
+    /**
+     * Combine the ghost overlaps with the build grid verdict, and switch the ghost material if the result has changed.
+     * @param  bForceMaterial	If true, the material is applied even if the result hasn't changed.
+     */
+    void RefreshPlacementValidity(bool bForceMaterial = false);
+
     void AddInputContext(const UInputMappingContext *InputMappingContext);
     void RemoveInputContext(const UInputMappingContext *InputMappingContext);
 
@@ -214,6 +335,9 @@ public:
     UPROPERTY(BlueprintCallable, BlueprintAssignable)
     FOnBuildStateChangedSignature OnBuildStateChangedDelegate;
 
+    UPROPERTY(BlueprintCallable, BlueprintAssignable)
+    FDynamicMulticastDelegateSignature OnBuildableSetLoadedDelegate;
+
 private:
     /** Should the component work? */
     UPROPERTY(BlueprintReadOnly, Category="Build Component", meta=(AllowPrivateAccess="true"))
@@ -239,6 +363,46 @@ private:
     UPROPERTY(BlueprintReadOnly, Category="Build Component", meta=(AllowPrivateAccess="true"))
     TObjectPtr<ASBS_BuildGhostActor> BuildGhostActor = nullptr;
 
+    /** Placements waiting for the player to confirm them. */
+    TArray<FSBS_Placement> PlacementQueue;
+
+    /** Placements being spawned, starting at SpawnQueueHead. */
+    TArray<FSBS_Placement> SpawnQueue;
+    int32 SpawnQueueHead = 0;
+
+    /** Building data of every batch in the spawn queue. Placements refer to it by BuildingDataIndex. */
+    UPROPERTY()
+    TArray<FSBS_BuildingData> SpawnQueueBuildingData;
+
+    /** Draws the queued placements with a single instanced mesh. */
+    UPROPERTY()
+    TObjectPtr<UInstancedStaticMeshComponent> QueuedPlacementPreview = nullptr;
+
+    /** Maximum amount of queued buildings spawned per frame. */
+    UPROPERTY(EditDefaultsOnly, Category="Build Component|Batch", meta=(ClampMin="1"))
+    int32 MaxSpawnsPerFrame = 4;
+
+    /** Milliseconds per frame queued buildings may be spawned for. At least one is spawned each frame regardless. */
+    UPROPERTY(EditDefaultsOnly, Category="Build Component|Batch", meta=(ClampMin="0.0"))
+    float SpawnFrameBudgetMs = 2.f;
+
+    /** Buildings the player can select. Keeps their assets from being garbage collected between switches. */
+    UPROPERTY()
+    TArray<FSBS_BuildingData> PreloadedBuildingData;
+
+    /**
+     * Buildings whose classes, meshes and materials are streamed in as soon as the component begins play, so that the
+     * first placement of each doesn't load them synchronously.
+     */
+    UPROPERTY(EditDefaultsOnly, Category="Build Component|Streaming")
+    TArray<TObjectPtr<USBS_BuildableData>> BuildableSet;
+
+    /** Keeps the buildable set in memory. */
+    TSharedPtr<FStreamableHandle> BuildableSetHandle = nullptr;
+
+    bool bBuildableSetLoaded = false;
+    double BuildableSetLoadStartSeconds = 0.0;
+
     /** State the build process is on. */
     UPROPERTY(BlueprintReadOnly, Category="Build Component", meta=(AllowPrivateAccess="true"))
     ESBS_BuildState BuildState = ESBS_BuildState::Invalid;
@@ -277,6 +441,45 @@ private:
     UPROPERTY(EditDefaultsOnly, Category="Build Component")
     TArray<TEnumAsByte<ECollisionChannel>> ObjectTypesToQueryOnTraces;
 
+    /**
+     * Settings of the grid buildable cells are cached in. If no ground object types are set, ObjectTypesToQueryOnTraces
+     * are used instead.
+     */
+    UPROPERTY(EditDefaultsOnly, Category="Build Component|Grid")
+    FSBS_BuildGridSettings GridSettings;
+
+    /** Should the building object be placed at cell centers rather than right at the observed point? */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Build Component|Grid", meta=(AllowPrivateAccess="true"))
+    bool bSnapToGrid = false;
+
+    /** Radius around the owner the grid cells are sampled in advance once build mode is enabled. */
+    UPROPERTY(EditDefaultsOnly, Category="Build Component|Grid", meta=(ClampMin="0.0"))
+    float GridPrewarmRadius = 1000.f;
+
+    /**
+     * Material vision cones are drawn with. Expected to be translucent and two sided. The engine default material is
+     * used if it's not set.
+     */
+    UPROPERTY(EditDefaultsOnly, Category="Build Component|Vision")
+    TObjectPtr<UMaterialInterface> VisionConeMaterial = nullptr;
+
+    /** Should vision cones of all the objects built by this component be shown while in build mode? */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Build Component|Vision",
+        meta=(AllowPrivateAccess="true"))
+    bool bShowBuiltVisionCoverage = false;
+
+    /** Draws vision cones of all the built objects with a single mesh. */
+    UPROPERTY()
+    TObjectPtr<USBS_VisionConeComponent> BuiltVisionCoverage = nullptr;
+
+    /** Vision cones of the built objects. The coverage mesh is rebuilt only when they change. */
+    TMap<TWeakObjectPtr<AActor>, FSBS_VisionCone> BuiltVisionCones;
+    bool bBuiltVisionCoverageDirty = false;
+
+    /** Grid buildable cells are cached in. */
+    UPROPERTY()
+    TObjectPtr<USBS_BuildGridSubsystem> BuildGrid = nullptr;
+
     /** Character that owns this component. */
     UPROPERTY(BlueprintReadOnly, Category="Build Component", meta=(AllowPrivateAccess="true"))
     TObjectPtr<ACharacter> Owner = nullptr;
@@ -291,4 +494,22 @@ private:
 
     UPROPERTY(BlueprintReadWrite, Category="Build Component", meta=(AllowPrivateAccess="true"))
     float GhostActorYaw = 0.f;
+
+    /** Is the build ghost actor overlapping with anything? */
+    bool bGhostOverlapping = false;
+
+    /** Does the build grid allow placing the building where the ghost is? */
+    bool bGridAllowsPlacement = true;
+
+    /** Whether the ghost has been moved at least once since it has been created. */
+    bool bGhostPlaced = false;
+
+    /** Camera transform and yaw the ghost has last been moved with. Nothing is traced if they haven't changed. */
+    FTransform LastCameraTransform = FTransform::Identity;
+    float LastGhostActorYaw = 0.f;
 };
+
+inline int32 USBS_BuildComponent::GetQueuedPlacementCount() const
+{
+    return PlacementQueue.Num();
+}
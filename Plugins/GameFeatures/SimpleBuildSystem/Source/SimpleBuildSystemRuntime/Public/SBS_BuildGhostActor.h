@@ -6,6 +6,7 @@
 #include "SBS_BuildGhostActor.generated.h"
 
 class UArrowComponent;
+class USBS_VisionConeComponent;
 
 UCLASS(meta=(ToolTip="The used static meshes must stand right on the grid."))
 class SIMPLEBUILDSYSTEMRUNTIME_API ASBS_BuildGhostActor : public AActor
@@ -19,16 +20,37 @@ public:
 public:
     ASBS_BuildGhostActor();
 
-    virtual void Tick(float DeltaSeconds) override;
-
+    /** Swap the mesh, and notify about the overlap state the new mesh is in. */
     void SetStaticMesh(UStaticMesh *Mesh);
     void SetMaterial(UMaterialInterface *MaterialInterface);
 
+    /** Show or hide the ghost. A hidden ghost has no collision, so that it can be kept around between builds. */
+    void SetGhostActive(bool bActive);
+
+    /**
+     * Query the actors the mesh is overlapping with right now, and broadcast whether building is allowed. Doesn't
+     * depend on the order begin/end overlap events come in.
+     */
+    void RefreshOverlaps();
+
     void SetDrawVision(bool Flag);
     void SetVision(float Range, float Degrees);
+    void SetVisionMaterial(UMaterialInterface *MaterialInterface);
 
     float GetOffsetZ() const;
 
+    /** Height of the vision cone, which matches the height of the mesh. */
+    float GetVisionHeight() const;
+
+    /** World transform the vision cone is drawn at. */
+    FTransform GetVisionTransform() const;
+
+    /** World transform of the ghost mesh. */
+    FTransform GetMeshTransform() const;
+
+    /** World space bounds of the ghost mesh, used to find the grid cells the building would stand on. */
+    FBox GetFootprintBounds() const;
+
 protected:
     virtual void BeginPlay() override;
 
@@ -49,7 +71,9 @@ private:
         UPrimitiveComponent *OtherComp,
         int32 OtherBodyIndex);
 
-    void DrawVision();
+    /** Rebuild the vision cone if it's drawn. Does nothing if neither vision nor mesh height has changed. */
+    void UpdateVisionCone();
+
     float GetMeshHeight() const;
 
 public:
@@ -68,10 +92,17 @@ private:
     UPROPERTY(VisibleAnywhere, Category="Components")
     TObjectPtr<UStaticMeshComponent> StaticMesh = nullptr;
 
+    /** Visualizes the area the building will see. Follows the static mesh. */
+    UPROPERTY(VisibleAnywhere, Category="Components")
+    TObjectPtr<USBS_VisionConeComponent> VisionCone = nullptr;
+
     /** The actors the Build Ghost Actor is overlapping with. */
     UPROPERTY()
     TArray<TObjectPtr<AActor>> OverlappingActors;
 
+    /** Whether overlap events are caused by RefreshOverlaps, which broadcasts the result itself. */
+    bool bRefreshingOverlaps = false;
+
     /** Units the Build Ghost Actor will be howering above the ground. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Build Ghost Actor",
         Config, meta=(AllowPrivateAccess="true"))
@@ -82,14 +113,7 @@ private:
     float VisionDegrees = 0.f;
 };
 
-inline void ASBS_BuildGhostActor::SetDrawVision(bool Flag)
-{
-    bDrawVision = Flag;
-    SetActorTickEnabled(bDrawVision);
-}
-
-inline void ASBS_BuildGhostActor::SetVision(float Range, float Degrees)
+inline float ASBS_BuildGhostActor::GetVisionHeight() const
 {
-    VisionRange = Range;
-    VisionDegrees = Degrees;
+    return GetMeshHeight();
 }
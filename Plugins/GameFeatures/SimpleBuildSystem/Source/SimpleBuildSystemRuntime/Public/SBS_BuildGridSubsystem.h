@@ -0,0 +1,357 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SimpleBuildSystemRuntime/sbs.h"
+
+#include "SBS_BuildGridSubsystem.generated.h"
+
+/** Rules the build grid samples and validates cells with. */
+USTRUCT(BlueprintType)
+struct FSBS_BuildGridSettings
+{
+    GENERATED_BODY()
+
+public:
+    bool operator==(const FSBS_BuildGridSettings &Other) const;
+    bool operator!=(const FSBS_BuildGridSettings &Other) const;
+
+public:
+    /** Length of a cell side in units. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="1.0"))
+    float CellSize = 50.f;
+
+    /** Maximum slope in degrees a building can be placed on. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="0.0", ClampMax="90.0"))
+    float MaxSlopeDegrees = 35.f;
+
+    /** Maximum ground height difference between the cells a single building stands on. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="0.0"))
+    float MaxHeightDifference = 50.f;
+
+    /**
+     * Vertical distance between a queried point and the cached ground of its cell after which the cell is sampled
+     * again. Lets the grid handle several floors above each other.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="0.0"))
+    float LayerTolerance = 150.f;
+
+    /** Length of the trace done downwards to find the ground of a cell. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="1.0"))
+    float TraceLength = 1000.f;
+
+    /** Amount of cells sampled per frame while prewarming an area. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="1"))
+    int32 PrewarmCellsPerFrame = 32;
+
+    /** Object types a building can be placed on. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    TArray<TEnumAsByte<ECollisionChannel>> GroundObjectTypes;
+
+    /**
+     * Object types that make a cell unbuildable, e.g. already placed objects or areas that must stay free. Such cells
+     * are considered impassable by the path check as well.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    TArray<TEnumAsByte<ECollisionChannel>> OccupancyObjectTypes;
+
+    /**
+     * Actors paths start at, e.g. enemy spawners. Placements that would cut any of the path targets off of them are
+     * rejected. The check is disabled if either this or PathTargetClasses is empty.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Path Check")
+    TArray<TSubclassOf<AActor>> PathSourceClasses;
+
+    /** Actors that must stay reachable from the path sources, e.g. the objects the enemies are going to attack. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Path Check")
+    TArray<TSubclassOf<AActor>> PathTargetClasses;
+
+    /** Units the area paths are searched in extends beyond the path sources and targets. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Path Check", meta=(ClampMin="0.0"))
+    float PathSearchMargin = 1000.f;
+
+    /** Maximum ground height difference between two neighbouring cells for a path to go through them. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Path Check", meta=(ClampMin="0.0"))
+    float MaxPathStepHeight = 45.f;
+
+    /**
+     * Maximum slope in degrees a path can go through. Kept apart from MaxSlopeDegrees, since characters may walk where
+     * nothing can be built. Should match the walkable floor angle of the characters taking the paths.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Path Check", meta=(ClampMin="0.0", ClampMax="90.0"))
+    float MaxPathSlopeDegrees = 44.765f;
+
+    /**
+     * Maximum amount of cells a single path search may sample. Cells that haven't been sampled, e.g. because the
+     * prewarm hasn't reached them yet, are considered passable once the budget is spent.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Path Check", meta=(ClampMin="0"))
+    int32 MaxPathCellsSampledPerSearch = 1024;
+
+    /**
+     * Seconds navigation updates caused by placed objects are gathered for before being applied at once, so that
+     * navmesh tiles shared by them are rebuilt a single time. Zero applies them right away.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Navigation", meta=(ClampMin="0.0"))
+    float NavigationUpdateDelay = 0.25f;
+};
+
+/** Cached data of a single grid cell. */
+struct FSBS_BuildGridCell
+{
+    /** Height of the ground at the cell center. Valid only if bHasGround is true. */
+    float GroundZ = 0.f;
+
+    FVector Normal = FVector::UpVector;
+
+    bool bHasGround = false;
+
+    /** Whether any of the occupancy object types has been found on the cell when it has been sampled. */
+    bool bBlocked = false;
+
+    /** Whether the ground is flat enough to build on. */
+    bool bWalkable = false;
+
+    /** Whether the cell itself allows building. Doesn't account for objects placed through the build grid. */
+    bool IsBuildable() const;
+
+    /** Whether a path can go through the cell, given the minimal Z of a normal characters can walk on. */
+    bool IsPassable(float MinNormalZ) const;
+};
+
+/**
+ * World subsystem that caches buildable cells of a uniform 2D grid: ground height, normal, and occupancy.
+ *
+ * Cells are sampled lazily the first time they are queried (or in advance, time-sliced, using PrewarmArea()) and are
+ * updated incrementally when objects are placed or removed, so that moving a build ghost around is a cache lookup
+ * rather than a set of traces.
+ */
+UCLASS()
+class SIMPLEBUILDSYSTEMRUNTIME_API USBS_BuildGridSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USBS_BuildGridSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickable() const override;
+    //~End of FTickableGameObject Interface
+
+    /** Use the given settings. Sampled cells are forgotten if they differ from the current ones. */
+    void Configure(const FSBS_BuildGridSettings &InSettings);
+
+    /** Actors ignored by ground and occupancy queries, such as build ghosts or the builders themselves. */
+    void AddIgnoredActor(const AActor *Actor);
+    void RemoveIgnoredActor(const AActor *Actor);
+
+    FIntPoint LocationToCell(const FVector &Location) const;
+    FVector CellToLocation(const FIntPoint &Cell, float Z = 0.f) const;
+
+    /**
+     * Find the cell the location is in, sampling it if it hasn't been done yet or if the cached ground is on
+     * another floor.
+     */
+    const FSBS_BuildGridCell &FindOrSampleCell(const FVector &Location);
+
+    /** Find the cell the location is in if it has been sampled on the location's floor already. */
+    const FSBS_BuildGridCell *FindCachedCell(const FVector &Location) const;
+
+    /** Sample cells around the location in advance, spread over several frames. */
+    void PrewarmArea(const FVector &Center, float Radius);
+
+    /**
+     * Check whether every cell the box covers is buildable and roughly on the same height.
+     * @param  Bounds			World space box of the object to place.
+     * @param  ReferenceZ		Height cells are sampled relatively to if they are not in the cache yet.
+     */
+    bool IsAreaBuildable(const FBox &Bounds, float ReferenceZ);
+
+    /** Whether any object placed through the build grid stands on the cell. */
+    bool IsCellOccupied(const FIntPoint &CellIndex) const;
+
+    /** Mark cells the box covers as occupied by the actor. Cells are freed once the actor is destroyed. */
+    void AddOccupant(AActor *Actor, const FBox &Bounds);
+    void RemoveOccupant(AActor *Actor);
+
+    /**
+     * Mark cells the box covers as occupied by an object that is going to be placed, so that other placements are
+     * validated against it.
+     * @return Handle to release the reservation with.
+     */
+    int32 ReserveArea(const FBox &Bounds);
+    void ReleaseReservedArea(int32 Handle);
+
+    /** Forget the cells the box covers, so that they are sampled again next time they are queried. */
+    void InvalidateArea(const FBox &Bounds);
+
+    /** Forget all the cells. */
+    void InvalidateAll();
+
+    /**
+     * Find the path sources and targets defined by the settings in the world. Done on Configure(), should be called
+     * again if any of them has been added or moved since.
+     */
+    void GatherPathEndpoints();
+
+    /**
+     * Check whether placing an object on the box would cut any path target off of the path sources. Only targets that
+     * are reachable without the object are taken into account. Paths are searched over the grid cells, hence the test
+     * is coarse but doesn't depend on the navmesh being rebuilt.
+     */
+    bool WouldBlockPaths(const FBox &Bounds);
+
+    /**
+     * Keep the actor from affecting navigation until the next batched navigation update. Must be called before the
+     * actor has finished spawning.
+     */
+    void DeferNavigationUpdate(AActor *Actor);
+
+    /** Let all the deferred actors affect navigation right away. */
+    void FlushNavigationUpdates();
+
+    /**
+     * Defer navigation updates of every placed actor until unlocked, regardless of the delay, so that a batch of
+     * placements spread over several frames results in a single navigation update.
+     */
+    void LockNavigationUpdates();
+
+    /** Undo a lock. Deferred updates are flushed once the last lock is removed. */
+    void UnlockNavigationUpdates();
+
+    const FSBS_BuildGridSettings &GetSettings() const;
+
+private:
+    FSBS_BuildGridCell &SampleCell(const FIntPoint &CellIndex, float ReferenceZ);
+    void GetCellsInBox(const FBox &Bounds, TArray<FIntPoint> &OutCells) const;
+    void AddOccupiedCells(const FBox &Bounds, int32 Delta);
+
+    /**
+     * Flood the path region from the path sources.
+     * @param  BlockedCells		Cells considered impassable besides the unbuildable ones.
+     * @param  bBaseline		If true, remember the reached targets, and the cells the found paths go through.
+     * @return True if every target reachable at the baseline has been reached.
+     */
+    bool SearchPaths(const FIntRect &BlockedCells, bool bBaseline);
+
+    /** Check whether a path can go from a cell with the given height to the given one. */
+    bool IsPathCellPassable(const FIntPoint &CellIndex, int32 PathIndex, float FromZ, const FIntRect &BlockedCells,
+        float &OutGroundZ);
+
+    void InvalidatePaths();
+
+    int32 CellToPathIndex(const FIntPoint &CellIndex) const;
+    FIntPoint PathIndexToCell(int32 PathIndex) const;
+
+    UFUNCTION()
+    void OnOccupantDestroyed(AActor *Actor);
+
+private:
+    FSBS_BuildGridSettings Settings;
+
+    FCollisionObjectQueryParams GroundQueryParams;
+    FCollisionObjectQueryParams OccupancyQueryParams;
+    FCollisionQueryParams QueryParams;
+
+    TArray<TWeakObjectPtr<const AActor>> IgnoredActors;
+
+    TMap<FIntPoint, FSBS_BuildGridCell> Cells;
+
+    /** Bounds of each of the placed objects. */
+    TMap<TWeakObjectPtr<AActor>, FBox> Occupants;
+
+    /** Bounds of the objects that are going to be placed. */
+    TMap<int32, FBox> ReservedAreas;
+    int32 NextReservationHandle = 0;
+
+    /**
+     * Amount of placed and reserved objects standing on each cell. Kept apart from the sampled cells, so that
+     * forgetting a cell doesn't free it.
+     */
+    TMap<FIntPoint, int32> OccupiedCells;
+
+    /** Cells waiting to be sampled by the prewarm, along with their reference height. */
+    TArray<TPair<FIntPoint, float>> PendingPrewarm;
+
+    /** Cells paths are searched in. Max is exclusive. */
+    FIntRect PathRegion;
+
+    TArray<FBox> PathSourceBounds;
+    TArray<FBox> PathTargetBounds;
+
+    /** Path indices of the cells the sources stand on, along with the heights of the sources. */
+    TArray<int32> PathSourceCells;
+    TArray<float> PathSourceZ;
+
+    /** Index of the target each path cell belongs to, if any. */
+    TArray<int32> PathTargetOfCell;
+
+    /** Cells the sources and targets stand on. They are always considered passable. */
+    TBitArray<> PathEndpointCells;
+
+    /** Cells the paths found by the baseline search go through. Placing anything off them can't cut any path. */
+    TBitArray<> BaselinePathCells;
+
+    /** Targets reachable with nothing else placed. Only those are required to stay reachable. */
+    TBitArray<> ReachableTargets;
+    bool bPathBaselineValid = false;
+
+    /** Minimal Z of a normal a path can go through, derived from MaxPathSlopeDegrees. */
+    float PathMinNormalZ = 0.f;
+
+    /** Cells the running path search may still sample. */
+    int32 PathSamplesLeft = 0;
+
+    /** Footprint the last path check has been done for, along with its result. */
+    FIntRect LastPathCheckFootprint;
+    bool bLastPathCheckResult = false;
+    bool bLastPathCheckValid = false;
+
+    /** Components that have been kept from affecting navigation until the next batched update. */
+    TArray<TWeakObjectPtr<UActorComponent>> PendingNavigationComponents;
+    float NavigationUpdateTimeRemaining = 0.f;
+    int32 NavigationUpdateLocks = 0;
+};
+
+inline bool FSBS_BuildGridCell::IsBuildable() const
+{
+    return ((bHasGround) && (bWalkable) && (!bBlocked));
+}
+
+inline bool FSBS_BuildGridCell::IsPassable(float MinNormalZ) const
+{
+    return ((bHasGround) && (!bBlocked) && (Normal.Z >= MinNormalZ));
+}
+
+inline bool USBS_BuildGridSubsystem::IsTickable() const
+{
+    return ((!PendingPrewarm.IsEmpty()) || (!PendingNavigationComponents.IsEmpty()));
+}
+
+inline bool USBS_BuildGridSubsystem::IsCellOccupied(const FIntPoint &CellIndex) const
+{
+    return OccupiedCells.Contains(CellIndex);
+}
+
+inline const FSBS_BuildGridSettings &USBS_BuildGridSubsystem::GetSettings() const
+{
+    return Settings;
+}
+
+inline int32 USBS_BuildGridSubsystem::CellToPathIndex(const FIntPoint &CellIndex) const
+{
+    return (CellIndex.Y - PathRegion.Min.Y) * PathRegion.Width() + (CellIndex.X - PathRegion.Min.X);
+}
+
+inline FIntPoint USBS_BuildGridSubsystem::PathIndexToCell(int32 PathIndex) const
+{
+    const int32 Width = PathRegion.Width();
+    return FIntPoint(PathRegion.Min.X + PathIndex % Width, PathRegion.Min.Y + PathIndex / Width);
+}
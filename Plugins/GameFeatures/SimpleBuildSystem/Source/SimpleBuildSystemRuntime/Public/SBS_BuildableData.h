@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SBS_BuildComponent.h"
+
+#include "SBS_BuildableData.generated.h"
+
+/**
+ * Soft-referenced definition of a building the player can select. Build components stream the referenced assets in
+ * ahead of time instead of loading them on placement.
+ */
+UCLASS(BlueprintType, Const, meta=(ShortTooltip="Data asset used to define a building object."))
+class SIMPLEBUILDSYSTEMRUNTIME_API USBS_BuildableData : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Whether all the referenced assets are in memory. */
+    UFUNCTION(BlueprintPure, Category="Buildable Data")
+    bool IsLoaded() const;
+
+    /** Add the paths of the referenced assets that have to be streamed in. */
+    void GetAssetPaths(TArray<FSoftObjectPath> &OutPaths) const;
+
+    /**
+     * Resolve the soft references into building data the build component works with.
+     * @return Invalid building data if any of the assets hasn't been loaded yet.
+     */
+    UFUNCTION(BlueprintPure, Category="Buildable Data")
+    FSBS_BuildingData ToBuildingData() const;
+
+public:
+    /** The object that will be built at the end. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    TSoftClassPtr<AActor> ObjectClass = nullptr;
+
+    /** The static mesh used by the ghost building actor. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    TSoftObjectPtr<UStaticMesh> StaticMesh = nullptr;
+
+    /** The material used by the ghost building actor when it's allowed to build. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    TSoftObjectPtr<UMaterialInterface> AllowMaterial = nullptr;
+
+    /** The material used by the ghost building actor when it's forbid to build. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    TSoftObjectPtr<UMaterialInterface> ForbidMaterial = nullptr;
+
+    /** Build duration in seconds. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="0.0"))
+    float Duration = 0.f;
+
+    /** Should vision be drawn in front of building actor? */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    bool bDrawVision = false;
+
+    /** Units the building can see. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="0.0"))
+    float VisionRange = 0.f;
+
+    /** Degrees the building can see. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(ClampMin="0.0", ClampMax="360.0"))
+    float VisionDegrees = 0.f;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "SimpleBuildSystemRuntime/sbs.h"
+
+#include "SBS_VisionConeComponent.generated.h"
+
+/** Shape and placement of a single vision cone. */
+struct FSBS_VisionCone
+{
+    /** Transform of the cone origin. The cone faces the X axis. */
+    FTransform Transform = FTransform::Identity;
+
+    float Range = 0.f;
+    float Degrees = 0.f;
+    float Height = 0.f;
+
+    bool operator==(const FSBS_VisionCone &Other) const;
+};
+
+/**
+ * Procedural mesh that visualizes vision cones. Geometry is rebuilt only when the cones change, moving the cones is
+ * done by moving the component.
+ *
+ * A single cone is built in the component space. Several cones are merged into a single mesh section in the world
+ * space, hence any amount of them is drawn at once. Winding isn't guaranteed to face the camera, hence the material is
+ * expected to be two sided.
+ */
+UCLASS(ClassGroup="Rendering", meta=(BlueprintSpawnableComponent))
+class SIMPLEBUILDSYSTEMRUNTIME_API USBS_VisionConeComponent : public UProceduralMeshComponent
+{
+    GENERATED_BODY()
+
+public:
+    USBS_VisionConeComponent(const FObjectInitializer &ObjectInitializer);
+
+    /** Build a single cone in the component space. Nothing is done if the cone hasn't changed. */
+    void SetCone(float Range, float Degrees, float Height);
+
+    /** Build all the given cones in the world space. The component is detached from its parent transform. */
+    void SetCones(const TArray<FSBS_VisionCone> &Cones);
+
+    void ClearCones();
+
+private:
+    static void AppendCone(const FSBS_VisionCone &Cone, int32 Segments, TArray<FVector> &Vertices,
+        TArray<int32> &Triangles);
+
+    void UpdateMeshSection(const TArray<FVector> &Vertices, const TArray<int32> &Triangles);
+
+private:
+    /** Amount of segments the front arc of a cone consists of. */
+    UPROPERTY(EditDefaultsOnly, Category="Vision Cone", meta=(ClampMin="1"))
+    int32 ArcSegments = 24;
+
+    /** The single cone that has been built last, if any. */
+    FSBS_VisionCone BuiltCone;
+    bool bHasSingleCone = false;
+};
+
+inline bool FSBS_VisionCone::operator==(const FSBS_VisionCone &Other) const
+{
+    return ((Range == Other.Range) && (Degrees == Other.Degrees) && (Height == Other.Height) &&
+        (Transform.Equals(Other.Transform)));
+}
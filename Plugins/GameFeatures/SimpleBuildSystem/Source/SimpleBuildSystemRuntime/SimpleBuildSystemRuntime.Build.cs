@@ -23,6 +23,7 @@ public class SimpleBuildSystemRuntime : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[]
 		{
 			"Core", 
+			"ProceduralMeshComponent",
 			// ... add other public dependencies that you statically link with here ...
 		});
 			
@@ -0,0 +1,5 @@
+#pragma once
+
+DECLARE_LOG_CATEGORY_CLASS(LogSimpleBuildSystem, All, All);
+
+DECLARE_STATS_GROUP(TEXT("SimpleBuildSystem"), STATGROUP_SimpleBuildSystem, STATCAT_Advanced);
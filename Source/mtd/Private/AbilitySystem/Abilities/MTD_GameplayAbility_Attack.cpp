@@ -1,9 +1,10 @@
 #include "AbilitySystem/Abilities/MTD_GameplayAbility_Attack.h"
 
-#include "AbilitySystem/Effects/MTD_GameplayEffect_Attack.h"
 #include "AbilitySystem/MTD_AbilitySystemComponent.h"
 #include "AbilitySystem/MTD_GameplayTags.h"
 #include "Character/MTD_BaseCharacter.h"
+#include "Character/MTD_ComboComponent.h"
+#include "Character/MTD_PawnExtensionComponent.h"
 #include "GameplayTagsManager.h"
 
 UMTD_GameplayAbility_Attack::UMTD_GameplayAbility_Attack()
@@ -33,11 +34,12 @@ void UMTD_GameplayAbility_Attack::ActivateAbility(
 
     const auto MtdAsc = CastChecked<UMTD_AbilitySystemComponent>(ActorInfo->AbilitySystemComponent.Get());
 
-    int32 AttackEffectLevel;
-    HandleAttackGameplayEffect(MtdAsc, AttackEffectLevel);
+    const auto Character = CastChecked<AMTD_BaseCharacter>(ActorInfo->AvatarActor.Get());
 
-    UAnimMontage *AnimMontage = GetRandomAbilityAnimMontage();
-    PlayAttackAnimation(CastChecked<AMTD_BaseCharacter>(ActorInfo->AvatarActor.Get()), AnimMontage);
+    const int32 ComboIndex = HandleCombo(MtdAsc, Character->GetComboComponent());
+
+    UAnimMontage *AnimMontage = GetAttackAnimMontage(ComboIndex);
+    PlayAttackAnimation(Character, AnimMontage);
 
     FTimerHandle EndAbilityTimerHandle;
     const float RemainingCooldownTime = GetCooldownTimeRemaining();
@@ -61,59 +63,45 @@ void UMTD_GameplayAbility_Attack::EndAbility(
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 }
 
-void UMTD_GameplayAbility_Attack::HandleAttackGameplayEffect(
-    UMTD_AbilitySystemComponent *MtdAsc, int32 &OutAttackEffectLevel) const
+float UMTD_GameplayAbility_Attack::GetComboDamageMultiplier() const
 {
-    // Check if we have an active attack GE
-    const FActiveGameplayEffectHandle AttackHandle = GetFirstActiveAttackGameplayEffect(MtdAsc);
+    const UMTD_ComboComponent *ComboComponent =
+        UMTD_ComboComponent::FindComboComponent(GetActorInfo().AvatarActor.Get());
+    return (IsValid(ComboComponent)) ? (ComboComponent->GetComboDamageMultiplier()) : (1.f);
+}
 
-    OutAttackEffectLevel = 0;
-    if (!AttackHandle.IsValid())
+int32 UMTD_GameplayAbility_Attack::HandleCombo(
+    UMTD_AbilitySystemComponent *MtdAsc, UMTD_ComboComponent *ComboComponent) const
+{
+    if (!IsValid(ComboComponent))
     {
-        CreateAndApplyAttackGameplayEffectOnSelf(MtdAsc);
+        MTDS_WARN("Avatar actor has no combo component, attacks won't be combined.");
+        return 0;
     }
-    else
-    {
-        // Increase GE level by one and reset its duration
-        // ReSharper disable once CppExpressionWithoutSideEffects
-        MtdAsc->IncreaseGameplayEffectLevelHandle(AttackHandle, 1.f);
-        MtdAsc->SetGameplayEffectDurationHandle(AttackHandle, AttackGeDuration);
 
-        CancelPreviousAttack(MtdAsc);
+    const bool bContinuesCombo = ComboComponent->IsComboActive();
+    const int32 ComboIndex = ComboComponent->AdvanceCombo(AttackGeDuration);
 
-        const FActiveGameplayEffect *AttackGe = MtdAsc->GetActiveGameplayEffect(AttackHandle);
-        OutAttackEffectLevel = static_cast<int32>(AttackGe->Spec.GetLevel());
+    if (bContinuesCombo)
+    {
+        CancelPreviousAttack(MtdAsc);
     }
+
+    return ComboIndex;
 }
 
-FActiveGameplayEffectHandle UMTD_GameplayAbility_Attack::GetFirstActiveAttackGameplayEffect(
-    const UMTD_AbilitySystemComponent *MtdAsc) const
+UAnimMontage *UMTD_GameplayAbility_Attack::GetAttackAnimMontage(int32 ComboIndex) const
 {
-    FGameplayEffectQuery GeQuery;
-    GeQuery.EffectDefinition = UMTD_GameplayEffect_Attack::StaticClass();
-    TArray<FActiveGameplayEffectHandle> ActiveGeHandles = MtdAsc->GetActiveEffects(GeQuery);
-
-    if (ActiveGeHandles.Num() > 1)
+    if (!bPlayMontagesInComboOrder)
     {
-        MTDS_WARN("Ability system [%s] has more than one UMTD_GameplayEffect_Attack. "
-            "Only the first will be considered.", *MtdAsc->GetName());
+        return GetRandomAbilityAnimMontage();
     }
 
-    return !ActiveGeHandles.IsEmpty() ? ActiveGeHandles[0] : FActiveGameplayEffectHandle();
-}
+    const AActor *AvatarActor = GetActorInfo().AvatarActor.Get();
+    const auto PawnExtComponent = UMTD_PawnExtensionComponent::FindPawnExtensionComponent(AvatarActor);
+    check(PawnExtComponent);
 
-int32 UMTD_GameplayAbility_Attack::GetAttackMontageIndexToPlay(
-    const TArray<UAnimMontage *> Animations, int32 AttackEffectLevel) const
-{
-    const int32 Size = Animations.Num();
-    return (Size != 0) ? (AttackEffectLevel % Size) : (-1);
-}
-
-UAnimMontage *UMTD_GameplayAbility_Attack::GetAbilityAnimMontage(
-    TArray<UAnimMontage *> Animations, int32 AttackEffectLevel) const
-{
-    const int32 AttackMontageIndex = GetAttackMontageIndexToPlay(Animations, AttackEffectLevel);
-    return (AttackMontageIndex != -1) ? (Animations[AttackMontageIndex]) : (nullptr);
+    return PawnExtComponent->GetComboAnimMontage(GetMainAbilityTag(), ComboIndex);
 }
 
 void UMTD_GameplayAbility_Attack::CancelPreviousAttack(UMTD_AbilitySystemComponent *MtdAsc) const
@@ -123,15 +111,6 @@ void UMTD_GameplayAbility_Attack::CancelPreviousAttack(UMTD_AbilitySystemCompone
     MtdAsc->CancelAbilities(&AbilityTypesToCancel, nullptr, nullptr);
 }
 
-void UMTD_GameplayAbility_Attack::CreateAndApplyAttackGameplayEffectOnSelf(UMTD_AbilitySystemComponent *MtdAsc) const
-{
-    const FGameplayEffectSpecHandle SpecHandle =
-        MtdAsc->MakeOutgoingSpec(UMTD_GameplayEffect_Attack::StaticClass(), 1.f, MtdAsc->MakeEffectContext());
-
-    const FActiveGameplayEffectHandle EffectHandle = MtdAsc->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
-    MtdAsc->SetGameplayEffectDurationHandle(EffectHandle, AttackGeDuration);
-}
-
 void UMTD_GameplayAbility_Attack::PlayAttackAnimation(const ACharacter *PlayOn, UAnimMontage *AbilityAnimMontage)
 {
     UAnimInstance *AnimInstance = PlayOn->GetMesh()->GetAnimInstance();
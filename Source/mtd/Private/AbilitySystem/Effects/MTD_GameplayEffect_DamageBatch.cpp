@@ -0,0 +1,66 @@
+#include "AbilitySystem/Effects/MTD_GameplayEffect_DamageBatch.h"
+
+#include "AbilitySystem/MTD_GameplayTags.h"
+#include "AbilitySystem/Attributes/MTD_BalanceSet.h"
+#include "AbilitySystem/Attributes/MTD_CombatSet.h"
+#include "AbilitySystem/Attributes/MTD_HealthSet.h"
+
+static FGameplayModifierInfo GetSetByCallerModInfo(
+    const FGameplayAttribute &Attribute,
+    const FGameplayTag &Tag,
+    EGameplayModOp::Type ModOp)
+{
+    FSetByCallerFloat SetByCaller;
+    SetByCaller.DataTag = Tag;
+
+    FGameplayModifierInfo ModInfo;
+    ModInfo.Attribute = Attribute;
+    ModInfo.ModifierOp = ModOp;
+    ModInfo.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+
+    return ModInfo;
+}
+
+UMTD_GameplayEffect_DamageBatch::UMTD_GameplayEffect_DamageBatch()
+{
+    DurationPolicy = EGameplayEffectDurationType::Instant;
+
+    const FMTD_GameplayTags &Tags = FMTD_GameplayTags::Get();
+
+    Modifiers.Add(GetSetByCallerModInfo(
+        UMTD_CombatSet::GetLastReceivedDamage_MetaAttribute(),
+        Tags.SetByCaller_Damage_Batched,
+        EGameplayModOp::Override));
+
+    Modifiers.Add(GetSetByCallerModInfo(
+        UMTD_HealthSet::GetHealthAttribute(),
+        Tags.SetByCaller_Health_Batched,
+        EGameplayModOp::Additive));
+}
+
+UMTD_GameplayEffect_BalanceDamageBatch::UMTD_GameplayEffect_BalanceDamageBatch()
+{
+    const FMTD_GameplayTags &Tags = FMTD_GameplayTags::Get();
+
+    // Balance set reads the knockback direction once the balance damage is applied, hence it goes first
+    Modifiers.Add(GetSetByCallerModInfo(
+        UMTD_BalanceSet::GetKnockbackDirectionX_MetaAttribute(),
+        Tags.SetByCaller_KnockbackDirectionX,
+        EGameplayModOp::Override));
+
+    Modifiers.Add(GetSetByCallerModInfo(
+        UMTD_BalanceSet::GetKnockbackDirectionY_MetaAttribute(),
+        Tags.SetByCaller_KnockbackDirectionY,
+        EGameplayModOp::Override));
+
+    Modifiers.Add(GetSetByCallerModInfo(
+        UMTD_BalanceSet::GetKnockbackDirectionZ_MetaAttribute(),
+        Tags.SetByCaller_KnockbackDirectionZ,
+        EGameplayModOp::Override));
+
+    // Knockback is decided per hit, hence the strongest hit of the frame is what matters
+    Modifiers.Add(GetSetByCallerModInfo(
+        UMTD_BalanceSet::GetLastReceivedBalanceDamage_MetaAttribute(),
+        Tags.SetByCaller_BalanceDamage_Batched,
+        EGameplayModOp::Override));
+}
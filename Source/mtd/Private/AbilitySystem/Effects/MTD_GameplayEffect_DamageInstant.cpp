@@ -27,7 +27,7 @@ FGameplayEffectExecutionScopedModifierInfo GetExecScopedModInfo(const FGameplayA
 FGameplayEffectExecutionDefinition GetDamageExecutionDefinition(
     TSubclassOf<UGameplayEffectExecutionCalculation> GeExecutionCalculation)
 {
-    const FMTD_GameplayTags Tags = FMTD_GameplayTags::Get();
+    const FMTD_GameplayTags &Tags = FMTD_GameplayTags::Get();
 
     FGameplayEffectExecutionDefinition ExecDef;
     ExecDef.CalculationClass = GeExecutionCalculation;
@@ -34,7 +34,6 @@ void UMTD_BalanceDamageExecution::Execute_Implementation(
     const FGameplayEffectCustomExecutionParameters &ExecParams,
     FGameplayEffectCustomExecutionOutput &ExecOutput) const
 {
-    const FMTD_GameplayTags Tags = FMTD_GameplayTags::Get();
     const FGameplayEffectSpec &Spec = ExecParams.GetOwningSpec();
 
     const FGameplayTagContainer *TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
@@ -45,7 +45,7 @@ void UMTD_DamageExecution::Execute_Implementation(
     const FGameplayEffectCustomExecutionParameters &ExecParams,
     FGameplayEffectCustomExecutionOutput &ExecOutput) const
 {
-    const FMTD_GameplayTags Tags = FMTD_GameplayTags::Get();
+    const FMTD_GameplayTags &Tags = FMTD_GameplayTags::Get();
     const FGameplayEffectSpec &Spec = ExecParams.GetOwningSpec();
 
     const FGameplayTagContainer *TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
@@ -63,13 +63,10 @@ void UMTD_DamageExecution::Execute_Implementation(
     float DamageMultiplier = Spec.GetSetByCallerMagnitude(Tags.SetByCaller_Damage_Multiplier);
 
     float DamageStat = 0.f;
-    const bool bDamageStatFound = ExecParams.AttemptCalculateCapturedAttributeMagnitude(
+    ExecParams.AttemptCalculateCapturedAttributeMagnitude(
         DamageStatics().DamageStatDef, EvaluationParams, DamageStat);
 
-    // TODO: const float DamageMultiplier = SomeSmartMathFunction(DamageStat);
-    const float DamageDone =
-        (DamageBase + DamageAdditive) * DamageMultiplier *
-        ((bDamageStatFound) ? (1.f) /* the math function(DamageStat) */ : (1.f));
+    const float DamageDone = ComputeDamageDone(DamageBase, DamageAdditive, DamageMultiplier, DamageStat);
 
     ExecOutput.AddOutputModifier(FGameplayModifierEvaluatedData(
         UMTD_CombatSet::GetLastReceivedDamage_MetaAttribute(),
@@ -81,3 +78,67 @@ void UMTD_DamageExecution::Execute_Implementation(
         EGameplayModOp::Additive,
         -DamageDone));
 }
+
+float UMTD_DamageExecution::ComputeDamageDone(
+    float DamageBase,
+    float DamageAdditive,
+    float DamageMultiplier,
+    float DamageStat)
+{
+    // TODO: const float DamageMultiplier = SomeSmartMathFunction(DamageStat);
+    return (DamageBase + DamageAdditive) * DamageMultiplier * 1.f /* the math function(DamageStat) */;
+}
+
+bool UMTD_DamageExecution::GetSpecSourceDamage(
+    const FGameplayEffectSpec &Spec,
+    const FGameplayTagContainer *TargetTags,
+    float &OutDamageBase,
+    float &OutDamageStat)
+{
+    const UGameplayEffect *Def = Spec.Def;
+    if ((!IsValid(Def)) || (Def->DurationPolicy != EGameplayEffectDurationType::Instant) ||
+        (!Def->Modifiers.IsEmpty()) || (Def->Executions.Num() != 1) || (!Def->ConditionalGameplayEffects.IsEmpty()))
+    {
+        return false;
+    }
+
+    const FGameplayEffectExecutionDefinition &ExecDef = Def->Executions[0];
+    if ((!ExecDef.CalculationClass) || (!ExecDef.CalculationClass->IsChildOf(StaticClass())) ||
+        (!ExecDef.ConditionalGameplayEffects.IsEmpty()))
+    {
+        return false;
+    }
+
+    // Scoped modifiers on the attributes read would have to be aggregated the same way the execution does
+    for (const FGameplayEffectExecutionScopedModifierInfo &ModInfo : ExecDef.CalculationModifiers)
+    {
+        if ((ModInfo.CapturedAttribute == DamageStatics().BaseDamage_MetaDef) ||
+            (ModInfo.CapturedAttribute == DamageStatics().DamageStatDef))
+        {
+            return false;
+        }
+    }
+
+    FAggregatorEvaluateParameters EvaluationParams;
+    EvaluationParams.TargetTags = TargetTags;
+    EvaluationParams.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+
+    // Source attributes are snapshot, hence they have been captured when the spec was made
+    OutDamageBase = 0.f;
+    const FGameplayEffectAttributeCaptureSpec *BaseDamageSpec =
+        Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(DamageStatics().BaseDamage_MetaDef, true);
+    if (BaseDamageSpec)
+    {
+        BaseDamageSpec->AttemptCalculateAttributeMagnitude(EvaluationParams, OutDamageBase);
+    }
+
+    OutDamageStat = 0.f;
+    const FGameplayEffectAttributeCaptureSpec *DamageStatSpec =
+        Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(DamageStatics().DamageStatDef, true);
+    if (DamageStatSpec)
+    {
+        DamageStatSpec->AttemptCalculateAttributeMagnitude(EvaluationParams, OutDamageStat);
+    }
+
+    return true;
+}
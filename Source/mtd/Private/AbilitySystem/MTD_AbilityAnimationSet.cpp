@@ -10,3 +10,8 @@ FMTD_AbilityAnimations UMTD_AbilityAnimationSet::GetAbilityAnimMontages(FGamepla
     const FMTD_AbilityAnimations *Found = AbilityAnimations.Find(AbilityTag);
     return (Found) ? (*Found) : (FMTD_AbilityAnimations());
 }
+
+const FMTD_AbilityAnimations *UMTD_AbilityAnimationSet::FindAbilityAnimMontages(const FGameplayTag &AbilityTag) const
+{
+    return (AbilityTag.IsValid()) ? (AbilityAnimations.Find(AbilityTag)) : (nullptr);
+}
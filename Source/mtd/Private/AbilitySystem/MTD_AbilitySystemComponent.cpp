@@ -1,19 +1,31 @@
 #include "AbilitySystem/MTD_AbilitySystemComponent.h"
 
 #include "AbilitySystem/Abilities/MTD_GameplayAbility.h"
+#include "AbilitySystem/Abilities/MTD_GameplayAbility_Jump.h"
+#include "AbilitySystem/Attributes/MTD_BalanceSet.h"
+#include "AbilitySystem/Attributes/MTD_HealthSet.h"
+#include "AbilitySystem/Attributes/MTD_ManaSet.h"
+#include "AbilitySystem/MTD_DamageSubsystem.h"
+#include "AbilitySystem/MTD_GameplayTags.h"
+#include "AbilitySystemGlobals.h"
+
+DECLARE_CYCLE_STAT(TEXT("Process Ability Input"), STAT_MtdProcessAbilityInput, STATGROUP_Mtd);
+DECLARE_CYCLE_STAT(TEXT("Ability Index Rebuild"), STAT_MtdAbilityIndexRebuild, STATGROUP_Mtd);
+DECLARE_CYCLE_STAT(TEXT("Attribute Initialization"), STAT_MtdAttributeInit, STATGROUP_Mtd);
 
 void UMTD_AbilitySystemComponent::ProcessAbilityInput(float DeltaSeconds, bool bGamePaused)
 {
+    SCOPE_CYCLE_COUNTER(STAT_MtdProcessAbilityInput);
+
     // TODO: Clear ability input if paused
     // ...
 
-    static TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
-    AbilitiesToActivate.Reset();
+    FSpecHandleSet AbilitiesToActivate;
 
     // Process held input
     for (const FGameplayAbilitySpecHandle &SpecHandle : InputHeldSpecHandles)
     {
-        const FGameplayAbilitySpec *Spec = FindAbilitySpecFromHandle(SpecHandle);
+        const FGameplayAbilitySpec *Spec = FindIndexedAbilitySpec(SpecHandle);
         if ((!Spec) || (!Spec->Ability) || (Spec->IsActive()))
         {
             continue;
@@ -30,7 +42,7 @@ void UMTD_AbilitySystemComponent::ProcessAbilityInput(float DeltaSeconds, bool b
     // Process triggered input
     for (const FGameplayAbilitySpecHandle &SpecHandle : InputPressedSpecHandles)
     {
-        FGameplayAbilitySpec *Spec = FindAbilitySpecFromHandle(SpecHandle);
+        FGameplayAbilitySpec *Spec = FindIndexedAbilitySpec(SpecHandle);
         if ((!Spec) || (!Spec->Ability))
         {
             continue;
@@ -64,7 +76,7 @@ void UMTD_AbilitySystemComponent::ProcessAbilityInput(float DeltaSeconds, bool b
 
     for (const FGameplayAbilitySpecHandle &SpecHandle : InputReleasedSpecHandles)
     {
-        FGameplayAbilitySpec *Spec = FindAbilitySpecFromHandle(SpecHandle);
+        FGameplayAbilitySpec *Spec = FindIndexedAbilitySpec(SpecHandle);
         if ((!Spec) || (!Spec->Ability))
         {
             continue;
@@ -84,111 +96,435 @@ void UMTD_AbilitySystemComponent::ProcessAbilityInput(float DeltaSeconds, bool b
     InputReleasedSpecHandles.Reset();
 }
 
-bool UMTD_AbilitySystemComponent::SetGameplayEffectDurationHandle(FActiveGameplayEffectHandle Handle, float NewDuration)
+void UMTD_AbilitySystemComponent::OnAbilityInputTagPressed(const FGameplayTag &InputTag)
 {
-    if (!Handle.IsValid())
+    if (!InputTag.IsValid())
+    {
+        return;
+    }
+
+    const auto SpecHandles = FindInputTagSpecHandles(InputTag);
+    if (!SpecHandles)
     {
-        return false;
+        return;
     }
 
-    const FActiveGameplayEffect *ConstActiveGe = GetActiveGameplayEffect(Handle);
-    if (!ConstActiveGe)
+    for (const FGameplayAbilitySpecHandle &SpecHandle : *SpecHandles)
     {
-        return false;
+        InputPressedSpecHandles.AddUnique(SpecHandle);
+        InputHeldSpecHandles.AddUnique(SpecHandle);
     }
+}
 
-    FActiveGameplayEffect *ActiveGe = const_cast<FActiveGameplayEffect *>(ConstActiveGe);
-    if (NewDuration > 0.f)
+void UMTD_AbilitySystemComponent::OnAbilityInputTagReleased(const FGameplayTag &InputTag)
+{
+    if (!InputTag.IsValid())
     {
-        ActiveGe->Spec.Duration = NewDuration;
+        return;
     }
-    else
+
+    const auto SpecHandles = FindInputTagSpecHandles(InputTag);
+    if (!SpecHandles)
     {
-        ActiveGe->Spec.Duration = 0.01f;
+        return;
     }
 
-    ActiveGe->StartServerWorldTime = ActiveGameplayEffects.GetServerWorldTime();
-    ActiveGe->CachedStartServerWorldTime = ActiveGe->StartServerWorldTime;
-    ActiveGe->StartWorldTime = ActiveGameplayEffects.GetWorldTime();
-    ActiveGameplayEffects.MarkItemDirty(*ActiveGe);
-    ActiveGameplayEffects.CheckDuration(Handle);
+    for (const FGameplayAbilitySpecHandle &SpecHandle : *SpecHandles)
+    {
+        InputReleasedSpecHandles.AddUnique(SpecHandle);
+        InputHeldSpecHandles.RemoveSingleSwap(SpecHandle, false);
+    }
+}
 
-    ActiveGe->EventSet.OnTimeChanged.Broadcast(ActiveGe->Handle, ActiveGe->StartWorldTime, ActiveGe->GetDuration());
-    OnGameplayEffectDurationChange(*ActiveGe);
+void UMTD_AbilitySystemComponent::GiveTagToAbility(const FGameplayTag &Tag, UMTD_GameplayAbility *Ability)
+{
+    check(Ability);
 
-    return true;
+    for (FGameplayAbilitySpec &AbilitySpec : ActivatableAbilities.Items)
+    {
+        const auto OtherAbility = Cast<UMTD_GameplayAbility>(AbilitySpec.Ability);
+        
+        if ((IsValid(OtherAbility)) && (OtherAbility->GetMainAbilityTag() == Ability->GetMainAbilityTag()))
+        {
+            AbilitySpec.DynamicAbilityTags.AddTag(Tag);
+            bAbilityIndexDirty = true;
+            break;
+        }
+    }
 }
 
-bool UMTD_AbilitySystemComponent::IncreaseGameplayEffectLevelHandle(
-    FActiveGameplayEffectHandle Handle, float IncreaseBy) const
+FGameplayAbilitySpec *UMTD_AbilitySystemComponent::FindIndexedAbilitySpec(const FGameplayAbilitySpecHandle &Handle)
 {
-    if (!Handle.IsValid())
+    UpdateAbilityIndex();
+
+    const int32 *Index = AbilitySpecIndices.Find(Handle);
+    if ((Index) && (ActivatableAbilities.Items.IsValidIndex(*Index)))
     {
-        return false;
+        FGameplayAbilitySpec &Spec = ActivatableAbilities.Items[*Index];
+
+        // Specs may have been moved by something that hasn't marked the index dirty
+        if (Spec.Handle == Handle)
+        {
+            return &Spec;
+        }
     }
 
-    const FActiveGameplayEffect *ConstActiveGe = GetActiveGameplayEffect(Handle);
-    if (!ConstActiveGe)
+    bAbilityIndexDirty = true;
+    return FindAbilitySpecFromHandle(Handle);
+}
+
+FActiveGameplayEffectHandle UMTD_AbilitySystemComponent::ApplyGameplayEffectSpecToTarget(
+    const FGameplayEffectSpec &GameplayEffect,
+    UAbilitySystemComponent *Target,
+    FPredictionKey PredictionKey)
+{
+    // Batches are only resolved on the server
+    UMTD_DamageSubsystem *DamageSubsystem =
+        (IsOwnerActorAuthoritative()) ? (UMTD_DamageSubsystem::Get(this)) : (nullptr);
+    if ((IsValid(DamageSubsystem)) && (DamageSubsystem->QueueDamageSpec(GameplayEffect, Target)))
     {
-        return false;
+        // Same handle an executed instant gameplay effect gets
+        return FActiveGameplayEffectHandle(INDEX_NONE);
     }
 
-    FActiveGameplayEffect *ActiveGe = const_cast<FActiveGameplayEffect *>(ConstActiveGe);
+    return Super::ApplyGameplayEffectSpecToTarget(GameplayEffect, Target, PredictionKey);
+}
 
-    const float OldLevel = ActiveGe->Spec.GetLevel();
-    const float NewLevel = OldLevel + IncreaseBy;
+void UMTD_AbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec &AbilitySpec)
+{
+    Super::OnGiveAbility(AbilitySpec);
 
-    ActiveGe->Spec.SetLevel(NewLevel);
+    bAbilityIndexDirty = true;
+}
+
+void UMTD_AbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec &AbilitySpec)
+{
+    Super::OnRemoveAbility(AbilitySpec);
 
-    return true;
+    bAbilityIndexDirty = true;
 }
 
-void UMTD_AbilitySystemComponent::OnAbilityInputTagPressed(const FGameplayTag &InputTag)
+void UMTD_AbilitySystemComponent::OnRep_ActivateAbilities()
 {
-    if (!InputTag.IsValid())
+    Super::OnRep_ActivateAbilities();
+
+    bAbilityIndexDirty = true;
+}
+
+void UMTD_AbilitySystemComponent::UpdateAbilityIndex()
+{
+    if (!bAbilityIndexDirty)
     {
         return;
     }
 
-    for (const FGameplayAbilitySpec &AbilitySpec : ActivatableAbilities.Items)
+    SCOPE_CYCLE_COUNTER(STAT_MtdAbilityIndexRebuild);
+
+    bAbilityIndexDirty = false;
+    InputTagSpecHandles.Reset();
+    AbilitySpecIndices.Reset();
+
+    for (int32 i = 0; i < ActivatableAbilities.Items.Num(); i++)
     {
-        if ((IsValid(AbilitySpec.Ability)) && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
+        const FGameplayAbilitySpec &AbilitySpec = ActivatableAbilities.Items[i];
+        AbilitySpecIndices.Add(AbilitySpec.Handle, i);
+
+        if (!IsValid(AbilitySpec.Ability))
+        {
+            continue;
+        }
+
+        // Input tags are given as dynamic tags
+        for (const FGameplayTag &Tag : AbilitySpec.DynamicAbilityTags)
         {
-            InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-            InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+            InputTagSpecHandles.FindOrAdd(Tag).Add(AbilitySpec.Handle);
         }
     }
 }
 
-void UMTD_AbilitySystemComponent::OnAbilityInputTagReleased(const FGameplayTag &InputTag)
+const UMTD_AbilitySystemComponent::FInputSpecHandles *UMTD_AbilitySystemComponent::FindInputTagSpecHandles(
+    const FGameplayTag &InputTag)
 {
-    if (!InputTag.IsValid())
+    UpdateAbilityIndex();
+
+    return InputTagSpecHandles.Find(InputTag);
+}
+
+void UMTD_AbilitySystemComponent::InitializeAttributeValues(TConstArrayView<FMTD_AttributeInitValue> Values)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MtdAttributeInit);
+
+    // Aggregators keep base values on their own, so only attributes nothing has touched yet are written directly
+    const bool bWriteDirectly = ((!bAttributesInitialized) && (ActiveGameplayEffects.GetNumGameplayEffects() == 0));
+    bAttributesInitialized = true;
+
+    if (!bWriteDirectly)
     {
+        for (const FMTD_AttributeInitValue &InitValue : Values)
+        {
+            ApplyModToAttribute(InitValue.Attribute, EGameplayModOp::Override, InitValue.Value);
+        }
         return;
     }
 
-    for (const FGameplayAbilitySpec &AbilitySpec : ActivatableAbilities.Items)
+    WriteAttributeValues(Values);
+    OnAttributesInitializedDelegate.Broadcast(AttributeInitChanges);
+}
+
+void UMTD_AbilitySystemComponent::WriteAttributeValues(TConstArrayView<FMTD_AttributeInitValue> Values)
+{
+    AttributeInitChanges.Reset();
+    for (const FMTD_AttributeInitValue &InitValue : Values)
     {
-        if ((IsValid(AbilitySpec.Ability)) && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
+        UAttributeSet *AttributeSet = FindAttributeSet(InitValue.Attribute);
+        FGameplayAttributeData *Data =
+            (IsValid(AttributeSet)) ? (InitValue.Attribute.GetGameplayAttributeData(AttributeSet)) : (nullptr);
+
+        if (!Data)
         {
-            InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
-            InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+            MTDS_WARN("Attribute [%s] is not a part of any attribute set of [%s].",
+                *InitValue.Attribute.GetName(), *GetNameSafe(GetOwner()));
+            continue;
         }
+
+        // Clamp the values the way attribute sets do when they are changed through the ability system
+        float BaseValue = InitValue.Value;
+        AttributeSet->PreAttributeBaseChange(InitValue.Attribute, BaseValue);
+
+        float NewValue = BaseValue;
+        AttributeSet->PreAttributeChange(InitValue.Attribute, NewValue);
+
+        const float OldValue = Data->GetCurrentValue();
+        Data->SetBaseValue(BaseValue);
+        Data->SetCurrentValue(NewValue);
+
+        AttributeSet->PostAttributeChange(InitValue.Attribute, OldValue, NewValue);
+
+        FMTD_AttributeInitChange &Change = AttributeInitChanges.AddDefaulted_GetRef();
+        Change.Attribute = InitValue.Attribute;
+        Change.OldValue = OldValue;
+        Change.NewValue = NewValue;
     }
 }
 
-void UMTD_AbilitySystemComponent::GiveTagToAbility(const FGameplayTag &Tag, UMTD_GameplayAbility *Ability)
+UAttributeSet *UMTD_AbilitySystemComponent::FindAttributeSet(const FGameplayAttribute &Attribute) const
 {
-    check(Ability);
+    const UClass *AttributeSetClass = Attribute.GetAttributeSetClass();
+    for (UAttributeSet *AttributeSet : GetSpawnedAttributes())
+    {
+        if ((IsValid(AttributeSet)) && (AttributeSet->IsA(AttributeSetClass)))
+        {
+            return AttributeSet;
+        }
+    }
 
-    for (FGameplayAbilitySpec &AbilitySpec : ActivatableAbilities.Items)
+    return nullptr;
+}
+
+#if !UE_BUILD_SHIPPING
+void UMTD_AbilitySystemComponent::RunAbilityInputBenchmark(int32 Frames)
+{
+    UpdateAbilityIndex();
+
+    TArray<FGameplayTag> InputTags;
+    InputTagSpecHandles.GenerateKeyArray(InputTags);
+
+    // Handles are only routed, they aren't processed, hence no ability is activated
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 Frame = 0; Frame < Frames; Frame++)
     {
-        const auto OtherAbility = Cast<UMTD_GameplayAbility>(AbilitySpec.Ability);
-        
-        if ((IsValid(OtherAbility)) && (OtherAbility->GetMainAbilityTag() == Ability->GetMainAbilityTag()))
+        for (const FGameplayTag &InputTag : InputTags)
         {
-            AbilitySpec.DynamicAbilityTags.AddTag(Tag);
-            break;
+            OnAbilityInputTagPressed(InputTag);
+            OnAbilityInputTagReleased(InputTag);
+        }
+
+        for (const FGameplayAbilitySpecHandle &SpecHandle : InputReleasedSpecHandles)
+        {
+            FindIndexedAbilitySpec(SpecHandle);
         }
+
+        InputPressedSpecHandles.Reset();
+        InputReleasedSpecHandles.Reset();
+    }
+
+    const double TotalSeconds = FPlatformTime::Seconds() - StartSeconds;
+    MTD_LOG("%d frames of %d input tags over %d abilities: %.3f us per frame.",
+        Frames, InputTags.Num(), ActivatableAbilities.Items.Num(), TotalSeconds * 1000000.0 / FMath::Max(Frames, 1));
+}
+
+/**
+ * Spawn an actor owning ability system components nothing else uses, so that benchmarks don't touch the ones of the
+ * characters in the world. The actor is expected to be destroyed once the benchmark is done.
+ */
+static AActor *SpawnScratchAbilitySystems(UWorld *World, int32 Count, TArray<UMTD_AbilitySystemComponent*> &OutAscs)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+
+    AActor *Actor = World->SpawnActor<AActor>(SpawnParams);
+    if (!IsValid(Actor))
+    {
+        return nullptr;
     }
+
+    OutAscs.Reset(Count);
+    for (int32 i = 0; i < Count; i++)
+    {
+        auto Asc = NewObject<UMTD_AbilitySystemComponent>(Actor, NAME_None, RF_Transient);
+        Asc->RegisterComponent();
+        Asc->InitAbilityActorInfo(Actor, Actor);
+        OutAscs.Add(Asc);
+    }
+
+    return Actor;
 }
+
+static FAutoConsoleCommandWithWorldAndArgs AbilityInputBenchmarkCommand(
+    TEXT("mtd.AbilityInputBenchmark"),
+    TEXT("Route input of abilities granted to a scratch ability system, spread over the native input tags. "
+        "Usage: mtd.AbilityInputBenchmark [Frames=1000] [Abilities=50]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        if (!IsValid(World))
+        {
+            return;
+        }
+
+        const int32 Frames = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (1000);
+        const int32 AbilityCount = (Args.IsValidIndex(1)) ? (FCString::Atoi(*Args[1])) : (50);
+
+        TArray<UMTD_AbilitySystemComponent*> Ascs;
+        AActor *ScratchActor = SpawnScratchAbilitySystems(World, 1, Ascs);
+        if (!IsValid(ScratchActor))
+        {
+            MTD_WARN("Failed to spawn a scratch ability system.");
+            return;
+        }
+
+        const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+        const FGameplayTag InputTags[] =
+        {
+            GameplayTags.InputTag_Attack,
+            GameplayTags.InputTag_AlternativeAttack,
+            GameplayTags.InputTag_Move,
+            GameplayTags.InputTag_Look_Mouse,
+            GameplayTags.InputTag_Look_Stick,
+            GameplayTags.InputTag_AutoRun,
+        };
+
+        // Abilities are only routed, never activated, hence any ability class does
+        UMTD_AbilitySystemComponent *Asc = Ascs[0];
+        for (int32 i = 0; i < AbilityCount; i++)
+        {
+            FGameplayAbilitySpec AbilitySpec(UMTD_GameplayAbility_Jump::StaticClass(), 1);
+            AbilitySpec.DynamicAbilityTags.AddTag(InputTags[i % UE_ARRAY_COUNT(InputTags)]);
+            Asc->GiveAbility(AbilitySpec);
+        }
+
+        Asc->RunAbilityInputBenchmark(Frames);
+
+        ScratchActor->Destroy();
+    }));
+
+void UMTD_AbilitySystemComponent::RunAttributeInitBenchmark(UWorld *World, int32 Spawns)
+{
+    Spawns = FMath::Max(Spawns, 1);
+
+    // Every spawn gets an ability system of its own, the same as a spawned character does, hence batched spawns pass
+    // the same guard they do in game. Half of them are initialized batched, the other half per attribute
+    TArray<UMTD_AbilitySystemComponent*> Ascs;
+    AActor *ScratchActor = SpawnScratchAbilitySystems(World, Spawns * 2, Ascs);
+    if (!IsValid(ScratchActor))
+    {
+        MTD_WARN("Failed to spawn scratch ability systems.");
+        return;
+    }
+
+    for (UMTD_AbilitySystemComponent *Asc : Ascs)
+    {
+        Asc->InitStats(UMTD_HealthSet::StaticClass(), nullptr);
+        Asc->InitStats(UMTD_ManaSet::StaticClass(), nullptr);
+        Asc->InitStats(UMTD_BalanceSet::StaticClass(), nullptr);
+    }
+
+    const FGameplayAttribute Attributes[] =
+    {
+        UMTD_HealthSet::GetMaxHealthAttribute(),
+        UMTD_HealthSet::GetHealthAttribute(),
+        UMTD_ManaSet::GetMaxManaAttribute(),
+        UMTD_ManaSet::GetManaAttribute(),
+        UMTD_BalanceSet::GetDamageAttribute(),
+        UMTD_BalanceSet::GetThresholdAttribute(),
+        UMTD_BalanceSet::GetResistAttribute(),
+    };
+
+    // A bit more than the defaults, so that every spawn changes every attribute
+    TArray<FMTD_AttributeInitValue> InitValues;
+    for (const FGameplayAttribute &Attribute : Attributes)
+    {
+        InitValues.Add({ Attribute, Ascs[0]->GetNumericAttributeBase(Attribute) + 1.f });
+    }
+
+    int32 AttributeBroadcasts = 0;
+    int32 InitializedBroadcasts = 0;
+    for (UMTD_AbilitySystemComponent *Asc : Ascs)
+    {
+        for (const FMTD_AttributeInitValue &InitValue : InitValues)
+        {
+            Asc->GetGameplayAttributeValueChangeDelegate(InitValue.Attribute).AddLambda(
+                [&AttributeBroadcasts](const FOnAttributeChangeData &ChangeData)
+                {
+                    AttributeBroadcasts++;
+                });
+        }
+
+        Asc->OnAttributesInitializedDelegate.AddLambda(
+            [&InitializedBroadcasts](TConstArrayView<FMTD_AttributeInitChange> Changes)
+            {
+                InitializedBroadcasts++;
+            });
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Spawns; i++)
+    {
+        Ascs[i]->InitializeAttributeValues(InitValues);
+    }
+    const double BatchedEndSeconds = FPlatformTime::Seconds();
+    const int32 BatchedBroadcasts = AttributeBroadcasts + InitializedBroadcasts;
+
+    AttributeBroadcasts = 0;
+    InitializedBroadcasts = 0;
+    for (int32 i = Spawns; i < Ascs.Num(); i++)
+    {
+        for (const FMTD_AttributeInitValue &InitValue : InitValues)
+        {
+            Ascs[i]->ApplyModToAttribute(InitValue.Attribute, EGameplayModOp::Override, InitValue.Value);
+        }
+    }
+    const double PerAttributeEndSeconds = FPlatformTime::Seconds();
+    const int32 PerAttributeBroadcasts = AttributeBroadcasts + InitializedBroadcasts;
+
+    ScratchActor->Destroy();
+
+    MTD_LOG("%d spawns of %d attributes: %.3f us and %d broadcasts per attribute, %.3f us and %d broadcasts batched.",
+        Spawns, InitValues.Num(), (PerAttributeEndSeconds - BatchedEndSeconds) * 1000000.0 / Spawns,
+        PerAttributeBroadcasts, (BatchedEndSeconds - StartSeconds) * 1000000.0 / Spawns, BatchedBroadcasts);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs AttributeInitBenchmarkCommand(
+    TEXT("mtd.AttributeInitBenchmark"),
+    TEXT("Initialize attributes of scratch ability systems, batched and per attribute. "
+        "Usage: mtd.AttributeInitBenchmark [Spawns=1000]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        if (!IsValid(World))
+        {
+            return;
+        }
+
+        const int32 Spawns = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (1000);
+        UMTD_AbilitySystemComponent::RunAttributeInitBenchmark(World, Spawns);
+    }));
+#endif
@@ -0,0 +1,377 @@
+#include "AbilitySystem/MTD_DamageSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AbilitySystem/MTD_GameplayTags.h"
+#include "AbilitySystem/Attributes/MTD_BalanceSet.h"
+#include "AbilitySystem/Attributes/MTD_CombatSet.h"
+#include "AbilitySystem/Attributes/MTD_HealthSet.h"
+#include "AbilitySystem/Attributes/MTD_PlayerSet.h"
+#include "AbilitySystem/Effects/MTD_GameplayEffect_DamageBatch.h"
+#include "AbilitySystem/Effects/MTD_GameplayEffect_DamageInstant.h"
+#include "AbilitySystem/Executions/MTD_DamageExecution.h"
+#include "EngineUtils.h"
+#include "GameplayCueManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Flush"), STAT_MtdDamageFlush, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Hits"), STAT_MtdDamageHits, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Targets"), STAT_MtdDamageTargets, STATGROUP_Mtd);
+
+UMTD_DamageSubsystem *UMTD_DamageSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<UMTD_DamageSubsystem>()) : (nullptr);
+}
+
+bool UMTD_DamageSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void UMTD_DamageSubsystem::Deinitialize()
+{
+    PendingHits.Empty();
+    ResolvingHits.Empty();
+    TargetBatches.Empty();
+    TargetBatchIndices.Empty();
+
+    Super::Deinitialize();
+}
+
+void UMTD_DamageSubsystem::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    FlushDamage();
+}
+
+TStatId UMTD_DamageSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMTD_DamageSubsystem, STATGROUP_Tickables);
+}
+
+void UMTD_DamageSubsystem::QueueDamage(const FMTD_DamageHit &Hit)
+{
+    if (!IsValid(Hit.Target))
+    {
+        return;
+    }
+
+    FMTD_DamageHit &PendingHit = PendingHits.Add_GetRef(Hit);
+    if ((PendingHit.bCaptureSourceDamage) && (IsValid(PendingHit.Source)))
+    {
+        // Same as the snapshot the damage execution captures, attributes the source doesn't have count as zero
+        const UAbilitySystemComponent *Source = PendingHit.Source;
+        const FGameplayAttribute BaseDamageAttribute = UMTD_CombatSet::GetBaseDamageToUse_MetaAttribute();
+        const FGameplayAttribute DamageStatAttribute = UMTD_PlayerSet::GetDamageStatAttribute();
+
+        PendingHit.DamageBase = (Source->HasAttributeSetForAttribute(BaseDamageAttribute)) ?
+            (Source->GetNumericAttribute(BaseDamageAttribute)) : (0.f);
+        PendingHit.DamageStat = (Source->HasAttributeSetForAttribute(DamageStatAttribute)) ?
+            (Source->GetNumericAttribute(DamageStatAttribute)) : (0.f);
+        PendingHit.bCaptureSourceDamage = false;
+    }
+}
+
+bool UMTD_DamageSubsystem::QueueDamageSpec(const FGameplayEffectSpec &Spec, UAbilitySystemComponent *Target)
+{
+    if ((!IsValid(Target)) || (!IsValid(Spec.Def)))
+    {
+        return false;
+    }
+
+    // Application requirements would have to be checked against the target the same way applying the spec does
+    const UGameplayEffect *Def = Spec.Def;
+    if ((!Def->ApplicationTagRequirements.IsEmpty()) || (!Def->CustomApplicationRequirements.IsEmpty()) ||
+        (Def->ChanceToApplyToTarget.GetValueAtLevel(Spec.GetLevel()) < 1.f))
+    {
+        return false;
+    }
+
+    FMTD_DamageHit Hit;
+    if (!UMTD_DamageExecution::GetSpecSourceDamage(
+        Spec, &Target->GetOwnedGameplayTags(), Hit.DamageBase, Hit.DamageStat))
+    {
+        return false;
+    }
+
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+
+    // Same magnitudes the execution reads
+    Hit.Source = Spec.GetContext().GetInstigatorAbilitySystemComponent();
+    Hit.Target = Target;
+    Hit.DamageAdditive = Spec.GetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Additive);
+    Hit.DamageMultiplier = Spec.GetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Multiplier);
+    Hit.Tags = Spec.DynamicAssetTags;
+    Hit.EffectContext = Spec.GetContext();
+
+    QueueDamage(Hit);
+
+    // Cues are per hit, the batched gameplay effect has none
+    if (!Def->GameplayCues.IsEmpty())
+    {
+        UAbilitySystemGlobals::Get().GetGameplayCueManager()->InvokeGameplayCueExecuted_FromSpec(
+            Target, Spec, FPredictionKey());
+    }
+
+    return true;
+}
+
+bool UMTD_DamageSubsystem::K2_QueueDamageSpec(
+    const FGameplayEffectSpecHandle &SpecHandle,
+    UAbilitySystemComponent *Target)
+{
+    return ((SpecHandle.IsValid()) && (QueueDamageSpec(*SpecHandle.Data, Target)));
+}
+
+void UMTD_DamageSubsystem::FlushDamage()
+{
+    if (PendingHits.IsEmpty())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_MtdDamageFlush);
+
+    // Swap, so that damage dealt in response to this batch (e.g. on death) goes into the next one
+    Swap(PendingHits, ResolvingHits);
+    PendingHits.Reset();
+
+    TargetBatches.Reset();
+    TargetBatchIndices.Reset();
+
+    for (int32 i = 0; i < ResolvingHits.Num(); i++)
+    {
+        const FMTD_DamageHit &Hit = ResolvingHits[i];
+        if (!IsValid(Hit.Target))
+        {
+            continue;
+        }
+
+        int32 &BatchIndex = TargetBatchIndices.FindOrAdd(Hit.Target, INDEX_NONE);
+        if (BatchIndex == INDEX_NONE)
+        {
+            BatchIndex = TargetBatches.AddDefaulted();
+
+            // Read target attributes once per frame instead of capturing them per hit
+            FTargetBatch &NewBatch = TargetBatches[BatchIndex];
+            NewBatch.Target = Hit.Target;
+            NewBatch.Resist = Hit.Target->GetNumericAttribute(UMTD_BalanceSet::GetResistAttribute());
+        }
+
+        FTargetBatch &Batch = TargetBatches[BatchIndex];
+        Batch.Damage += ComputeHitDamage(Hit);
+        Batch.LastHitIndex = i;
+        Batch.Tags.AppendTags(Hit.Tags);
+
+        if (Hit.bBalanceDamage)
+        {
+            // Same as the balance damage execution
+            const float SourceBalanceDamage = (IsValid(Hit.Source)) ?
+                (Hit.Source->GetNumericAttribute(UMTD_BalanceSet::GetDamageAttribute())) : (Hit.BalanceDamage);
+            const float BalanceDamage = SourceBalanceDamage - (SourceBalanceDamage / 100.f) * Batch.Resist;
+
+            // The strongest hit decides whether and where the target is knocked back
+            if ((!Batch.bBalanceDamage) || (BalanceDamage > Batch.BalanceDamage))
+            {
+                Batch.BalanceDamage = BalanceDamage;
+                Batch.KnockbackDirection = Hit.KnockbackDirection;
+            }
+            Batch.bBalanceDamage = true;
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_MtdDamageHits, ResolvingHits.Num());
+    INC_DWORD_STAT_BY(STAT_MtdDamageTargets, TargetBatches.Num());
+
+    for (const FTargetBatch &Batch : TargetBatches)
+    {
+        ApplyBatch(Batch, ResolvingHits[Batch.LastHitIndex]);
+    }
+
+    ResolvingHits.Reset();
+}
+
+float UMTD_DamageSubsystem::ComputeHitDamage(const FMTD_DamageHit &Hit)
+{
+    return UMTD_DamageExecution::ComputeDamageDone(
+        Hit.DamageBase, Hit.DamageAdditive, Hit.DamageMultiplier, Hit.DamageStat);
+}
+
+void UMTD_DamageSubsystem::ApplyBatch(const FTargetBatch &Batch, const FMTD_DamageHit &LastHit) const
+{
+    // Target may have been destroyed by a batch applied earlier
+    if (!IsValid(Batch.Target))
+    {
+        return;
+    }
+
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+    const UGameplayEffect *GameplayEffect = (Batch.bBalanceDamage) ?
+        (GetDefault<UMTD_GameplayEffect_BalanceDamageBatch>()) : (GetDefault<UMTD_GameplayEffect_DamageBatch>());
+
+    // The last hit is credited for the whole batch, so that the killing blow instigator is the one notified on death
+    FGameplayEffectContextHandle EffectContext = LastHit.EffectContext;
+    if (!EffectContext.IsValid())
+    {
+        EffectContext = (IsValid(LastHit.Source)) ?
+            (LastHit.Source->MakeEffectContext()) : (Batch.Target->MakeEffectContext());
+    }
+
+    FGameplayEffectSpec Spec(GameplayEffect, EffectContext, 1.f);
+    Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Batched, Batch.Damage);
+    Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Health_Batched, -Batch.Damage);
+    if (Batch.bBalanceDamage)
+    {
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_BalanceDamage_Batched, Batch.BalanceDamage);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionX, Batch.KnockbackDirection.X);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionY, Batch.KnockbackDirection.Y);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionZ, Batch.KnockbackDirection.Z);
+    }
+
+    Spec.AppendDynamicAssetTags(Batch.Tags);
+
+    Batch.Target->ApplyGameplayEffectSpecToSelf(Spec);
+}
+
+#if !UE_BUILD_SHIPPING
+void UMTD_DamageSubsystem::RunDamageBenchmark(int32 HitCount, float Damage)
+{
+    UWorld *World = GetWorld();
+
+    const APlayerController *PlayerController = World->GetFirstPlayerController();
+    const APawn *PlayerPawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+    UAbilitySystemComponent *Source = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PlayerPawn);
+    if (!IsValid(Source))
+    {
+        MTD_WARN("First player has no ability system to deal damage with.");
+        return;
+    }
+
+    TArray<UAbilitySystemComponent*> Targets;
+    for (TActorIterator<APawn> It(World); It; ++It)
+    {
+        UAbilitySystemComponent *Asc = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(*It);
+        if ((*It != PlayerPawn) && (IsValid(Asc)))
+        {
+            Targets.AddUnique(Asc);
+        }
+    }
+
+    if (Targets.IsEmpty())
+    {
+        MTD_WARN("There are no pawns with an ability system to damage.");
+        return;
+    }
+
+    // Damage goes through the additive magnitude, since the base damage is whatever the player has captured
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+    const FGameplayEffectSpecHandle SpecHandle = Source->MakeOutgoingSpec(
+        UMTD_GameplayEffect_DamageInstant::StaticClass(), 1.f, Source->MakeEffectContext());
+    check(SpecHandle.IsValid());
+
+    float DamageBase = 0.f;
+    float DamageStat = 0.f;
+    if (!UMTD_DamageExecution::GetSpecSourceDamage(*SpecHandle.Data, nullptr, DamageBase, DamageStat))
+    {
+        MTD_WARN("Damage gameplay effect spec can't be batched.");
+        return;
+    }
+
+    TArray<FGameplayEffectSpec> Specs;
+    Specs.Reserve(HitCount);
+    for (int32 i = 0; i < HitCount; i++)
+    {
+        FGameplayEffectSpec &Spec = Specs.Emplace_GetRef(*SpecHandle.Data);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Base, 0.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Additive, Damage);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Multiplier, 1.f + (i % 3) * 0.5f);
+    }
+
+    TMap<UAbilitySystemComponent*, float> HealthBefore;
+    const auto RecordHealth = [&HealthBefore, &Targets]()
+    {
+        for (UAbilitySystemComponent *Target : Targets)
+        {
+            HealthBefore.Add(Target, Target->GetNumericAttribute(UMTD_HealthSet::GetHealthAttribute()));
+        }
+    };
+
+    // Health each target has lost, or a negative value if it may have been clamped at zero
+    const auto GatherHealthLost = [&HealthBefore, &Targets](TMap<UAbilitySystemComponent*, float> &OutHealthLost)
+    {
+        for (UAbilitySystemComponent *Target : Targets)
+        {
+            const float Health = Target->GetNumericAttribute(UMTD_HealthSet::GetHealthAttribute());
+            OutHealthLost.Add(Target, (Health > 0.f) ? (HealthBefore.FindChecked(Target) - Health) : (-1.f));
+        }
+    };
+
+    // Per-hit application, the damage execution runs for every hit
+    RecordHealth();
+    const double PerHitStartSeconds = FPlatformTime::Seconds();
+    for (int32 i = 0; i < HitCount; i++)
+    {
+        Targets[i % Targets.Num()]->ApplyGameplayEffectSpecToSelf(Specs[i]);
+    }
+    const double PerHitSeconds = FPlatformTime::Seconds() - PerHitStartSeconds;
+
+    TMap<UAbilitySystemComponent*, float> PerHitHealthLost;
+    GatherHealthLost(PerHitHealthLost);
+
+    // Same specs through the batch
+    RecordHealth();
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 i = 0; i < HitCount; i++)
+    {
+        QueueDamageSpec(Specs[i], Targets[i % Targets.Num()]);
+    }
+
+    const double QueuedSeconds = FPlatformTime::Seconds();
+    FlushDamage();
+    const double FlushedSeconds = FPlatformTime::Seconds();
+
+    TMap<UAbilitySystemComponent*, float> BatchedHealthLost;
+    GatherHealthLost(BatchedHealthLost);
+
+    int32 Mismatches = 0;
+    int32 Clamped = 0;
+    for (UAbilitySystemComponent *Target : Targets)
+    {
+        const float PerHit = PerHitHealthLost.FindChecked(Target);
+        const float Batched = BatchedHealthLost.FindChecked(Target);
+        if ((PerHit < 0.f) || (Batched < 0.f))
+        {
+            Clamped++;
+        }
+        else if (!FMath::IsNearlyEqual(PerHit, Batched, KINDA_SMALL_NUMBER))
+        {
+            Mismatches++;
+        }
+    }
+
+    MTD_LOG("%d hits of %.2f damage on %d targets: %.3f ms per-hit, %.3f ms queueing, %.3f ms resolving, "
+        "%.3f us per batched hit, %d health mismatches, %d targets reached zero health and weren't compared.",
+        HitCount, Damage, Targets.Num(), PerHitSeconds * 1000.0, (QueuedSeconds - StartSeconds) * 1000.0,
+        (FlushedSeconds - QueuedSeconds) * 1000.0,
+        (FlushedSeconds - StartSeconds) * 1000000.0 / FMath::Max(HitCount, 1), Mismatches, Clamped);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs DamageBenchmarkCommand(
+    TEXT("mtd.DamageBenchmark"),
+    TEXT("Deal damage from the first player to every other pawn, per hit and batched. "
+        "Usage: mtd.DamageBenchmark [Hits=5000] [Damage=1]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_DamageSubsystem *DamageSubsystem = UMTD_DamageSubsystem::Get(World);
+        if (!IsValid(DamageSubsystem))
+        {
+            return;
+        }
+
+        const int32 HitCount = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (5000);
+        const float Damage = (Args.IsValidIndex(1)) ? (FCString::Atof(*Args[1])) : (1.f);
+        DamageSubsystem->RunDamageBenchmark(HitCount, Damage);
+    }));
+#endif
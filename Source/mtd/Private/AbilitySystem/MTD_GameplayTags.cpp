@@ -57,6 +57,22 @@ void FMTD_GameplayTags::AddAllTags(UGameplayTagsManager &Manager)
         "SetByCaller tag used by damage gameplay effects.");
     AddTag(SetByCaller_Damage_Multiplier, "SetByCaller.Damage.Multiplier",
         "SetByCaller tag used by damage gameplay effects.");
+    AddTag(SetByCaller_Damage_Batched, "SetByCaller.Damage.Batched",
+        "SetByCaller tag used by the batched damage gameplay effect for the damage dealt this frame.");
+    AddTag(SetByCaller_Health_Batched, "SetByCaller.Health.Batched",
+        "SetByCaller tag used by the batched damage gameplay effect for the health change this frame.");
+    AddTag(SetByCaller_BalanceDamage_Batched, "SetByCaller.BalanceDamage.Batched",
+        "SetByCaller tag used by the batched damage gameplay effect for the strongest balance hit this frame.");
+    AddTag(SetByCaller_Balance_Damage, "SetByCaller.Balance.Damage",
+        "SetByCaller tag used by balance damage gameplay effects.");
+    AddTag(SetByCaller_KnockbackDirectionX, "SetByCaller.KnockbackDirectionX",
+        "SetByCaller tag used by balance damage gameplay effects for the knockback direction.");
+    AddTag(SetByCaller_KnockbackDirectionY, "SetByCaller.KnockbackDirectionY",
+        "SetByCaller tag used by balance damage gameplay effects for the knockback direction.");
+    AddTag(SetByCaller_KnockbackDirectionZ, "SetByCaller.KnockbackDirectionZ",
+        "SetByCaller tag used by balance damage gameplay effects for the knockback direction.");
+
+    AddTag(GameplayCue_DamageInstant, "GameplayCue.DamageInstant", "Cue executed on a target that has been damaged.");
 
     AddTag(Status_Death, "Status.Death", "Target has the death status.");
     AddTag(Status_Death_Dying, "Status.Death.Dying", "Target has begun the death process.");
@@ -113,3 +129,37 @@ FGameplayTag FMTD_GameplayTags::FindTagByString(FString TagString, bool bMatchPa
 
     return Tag;
 }
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand GameplayTagsBenchmarkCommand(
+    TEXT("mtd.GameplayTagsBenchmark"),
+    TEXT("Compare cached native tags against requesting them. Usage: mtd.GameplayTagsBenchmark [Count=100000]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+    {
+        const int32 Count = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (100000);
+        const UGameplayTagsManager &Manager = UGameplayTagsManager::Get();
+        const FName TagName = FMTD_GameplayTags::Get().SetByCaller_Damage_Multiplier.GetTagName();
+
+        // Sum tag hashes, so that the loops can't be optimized out
+        uint32 Checksum = 0;
+
+        double StartSeconds = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Count; i++)
+        {
+            Checksum += GetTypeHash(Manager.RequestGameplayTag(TagName));
+        }
+        const double RequestSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+        StartSeconds = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Count; i++)
+        {
+            const FMTD_GameplayTags &Tags = FMTD_GameplayTags::Get();
+            Checksum += GetTypeHash(Tags.SetByCaller_Damage_Multiplier);
+        }
+        const double CachedSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+        MTD_LOG("%d reads: %.4f us per request by name, %.4f us per cached read (checksum %u).",
+            Count, RequestSeconds * 1000000.0 / FMath::Max(Count, 1), CachedSeconds * 1000000.0 / FMath::Max(Count, 1),
+            Checksum);
+    }));
+#endif
@@ -0,0 +1,180 @@
+#include "Character/MTD_AttributeCurveCache.h"
+
+#include "Engine/CurveTable.h"
+#include "Kismet/DataTableFunctionLibrary.h"
+
+DECLARE_CYCLE_STAT(TEXT("Attribute Curve Bake"), STAT_MtdAttributeCurveBake, STATGROUP_Mtd);
+
+FMTD_AttributeCurveCache::~FMTD_AttributeCurveCache()
+{
+    Reset();
+}
+
+void FMTD_AttributeCurveCache::Bake(UCurveTable *CurveTable)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MtdAttributeCurveBake);
+
+    Reset();
+
+    if (!IsValid(CurveTable))
+    {
+        return;
+    }
+
+    SourceTable = CurveTable;
+
+#if WITH_EDITOR
+    bSourceTableChanged = MakeShared<bool>(false);
+    SourceTableChangedHandle = CurveTable->OnCurveTableChanged().AddLambda([bChanged = bSourceTableChanged]()
+        {
+            *bChanged = true;
+        });
+#endif
+
+    for (const TPair<FName, FRealCurve*> &Row : CurveTable->GetRowMap())
+    {
+        const FRealCurve *Curve = Row.Value;
+        if (!Curve)
+        {
+            continue;
+        }
+
+        float MinTime;
+        float MaxTime;
+        Curve->GetTimeRange(MinTime, MaxTime);
+
+        FBakedAttribute &Attribute = Attributes.AddDefaulted_GetRef();
+        Attribute.Name = Row.Key;
+        Attribute.FirstValue = Values.Num();
+        Attribute.Levels = FMath::Clamp(FMath::CeilToInt(MaxTime) + 1, 1, MaxBakedLevels);
+
+        for (int32 Level = 0; Level < Attribute.Levels; Level++)
+        {
+            Values.Add(Curve->Eval(static_cast<float>(Level)));
+        }
+    }
+}
+
+void FMTD_AttributeCurveCache::Reset()
+{
+#if WITH_EDITOR
+    UCurveTable *CurveTable = SourceTable.Get();
+    if (IsValid(CurveTable))
+    {
+        CurveTable->OnCurveTableChanged().Remove(SourceTableChangedHandle);
+    }
+
+    SourceTableChangedHandle.Reset();
+    bSourceTableChanged.Reset();
+#endif
+
+    SourceTable.Reset();
+    Attributes.Reset();
+    Values.Reset();
+}
+
+bool FMTD_AttributeCurveCache::IsBakedFrom(const UCurveTable *CurveTable) const
+{
+    if ((!IsValid(CurveTable)) || (SourceTable.Get() != CurveTable))
+    {
+        return false;
+    }
+
+#if WITH_EDITOR
+    if ((bSourceTableChanged.IsValid()) && (*bSourceTableChanged))
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+void FMTD_AttributeCurveCache::BakeIfStale(UCurveTable *CurveTable)
+{
+    if (!IsBakedFrom(CurveTable))
+    {
+        Bake(CurveTable);
+    }
+}
+
+int32 FMTD_AttributeCurveCache::FindAttributeIndex(FName AttributeName) const
+{
+    return Attributes.IndexOfByPredicate([AttributeName](const FBakedAttribute &Attribute)
+        {
+            return (Attribute.Name == AttributeName);
+        });
+}
+
+bool FMTD_AttributeCurveCache::Evaluate(FName AttributeName, float Level, float &OutValue) const
+{
+    return Evaluate(FindAttributeIndex(AttributeName), Level, OutValue);
+}
+
+bool FMTD_AttributeCurveCache::Evaluate(int32 AttributeIndex, float Level, float &OutValue) const
+{
+    if (!Attributes.IsValidIndex(AttributeIndex))
+    {
+        return false;
+    }
+
+    const FBakedAttribute &Attribute = Attributes[AttributeIndex];
+    const int32 WholeLevel = FMath::FloorToInt(Level);
+    if ((static_cast<float>(WholeLevel) == Level) && (WholeLevel >= 0) && (WholeLevel < Attribute.Levels))
+    {
+        OutValue = Values[Attribute.FirstValue + WholeLevel];
+        return true;
+    }
+
+    // Levels that haven't been baked are evaluated the way they used to
+    const UCurveTable *CurveTable = SourceTable.Get();
+    const FRealCurve *Curve =
+        (IsValid(CurveTable)) ? (CurveTable->FindCurve(Attribute.Name, FString(), false)) : (nullptr);
+    if (!Curve)
+    {
+        return false;
+    }
+
+    OutValue = Curve->Eval(Level);
+    return true;
+}
+
+#if !UE_BUILD_SHIPPING
+int32 FMTD_AttributeCurveCache::Validate() const
+{
+    UCurveTable *CurveTable = SourceTable.Get();
+    if (!IsValid(CurveTable))
+    {
+        return 0;
+    }
+
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < Attributes.Num(); i++)
+    {
+        const FBakedAttribute &Attribute = Attributes[i];
+
+        // Check a level past the baked ones and a fractional one as well, they go through the fallback
+        for (int32 Level = 0; Level <= Attribute.Levels; Level++)
+        {
+            for (const float TestLevel : { static_cast<float>(Level), Level + 0.5f })
+            {
+                TEnumAsByte<EEvaluateCurveTableResult::Type> Result;
+                float Expected = 0.f;
+                UDataTableFunctionLibrary::EvaluateCurveTableRow(
+                    CurveTable, Attribute.Name, TestLevel, Result, Expected, FString());
+
+                float Actual = 0.f;
+                const bool bFound = Evaluate(i, TestLevel, Actual);
+                if ((bFound != (Result == EEvaluateCurveTableResult::RowFound)) || (Actual != Expected))
+                {
+                    MTD_WARN("Attribute [%s] of [%s] at level [%.1f] is [%f], expected [%f].",
+                        *Attribute.Name.ToString(), *CurveTable->GetName(), TestLevel, Actual, Expected);
+                    Mismatches++;
+                }
+            }
+        }
+    }
+
+    return Mismatches;
+}
+#endif
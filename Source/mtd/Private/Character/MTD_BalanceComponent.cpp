@@ -3,6 +3,7 @@
 #include "AbilitySystem/Attributes/MTD_BalanceSet.h"
 #include "AbilitySystem/MTD_AbilitySystemComponent.h"
 #include "AbilitySystem/MTD_GameplayTags.h"
+#include "CombatSystem/MTD_LiteCombat.h"
 #include "GameplayEffectExtension.h"
 
 UMTD_BalanceComponent::UMTD_BalanceComponent()
@@ -38,12 +39,57 @@ void UMTD_BalanceComponent::InitializeWithAbilitySystem(UMTD_AbilitySystemCompon
     }
 
     BalanceSet->OnBalanceDownDelegate.AddUObject(this, &ThisClass::OnBalanceDown);
+
+    if (!BalanceHitPayload)
+    {
+        BalanceHitPayload = NewObject<UMTD_BalanceHitData>(this);
+    }
 }
 
 void UMTD_BalanceComponent::UninitializeFromAbilitySystem()
 {
     BalanceSet = nullptr;
     AbilitySystemComponent = nullptr;
+    LiteStats = nullptr;
+}
+
+void UMTD_BalanceComponent::InitializeWithLiteStats(const FMTD_LiteCombatStats *InLiteStats)
+{
+    const AActor *Owner = GetOwner();
+    check(Owner);
+
+    if ((AbilitySystemComponent) || (LiteStats))
+    {
+        MTDS_ERROR("Balance component for owner [%s] has already been initilized", *Owner->GetName());
+        return;
+    }
+
+    LiteStats = InLiteStats;
+    if (!LiteStats)
+    {
+        MTDS_ERROR("Cannot initilize balance component for owner [%s] with NULL lite stats", *Owner->GetName());
+    }
+}
+
+void UMTD_BalanceComponent::ApplyLiteBalanceDamage(float BalanceDamage, const FVector &KnockbackDirection)
+{
+    if (!LiteStats)
+    {
+        return;
+    }
+
+    // Same as the balance damage execution and the balance set
+    const float Damage = BalanceDamage - (BalanceDamage / 100.f) * LiteStats->BalanceResist;
+    const float Threshold = LiteStats->BalanceThreshold;
+    if ((Threshold < 0.f) || (Threshold > Damage))
+    {
+        return;
+    }
+
+    LastBalanceHit.BalanceDamage = Damage;
+    LastBalanceHit.KnockbackDirection = KnockbackDirection;
+
+    OnBalanceDownDelegate.Broadcast(LastBalanceHit);
 }
 
 void UMTD_BalanceComponent::OnUnregister()
@@ -64,15 +110,20 @@ void UMTD_BalanceComponent::OnBalanceDown(
         return;
     }
 
-    // Store all knockback related data inside UMTD_BalanceHitData
-    auto HitData = NewObject<UMTD_BalanceHitData>();
-    HitData->BalanceDamage = DamageMagnitude;
-    HitData->KnockbackDirection = {
+    // Store all knockback related data inside FMTD_BalanceHit, and its copy inside the event payload
+    LastBalanceHit.BalanceDamage = DamageMagnitude;
+    LastBalanceHit.KnockbackDirection = {
         BalanceSet->GetKnockbackDirectionX_Meta(),
         BalanceSet->GetKnockbackDirectionY_Meta(),
         BalanceSet->GetKnockbackDirectionZ_Meta()
     };
 
+    if (IsValid(BalanceHitPayload))
+    {
+        BalanceHitPayload->BalanceDamage = LastBalanceHit.BalanceDamage;
+        BalanceHitPayload->KnockbackDirection = LastBalanceHit.KnockbackDirection;
+    }
+
     // Send the "Gameplay.Event.Knockback" gameplay event through the owner's
     // ability system. This can be used to trigger a death gameplay ability.
     FGameplayEventData Payload;
@@ -80,7 +131,7 @@ void UMTD_BalanceComponent::OnBalanceDown(
     Payload.Instigator = DamageInstigator;
     Payload.Target = AbilitySystemComponent->GetAvatarActor();
     Payload.OptionalObject = DamageEffectSpec.Def;
-    Payload.OptionalObject2 = HitData;
+    Payload.OptionalObject2 = BalanceHitPayload;
     Payload.ContextHandle = DamageEffectSpec.GetEffectContext();
     Payload.InstigatorTags = *DamageEffectSpec.CapturedSourceTags.GetAggregatedTags();
     Payload.TargetTags = *DamageEffectSpec.CapturedTargetTags.GetAggregatedTags();
@@ -88,5 +139,5 @@ void UMTD_BalanceComponent::OnBalanceDown(
 
     AbilitySystemComponent->HandleGameplayEvent(Payload.EventTag, &Payload);
 
-    OnBalanceDownDelegate.Broadcast(HitData);
+    OnBalanceDownDelegate.Broadcast(LastBalanceHit);
 }
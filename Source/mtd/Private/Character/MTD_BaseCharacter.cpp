@@ -1,17 +1,25 @@
 #include "Character/MTD_BaseCharacter.h"
 
+#include "AbilitySystem/Attributes/MTD_BalanceSet.h"
+#include "AbilitySystem/Attributes/MTD_CombatSet.h"
+#include "AbilitySystem/Attributes/MTD_PlayerSet.h"
+#include "AbilitySystem/Executions/MTD_DamageExecution.h"
 #include "AbilitySystem/MTD_AbilitySystemComponent.h"
+#include "AbilitySystem/MTD_DamageSubsystem.h"
 #include "AbilitySystem/MTD_GameplayTags.h"
+#include "AbilitySystemGlobals.h"
 #include "Character/MTD_BalanceComponent.h"
+#include "Character/MTD_ComboComponent.h"
 #include "Character/MTD_HealthComponent.h"
 #include "Character/MTD_HeroComponent.h"
 #include "Character/MTD_ManaComponent.h"
 #include "Character/MTD_PawnExtensionComponent.h"
+#include "CombatSystem/MTD_LiteCombat.h"
+#include "CombatSystem/MTD_MeleeTraceSubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Equipment/MTD_EquipmentManagerComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameModes/MTD_GameModeBase.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Player/MTD_PlayerState.h"
 
 AMTD_BaseCharacter::AMTD_BaseCharacter()
@@ -27,6 +35,7 @@ AMTD_BaseCharacter::AMTD_BaseCharacter()
     HealthComponent = CreateDefaultSubobject<UMTD_HealthComponent>(TEXT("MTD Health Component"));
     ManaComponent = CreateDefaultSubobject<UMTD_ManaComponent>(TEXT("MTD Mana Component"));
     BalanceComponent = CreateDefaultSubobject<UMTD_BalanceComponent>(TEXT("MTD Balance Component"));
+    ComboComponent = CreateDefaultSubobject<UMTD_ComboComponent>(TEXT("MTD Combo Component"));
     
     PawnExtentionComponent->OnAbilitySystemInitialized_RegisterAndCall(
         FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::OnAbilitySystemInitialized));
@@ -60,11 +69,14 @@ void AMTD_BaseCharacter::BeginPlay()
         MtdGm->OnGameTerminatedDelegate.AddDynamic(this, &ThisClass::OnGameTerminated);
     }
 
-    ConstructHitboxMap();
+    MeleeObjectQueryParams = FCollisionObjectQueryParams(ObjectTypesToHit);
+    BakeHitboxes();
 }
 
 void AMTD_BaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    SetMeleeInProgress(false);
+
     Super::EndPlay(EndPlayReason);
 }
 
@@ -76,11 +88,6 @@ void AMTD_BaseCharacter::Reset()
 void AMTD_BaseCharacter::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
-
-    if (bIsMeleeInProgress)
-    {
-        PerformHitboxTrace();
-    }
 }
 
 void AMTD_BaseCharacter::NotifyControllerChanged()
@@ -92,34 +99,45 @@ void AMTD_BaseCharacter::NotifyControllerChanged()
 
 void AMTD_BaseCharacter::AddMeleeHitboxes(const TArray<FName> &HitboxNicknames)
 {
+    TArray<uint16, TInlineAllocator<8>> HitboxIds;
     for (const FName &Name : HitboxNicknames)
     {
-        const auto Found = HitboxMap.Find(Name);
-        if (!Found)
-        {
-            continue;
-        }
-        
-        ActiveHitboxes.Add(Found->HitboxInfo);
+        HitboxIds.Add(FMTD_MeleeHitboxIds::Find(Name));
     }
 
-    bIsMeleeInProgress = !ActiveHitboxes.IsEmpty();
+    AddMeleeHitboxesById(HitboxIds);
 }
 
 void AMTD_BaseCharacter::RemoveMeleeHitboxes(const TArray<FName> &HitboxNicknames)
 {
+    TArray<uint16, TInlineAllocator<8>> HitboxIds;
     for (const FName &Name : HitboxNicknames)
     {
-        const auto Found = HitboxMap.Find(Name);
-        if (!Found)
-        {
-            continue;
-        }
+        HitboxIds.Add(FMTD_MeleeHitboxIds::Find(Name));
+    }
 
-        ActiveHitboxes.Remove(Found->HitboxInfo);
+    RemoveMeleeHitboxesById(HitboxIds);
+}
+
+void AMTD_BaseCharacter::AddMeleeHitboxesById(TConstArrayView<uint16> HitboxIds)
+{
+    const uint64 Mask = GetHitboxMask(HitboxIds);
+
+    // Hitboxes that have just been activated start their sweep where they are now
+    for (uint64 NewMask = (Mask & ~ActiveHitboxMask); NewMask != 0; NewMask &= (NewMask - 1))
+    {
+        Hitboxes[FMath::CountTrailingZeros64(NewMask)].bHasPreviousLocation = false;
     }
 
-    bIsMeleeInProgress = !ActiveHitboxes.IsEmpty();
+    ActiveHitboxMask |= Mask;
+    SetMeleeInProgress(ActiveHitboxMask != 0);
+}
+
+void AMTD_BaseCharacter::RemoveMeleeHitboxesById(TConstArrayView<uint16> HitboxIds)
+{
+    ActiveHitboxMask &= ~GetHitboxMask(HitboxIds);
+
+    SetMeleeInProgress(ActiveHitboxMask != 0);
     if (!bIsMeleeInProgress)
     {
         ResetMeleeHitTargets();
@@ -128,9 +146,9 @@ void AMTD_BaseCharacter::RemoveMeleeHitboxes(const TArray<FName> &HitboxNickname
 
 void AMTD_BaseCharacter::DisableMeleeHitboxes()
 {
-    ActiveHitboxes.Empty();
+    ActiveHitboxMask = 0;
     ResetMeleeHitTargets();
-    bIsMeleeInProgress = false;
+    SetMeleeInProgress(false);
 }
 
 void AMTD_BaseCharacter::ResetMeleeHitTargets()
@@ -156,32 +174,77 @@ float AMTD_BaseCharacter::GetMovementDirectionAngle() const
     return (Cross.IsZero()) ? (Degrees) : (Degrees * FMath::Sign(Cross.Z));
 }
 
-void AMTD_BaseCharacter::PerformHitboxTrace()
+#if !UE_BUILD_SHIPPING
+void AMTD_BaseCharacter::RunHitboxNotifyBenchmark(int32 Iterations)
 {
-    ensure(bIsMeleeInProgress);
-    
-    const UWorld *World = GetWorld();
-    const FVector ActorLocation = GetActorLocation();
-    const FVector Forward = GetActorForwardVector();
-    const FRotator ForwardRot = Forward.Rotation();
+    Iterations = FMath::Max(Iterations, 1);
 
-    const EDrawDebugTrace::Type DrawDebugTrace =
-        (bDebugMelee) ? (EDrawDebugTrace::ForDuration) : (EDrawDebugTrace::None);
+    // Notify begin and end with every hitbox of the character
+    TArray<FName> Nicknames;
+    TArray<uint16> HitboxIds;
+    for (const FMTD_ActiveHitboxEntry &HitboxEntry : Hitboxes)
+    {
+        Nicknames.Add(HitboxEntry.HitboxInfo.Nickname);
+        HitboxIds.Add(FMTD_MeleeHitboxIds::Find(HitboxEntry.HitboxInfo.Nickname));
+    }
 
-    for (const FMTD_MeleeHitSphereDefinition &HitboxEntry : ActiveHitboxes)
+    if (Nicknames.IsEmpty())
     {
-        const FVector Offset = ForwardRot.RotateVector(HitboxEntry.Offset);
-        const FVector TraceLocation = ActorLocation + Offset;
+        MTD_WARN("Character [%s] has no hitboxes.", *GetName());
+        return;
+    }
 
-        TArray<FHitResult> OutHits;
-        UKismetSystemLibrary::SphereTraceMultiForObjects(
-            World, TraceLocation, TraceLocation, HitboxEntry.Radius, ObjectTypesToHit, false, MeleeHitTargets,
-            DrawDebugTrace, OutHits, false, FLinearColor::Red, FLinearColor::Green, DrawTime);
+    const uint64 SavedMask = ActiveHitboxMask;
+    const TSet<TObjectPtr<AActor>> SavedHitTargets = MeleeHitTargets;
+    DisableMeleeHitboxes();
 
-        for (const FHitResult &Hit : OutHits)
-        {
-            PerformHit(Hit);
-        }
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Iterations; i++)
+    {
+        AddMeleeHitboxes(Nicknames);
+        RemoveMeleeHitboxes(Nicknames);
+    }
+    const double NicknamesEndSeconds = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < Iterations; i++)
+    {
+        AddMeleeHitboxesById(HitboxIds);
+        RemoveMeleeHitboxesById(HitboxIds);
+    }
+    const double IdsEndSeconds = FPlatformTime::Seconds();
+
+    ActiveHitboxMask = SavedMask;
+    MeleeHitTargets = SavedHitTargets;
+    SetMeleeInProgress(ActiveHitboxMask != 0);
+
+    MTD_LOG("%d hitboxes over %d notifies: %.3f us per notify by nicknames, %.3f us per notify by IDs.",
+        Nicknames.Num(), Iterations, (NicknamesEndSeconds - StartSeconds) * 1000000.0 / Iterations,
+        (IdsEndSeconds - NicknamesEndSeconds) * 1000000.0 / Iterations);
+}
+#endif
+
+void AMTD_BaseCharacter::SetMeleeInProgress(bool bInProgress)
+{
+    if (bIsMeleeInProgress == bInProgress)
+    {
+        return;
+    }
+
+    bIsMeleeInProgress = bInProgress;
+
+    UMTD_MeleeTraceSubsystem *MeleeTraceSubsystem = UMTD_MeleeTraceSubsystem::Get(this);
+    if (!IsValid(MeleeTraceSubsystem))
+    {
+        return;
+    }
+
+    if (bIsMeleeInProgress)
+    {
+        MeleeTraceSubsystem->RegisterMeleeCharacter(this);
+    }
+    else
+    {
+        MeleeTraceSubsystem->UnregisterMeleeCharacter(this);
     }
 }
 
@@ -192,6 +255,13 @@ void AMTD_BaseCharacter::PerformHit(const FHitResult &Hit)
     AActor *HitActor = Hit.GetActor();
     MeleeHitTargets.Add(HitActor);
 
+    // Melee hit abilities apply gameplay effects, which requires this character to have an ability system
+    if (!IsValid(Asc))
+    {
+        PerformLiteHit(Hit);
+        return;
+    }
+
     FGameplayEventData EventData;
     EventData.ContextHandle = Asc->MakeEffectContext();
     EventData.Instigator = GetPlayerState();
@@ -201,6 +271,94 @@ void AMTD_BaseCharacter::PerformHit(const FHitResult &Hit)
 
     const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
     Asc->HandleGameplayEvent(GameplayTags.Gameplay_Event_MeleeHit, &EventData);
+
+    // Ability still runs, but its gameplay effects can't reach a target without an ability system, hence the damage
+    // is resolved natively, from the attributes the ability has just set up
+    if (FMTD_LiteCombat::IsLiteTarget(HitActor))
+    {
+        PerformLiteHit(Hit);
+    }
+}
+
+void AMTD_BaseCharacter::PerformLiteHit(const FHitResult &Hit)
+{
+    AActor *HitActor = Hit.GetActor();
+    if (!IsValid(HitActor))
+    {
+        return;
+    }
+
+    float Damage = 0.f;
+    float BalanceDamage = 0.f;
+    GetLiteHitDamage(Damage, BalanceDamage);
+
+    // Characters with an ability system are instigated by their player state, the same as with gameplay events
+    AActor *DamageInstigator = GetPlayerState();
+    if (!IsValid(DamageInstigator))
+    {
+        DamageInstigator = this;
+    }
+
+    const FVector KnockbackDirection = (HitActor->GetActorLocation() - GetActorLocation()).GetSafeNormal2D();
+    if (FMTD_LiteCombat::ApplyHit(HitActor, Damage, BalanceDamage, KnockbackDirection, DamageInstigator))
+    {
+        return;
+    }
+
+    // Character without an ability system hits a target that has one
+    UAbilitySystemComponent *TargetAsc = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitActor);
+    UMTD_DamageSubsystem *DamageSubsystem = UMTD_DamageSubsystem::Get(this);
+    if ((!IsValid(TargetAsc)) || (!IsValid(DamageSubsystem)))
+    {
+        return;
+    }
+
+    // Without a context the target's own one would be made, crediting the target with its own damage
+    FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+    EffectContext.AddInstigator(DamageInstigator, this);
+    EffectContext.AddHitResult(Hit, true);
+
+    FMTD_DamageHit DamageHit;
+    DamageHit.Target = TargetAsc;
+    DamageHit.DamageBase = Damage;
+    DamageHit.bBalanceDamage = (BalanceDamage > 0.f);
+    DamageHit.BalanceDamage = BalanceDamage;
+    DamageHit.KnockbackDirection = KnockbackDirection;
+    DamageHit.EffectContext = EffectContext;
+    DamageSubsystem->QueueDamage(DamageHit);
+
+    // Batched gameplay effect has no cues, unlike the damage gameplay effect a melee hit ability would apply
+    FGameplayCueParameters CueParameters(EffectContext);
+    CueParameters.RawMagnitude = UMTD_DamageSubsystem::ComputeHitDamage(DamageHit);
+    TargetAsc->ExecuteGameplayCue(FMTD_GameplayTags::Get().GameplayCue_DamageInstant, CueParameters);
+}
+
+void AMTD_BaseCharacter::GetLiteHitDamage(float &OutDamage, float &OutBalanceDamage) const
+{
+    const UAbilitySystemComponent *Asc = GetAbilitySystemComponent();
+    if (!IsValid(Asc))
+    {
+        OutDamage = 0.f;
+        OutBalanceDamage = 0.f;
+        return;
+    }
+
+    // Same source attributes the damage and balance damage executions capture. Base damage to use is set up by
+    // abilities, without one the melee weapon base damage is what the hit uses
+    float DamageBase = Asc->GetNumericAttribute(UMTD_CombatSet::GetBaseDamageToUse_MetaAttribute());
+    if (DamageBase == 0.f)
+    {
+        DamageBase = Asc->GetNumericAttribute(UMTD_CombatSet::GetDamageBaseAttribute());
+    }
+
+    const FGameplayAttribute DamageStatAttribute = UMTD_PlayerSet::GetDamageStatAttribute();
+    const float DamageStat = (Asc->HasAttributeSetForAttribute(DamageStatAttribute)) ?
+        (Asc->GetNumericAttribute(DamageStatAttribute)) : (0.f);
+
+    OutDamage = UMTD_DamageExecution::ComputeDamageDone(DamageBase,
+        Asc->GetNumericAttribute(UMTD_CombatSet::GetDamageAdditiveAttribute()),
+        ComboComponent->GetComboDamageMultiplier(), DamageStat);
+    OutBalanceDamage = Asc->GetNumericAttribute(UMTD_BalanceSet::GetDamageAttribute());
 }
 
 void AMTD_BaseCharacter::InitializeAttributes()
@@ -215,9 +373,11 @@ void AMTD_BaseCharacter::SetupPlayerInputComponent(UInputComponent *PlayerInputC
     PawnExtentionComponent->SetupPlayerInputComponent();
 }
 
-void AMTD_BaseCharacter::ConstructHitboxMap()
+void AMTD_BaseCharacter::BakeHitboxes()
 {
-    HitboxMap.Empty();
+    Hitboxes.Empty();
+    HitboxSlots.Empty();
+    ActiveHitboxMask = 0;
 
     if (HitboxData.IsEmpty())
     {
@@ -244,15 +404,52 @@ void AMTD_BaseCharacter::ConstructHitboxMap()
 
         for (const FMTD_MeleeHitSphereDefinition &HitDefinition : Data->MeleeHitSpheres)
         {
-            FMTD_ActiveHitboxEntry HitboxEntry;
-            HitboxEntry.HitboxInfo = HitDefinition;
-            
-            HitboxMap.Add(HitDefinition.Nickname, HitboxEntry);
+            const uint16 Id = FMTD_MeleeHitboxIds::FindOrAdd(HitDefinition.Nickname);
+            if (Id == FMTD_MeleeHitboxIds::InvalidId)
+            {
+                continue;
+            }
+
+            while (!HitboxSlots.IsValidIndex(Id))
+            {
+                HitboxSlots.Add(INDEX_NONE);
+            }
+
+            // Hitbox with the same nickname overrides the previous one
+            int8 &Slot = HitboxSlots[Id];
+            if (Slot == INDEX_NONE)
+            {
+                if (Hitboxes.Num() >= MaxHitboxes)
+                {
+                    MTD_WARN("Character has more than %d hitboxes, [%s] is ignored.",
+                        MaxHitboxes, *HitDefinition.Nickname.ToString());
+                    continue;
+                }
+
+                Slot = static_cast<int8>(Hitboxes.AddDefaulted());
+            }
+
+            Hitboxes[Slot].HitboxInfo = HitDefinition;
         }
         Index++;
     }
 }
 
+uint64 AMTD_BaseCharacter::GetHitboxMask(TConstArrayView<uint16> HitboxIds) const
+{
+    uint64 Mask = 0;
+    for (const uint16 Id : HitboxIds)
+    {
+        const int32 Slot = (HitboxSlots.IsValidIndex(Id)) ? (HitboxSlots[Id]) : (INDEX_NONE);
+        if (Slot != INDEX_NONE)
+        {
+            Mask |= (uint64(1) << Slot);
+        }
+    }
+
+    return Mask;
+}
+
 void AMTD_BaseCharacter::FellOutOfWorld(const UDamageType &DamageType)
 {
     HealthComponent->SelfDestruct(true);
@@ -323,3 +520,24 @@ UAbilitySystemComponent *AMTD_BaseCharacter::GetAbilitySystemComponent() const
 {
     return GetMtdAbilitySystemComponent();
 }
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs HitboxNotifyBenchmarkCommand(
+    TEXT("mtd.HitboxNotifyBenchmark"),
+    TEXT("Activate all hitboxes of the first player. Usage: mtd.HitboxNotifyBenchmark [Iterations=10000]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        const APlayerController *PlayerController = (IsValid(World)) ? (World->GetFirstPlayerController()) : (nullptr);
+        const auto Character =
+            (IsValid(PlayerController)) ? (Cast<AMTD_BaseCharacter>(PlayerController->GetPawn())) : (nullptr);
+
+        if (!IsValid(Character))
+        {
+            MTD_WARN("First player has no character.");
+            return;
+        }
+
+        const int32 Iterations = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (10000);
+        Character->RunHitboxNotifyBenchmark(Iterations);
+    }));
+#endif
@@ -4,18 +4,23 @@
 #include "AbilitySystem/Attributes/MTD_CombatSet.h"
 #include "AbilitySystem/Attributes/MTD_HealthSet.h"
 #include "AbilitySystem/Attributes/MTD_ManaSet.h"
-#include "AbilitySystemComponent.h"
+#include "AbilitySystem/MTD_AbilitySystemComponent.h"
+#include "AbilitySystem/MTD_GameplayTags.h"
+#include "Animation/AnimInstance.h"
 #include "Character/MTD_BasePlayerCharacter.h"
 #include "Character/MTD_CharacterCoreTypes.h"
 #include "Character/MTD_EnemyExtensionComponent.h"
+#include "Character/MTD_BalanceComponent.h"
 #include "Character/MTD_HealthComponent.h"
+#include "Character/MTD_PawnExtensionComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SphereComponent.h"
 #include "Equipment/MTD_EquipmentManagerComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/PlayerState.h"
 #include "GameModes/MTD_GameModeBase.h"
-#include "Kismet/DataTableFunctionLibrary.h"
+#include "Player/MTD_EnemyCrowdSubsystem.h"
 #include "Utility/MTD_Utility.h"
 
 AMTD_BaseEnemyCharacter::AMTD_BaseEnemyCharacter()
@@ -66,6 +71,22 @@ void AMTD_BaseEnemyCharacter::BeginPlay()
 
     InitializeAttributes();
     EquipDefaultWeapon();
+
+    if (IsControllerless())
+    {
+        SetupControllerless();
+    }
+}
+
+void AMTD_BaseEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UMTD_EnemyCrowdSubsystem *CrowdSubsystem = UMTD_EnemyCrowdSubsystem::Get(this);
+    if (IsValid(CrowdSubsystem))
+    {
+        CrowdSubsystem->UnregisterEnemy(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AMTD_BaseEnemyCharacter::InitializeAttributes()
@@ -83,39 +104,54 @@ void AMTD_BaseEnemyCharacter::InitializeAttributes()
         return;
     }
 
-    UAbilitySystemComponent *Asc = GetAbilitySystemComponent();
-    if (!IsValid(Asc))
-    {
-        MTDS_WARN("Ability System Component on Enemy [%s] is invalid.", *GetName());
-        return;
-    }
-
+    const FMTD_AttributeCurveCache &AttributeCache = EnemyData->GetAttributeCache();
     float Value;
     float TemporaryLevel = 1.f;
 
-    EVALUTE_ATTRIBUTE(EnemyData->TemporaryAttributeTable, HealthScaleAttributeName, TemporaryLevel, Value);
-    Value *= EnemyData->Health;
-    Asc->ApplyModToAttribute(UMTD_HealthSet::GetMaxHealthAttribute(), EGameplayModOp::Type::Override, Value);
-    Asc->ApplyModToAttribute(UMTD_HealthSet::GetHealthAttribute(), EGameplayModOp::Type::Override, Value);
-
-    Value = EnemyData->Mana;
-    Asc->ApplyModToAttribute(UMTD_ManaSet::GetMaxManaAttribute(), EGameplayModOp::Type::Override, Value);
-    Asc->ApplyModToAttribute(UMTD_ManaSet::GetManaAttribute(), EGameplayModOp::Type::Override, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, HealthScaleAttributeName, TemporaryLevel, Value);
+    const float Health = Value * EnemyData->Health;
 
-    EVALUTE_ATTRIBUTE(EnemyData->TemporaryAttributeTable, DamageScaleScaleAttributeName, TemporaryLevel, Value);
-    Value *= EnemyData->Damage;
-    Asc->ApplyModToAttribute(UMTD_CombatSet::GetDamageBaseAttribute(), EGameplayModOp::Type::Override, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, DamageScaleScaleAttributeName, TemporaryLevel, Value);
+    const float Damage = Value * EnemyData->Damage;
 
-    // EVALUTE_ATTRIBUTE(EnemyData->TemporaryAttributeTable, SpeedScaleScaleAttributeName, TemporaryLevel, Value);
+    // EVALUATE_CACHED_ATTRIBUTE(AttributeCache, SpeedScaleScaleAttributeName, TemporaryLevel, Value);
     // Value *= EnemyData->Speed;
     // ...
 
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetDamageAttribute(), EGameplayModOp::Type::Override,
-        EnemyData->BalanceDamage);
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetThresholdAttribute(), EGameplayModOp::Type::Override,
-        EnemyData->BalanceThreshold);
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetResistAttribute(), EGameplayModOp::Type::Override,
-        EnemyData->BalanceResist);
+    if (IsLiteCombat())
+    {
+        LiteCombatStats.Health = Health;
+        LiteCombatStats.MaxHealth = Health;
+        LiteCombatStats.Damage = Damage;
+        LiteCombatStats.BalanceDamage = EnemyData->BalanceDamage;
+        LiteCombatStats.BalanceThreshold = EnemyData->BalanceThreshold;
+        LiteCombatStats.BalanceResist = EnemyData->BalanceResist;
+
+        GetHealthComponent()->InitializeWithLiteStats(&LiteCombatStats);
+        GetBalanceComponent()->InitializeWithLiteStats(&LiteCombatStats);
+
+        MTDS_VERBOSE("Enemy [%s]'s lite combat stats have been initialized.", *GetName());
+        return;
+    }
+
+    UMTD_AbilitySystemComponent *MtdAsc = GetMtdAbilitySystemComponent();
+    if (!IsValid(MtdAsc))
+    {
+        MTDS_WARN("Ability System Component on Enemy [%s] is invalid.", *GetName());
+        return;
+    }
+
+    TArray<FMTD_AttributeInitValue, TInlineAllocator<8>> InitValues;
+    InitValues.Add({ UMTD_HealthSet::GetMaxHealthAttribute(), Health });
+    InitValues.Add({ UMTD_HealthSet::GetHealthAttribute(), Health });
+    InitValues.Add({ UMTD_ManaSet::GetMaxManaAttribute(), EnemyData->Mana });
+    InitValues.Add({ UMTD_ManaSet::GetManaAttribute(), EnemyData->Mana });
+    InitValues.Add({ UMTD_CombatSet::GetDamageBaseAttribute(), Damage });
+    InitValues.Add({ UMTD_BalanceSet::GetDamageAttribute(), EnemyData->BalanceDamage });
+    InitValues.Add({ UMTD_BalanceSet::GetThresholdAttribute(), EnemyData->BalanceThreshold });
+    InitValues.Add({ UMTD_BalanceSet::GetResistAttribute(), EnemyData->BalanceResist });
+
+    MtdAsc->InitializeAttributeValues(InitValues);
 
     MTDS_VERBOSE("Enemy [%s]'s attributes have been initialized.", *GetName());
 }
@@ -126,6 +162,17 @@ void AMTD_BaseEnemyCharacter::OnDeathStarted_Implementation(AActor *OwningActor)
 
     DetachFromControllerPendingDestroy();
     DisableCollisions();
+
+    UMTD_EnemyCrowdSubsystem *CrowdSubsystem = UMTD_EnemyCrowdSubsystem::Get(this);
+    if (IsValid(CrowdSubsystem))
+    {
+        CrowdSubsystem->UnregisterEnemy(this);
+    }
+
+    if (GetHealthComponent()->IsLite())
+    {
+        StartLiteDeath();
+    }
 }
 
 void AMTD_BaseEnemyCharacter::OnDeathFinished_Implementation(AActor *OwningActor)
@@ -135,8 +182,110 @@ void AMTD_BaseEnemyCharacter::OnDeathFinished_Implementation(AActor *OwningActor
     GetEquipmentManagerComponent()->UnequipItem();
 }
 
+void AMTD_BaseEnemyCharacter::GetLiteHitDamage(float &OutDamage, float &OutBalanceDamage) const
+{
+    if (!GetHealthComponent()->IsLite())
+    {
+        Super::GetLiteHitDamage(OutDamage, OutBalanceDamage);
+        return;
+    }
+
+    OutDamage = LiteCombatStats.Damage;
+    OutBalanceDamage = LiteCombatStats.BalanceDamage;
+}
+
+bool AMTD_BaseEnemyCharacter::UsesNativeAi() const
+{
+    const auto EnemyData = EnemyExtensionComponent->GetEnemyData<UMTD_EnemyData>();
+    return ((IsValid(EnemyData)) && ((EnemyData->bUseNativeAi) || (IsLiteCombat())));
+}
+
+bool AMTD_BaseEnemyCharacter::IsLiteCombat() const
+{
+    const auto EnemyData = EnemyExtensionComponent->GetEnemyData<UMTD_EnemyData>();
+    return ((IsValid(EnemyData)) && ((bLiteCombatOverride) || (EnemyData->bLiteCombat)));
+}
+
+bool AMTD_BaseEnemyCharacter::IsControllerless() const
+{
+    const auto EnemyData = EnemyExtensionComponent->GetEnemyData<UMTD_EnemyData>();
+    return ((IsValid(EnemyData)) && ((bLiteCombatOverride) ?
+        (bControllerlessOverride) : ((EnemyData->bLiteCombat) && (EnemyData->bControllerless))));
+}
+
+void AMTD_BaseEnemyCharacter::OverrideLiteCombat(bool bInControllerless)
+{
+    if (HasActorBegunPlay())
+    {
+        MTDS_WARN("Enemy [%s] has already begun play, lite combat can't be overridden anymore.", *GetName());
+        return;
+    }
+
+    bLiteCombatOverride = true;
+    bControllerlessOverride = bInControllerless;
+}
+
+FGenericTeamId AMTD_BaseEnemyCharacter::GetGenericTeamId() const
+{
+    const auto TeamAgent = Cast<IGenericTeamAgentInterface>(GetController());
+    return (TeamAgent) ? (TeamAgent->GetGenericTeamId()) : (FGenericTeamId(static_cast<uint8>(EMTD_TeamId::Enemy)));
+}
+
+bool AMTD_BaseEnemyCharacter::PlayLiteAttack()
+{
+    if (GetHealthComponent()->IsDeadOrDying())
+    {
+        return false;
+    }
+
+    UAnimInstance *AnimInstance = GetMesh()->GetAnimInstance();
+    if ((!IsValid(AnimInstance)) || (AnimInstance->IsAnyMontagePlaying()))
+    {
+        return false;
+    }
+
+    // Fall back to the montages the melee attack ability would play
+    UAnimMontage *AnimMontage = nullptr;
+    if (!LiteAttackMontages.IsEmpty())
+    {
+        AnimMontage = LiteAttackMontages[FMath::RandRange(0, LiteAttackMontages.Num() - 1)];
+    }
+    else
+    {
+        const auto PawnExtensionComponent = UMTD_PawnExtensionComponent::FindPawnExtensionComponent(this);
+        AnimMontage = (IsValid(PawnExtensionComponent)) ?
+            (PawnExtensionComponent->GetRandomAnimMontage(FMTD_GameplayTags::Get().Gameplay_Ability_Attack_Melee)) :
+            (nullptr);
+    }
+
+    return ((IsValid(AnimMontage)) && (AnimInstance->Montage_Play(AnimMontage) > 0.f));
+}
+
+bool AMTD_BaseEnemyCharacter::PerformNativeAttack()
+{
+    if (IsLiteCombat())
+    {
+        return PlayLiteAttack();
+    }
+
+    UMTD_AbilitySystemComponent *MtdAsc = GetMtdAbilitySystemComponent();
+    if ((!IsValid(MtdAsc)) || (GetHealthComponent()->IsDeadOrDying()))
+    {
+        return false;
+    }
+
+    const FGameplayTagContainer AttackTags(FMTD_GameplayTags::Get().Gameplay_Ability_Attack_Melee);
+    return MtdAsc->TryActivateAbilitiesByTag(AttackTags);
+}
+
 void AMTD_BaseEnemyCharacter::EquipDefaultWeapon()
 {
+    // Weapons grant their abilities through the ability system, which lite enemies don't have
+    if (IsLiteCombat())
+    {
+        return;
+    }
+
     if (!IsValid(DefaultWeaponDefinitionClass))
     {
         MTDS_WARN("Default Weapon Definition Class is not set. Enemy [%s] will have no weapon.", *GetName());
@@ -147,6 +296,82 @@ void AMTD_BaseEnemyCharacter::EquipDefaultWeapon()
     EquipManager->EquipItem(DefaultWeaponDefinitionClass);
 }
 
+void AMTD_BaseEnemyCharacter::SetupControllerless()
+{
+    // Nobody possesses the pawn, hence it is ready to initialize as is
+    UMTD_PawnExtensionComponent *PawnExtensionComponent = UMTD_PawnExtensionComponent::FindPawnExtensionComponent(this);
+    if (IsValid(PawnExtensionComponent))
+    {
+        PawnExtensionComponent->SetRequiresController(false);
+    }
+
+    // Movement requests are written by the crowd subsystem, and there is no controller to rotate the pawn
+    UCharacterMovementComponent *MovementComponent = GetCharacterMovement();
+    MovementComponent->bRunPhysicsWithNoController = true;
+    MovementComponent->bOrientRotationToMovement = true;
+    bUseControllerRotationYaw = false;
+
+    GetBalanceComponent()->OnBalanceDownDelegate.AddDynamic(this, &ThisClass::OnControllerlessKnockback);
+
+    UMTD_EnemyCrowdSubsystem *CrowdSubsystem = UMTD_EnemyCrowdSubsystem::Get(this);
+    if (!IsValid(CrowdSubsystem))
+    {
+        MTDS_WARN("Enemy Crowd Subsystem is invalid, controller-less enemy [%s] will not move.", *GetName());
+        return;
+    }
+
+    CrowdSubsystem->RegisterEnemy(this);
+}
+
+void AMTD_BaseEnemyCharacter::OnControllerlessKnockback(const FMTD_BalanceHit &HitData)
+{
+    const auto EnemyData = EnemyExtensionComponent->GetEnemyData<UMTD_EnemyData>();
+    UMTD_EnemyCrowdSubsystem *CrowdSubsystem = UMTD_EnemyCrowdSubsystem::Get(this);
+    if ((IsValid(EnemyData)) && (IsValid(CrowdSubsystem)))
+    {
+        CrowdSubsystem->KnockBack(this, EnemyData->KnockbackTime);
+    }
+}
+
+void AMTD_BaseEnemyCharacter::StartLiteDeath()
+{
+    const auto PawnExtensionComponent = UMTD_PawnExtensionComponent::FindPawnExtensionComponent(this);
+    UAnimMontage *DeathMontage = (IsValid(PawnExtensionComponent)) ?
+        (PawnExtensionComponent->GetRandomAnimMontage(FMTD_GameplayTags::Get().Gameplay_Ability_Death)) : (nullptr);
+
+    UAnimInstance *AnimInstance = GetMesh()->GetAnimInstance();
+    if ((!IsValid(DeathMontage)) || (!IsValid(AnimInstance)) || (AnimInstance->Montage_Play(DeathMontage) <= 0.f))
+    {
+        OnLiteDeathMontageBlendingOut(nullptr, false);
+        return;
+    }
+
+    FOnMontageBlendingOutStarted BlendingOutDelegate;
+    BlendingOutDelegate.BindUObject(this, &ThisClass::OnLiteDeathMontageBlendingOut);
+    AnimInstance->Montage_SetBlendingOutDelegate(BlendingOutDelegate, DeathMontage);
+}
+
+void AMTD_BaseEnemyCharacter::OnLiteDeathMontageBlendingOut(UAnimMontage *AnimMontage, bool bInterrupted)
+{
+    const auto EnemyData = EnemyExtensionComponent->GetEnemyData<UMTD_EnemyData>();
+    const float Delay = (IsValid(EnemyData)) ? (EnemyData->LiteDeathDelay) : (0.f);
+
+    if (Delay > 0.f)
+    {
+        FTimerHandle TimerHandle;
+        GetWorldTimerManager().SetTimer(TimerHandle, this, &ThisClass::FinishLiteDeath, Delay, false);
+    }
+    else
+    {
+        GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::FinishLiteDeath);
+    }
+}
+
+void AMTD_BaseEnemyCharacter::FinishLiteDeath()
+{
+    GetHealthComponent()->FinishDeath();
+}
+
 void AMTD_BaseEnemyCharacter::SetNewTarget(APawn *Pawn)
 {
     if (Pawn == Target)
@@ -264,7 +489,13 @@ void AMTD_BaseEnemyCharacter::OnHealthChanged_Implementation(UMTD_HealthComponen
         return;
     }
 
-    auto Ps = CastChecked<APlayerState>(InInstigator);
+    // Hits resolved natively may have no instigator
+    const auto Ps = Cast<APlayerState>(InInstigator);
+    if (!IsValid(Ps))
+    {
+        return;
+    }
+
     APawn *InstigatorPawn = Ps->GetPawn();
 
     // A pawn may die in case of delay damage, while the PS will be still instantiated
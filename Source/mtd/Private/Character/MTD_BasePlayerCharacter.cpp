@@ -3,7 +3,7 @@
 #include "AbilitySystem/Attributes/MTD_BalanceSet.h"
 #include "AbilitySystem/Attributes/MTD_HealthSet.h"
 #include "AbilitySystem/Attributes/MTD_ManaSet.h"
-#include "AbilitySystemComponent.h"
+#include "AbilitySystem/MTD_AbilitySystemComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Character/MTD_CharacterCoreTypes.h"
 #include "Character/MTD_PlayerExtensionComponent.h"
@@ -11,7 +11,6 @@
 #include "EnhancedInputSubsystems.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "Kismet/DataTableFunctionLibrary.h"
 
 AMTD_BasePlayerCharacter::AMTD_BasePlayerCharacter()
 {
@@ -66,28 +65,32 @@ void AMTD_BasePlayerCharacter::InitializeAttributes()
         return;
     }
 
-    UAbilitySystemComponent *Asc = GetAbilitySystemComponent();
-    if (!IsValid(Asc))
+    UMTD_AbilitySystemComponent *MtdAsc = GetMtdAbilitySystemComponent();
+    if (!IsValid(MtdAsc))
     {
         MTDS_WARN("Ability System Component on Player [%s] is invalid.", *GetName());
         return;
     }
 
+    const FMTD_AttributeCurveCache &AttributeCache = PlayerData->GetAttributeCache();
     float Value;
+    TArray<FMTD_AttributeInitValue, TInlineAllocator<8>> InitValues;
 
-    EVALUTE_ATTRIBUTE(PlayerData->AttributeTable, HealthAttributeName, Level, Value);
-    Asc->ApplyModToAttribute(UMTD_HealthSet::GetMaxHealthAttribute(), EGameplayModOp::Type::Override, Value);
-    Asc->ApplyModToAttribute(UMTD_HealthSet::GetHealthAttribute(), EGameplayModOp::Type::Override, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, HealthAttributeName, Level, Value);
+    InitValues.Add({ UMTD_HealthSet::GetMaxHealthAttribute(), Value });
+    InitValues.Add({ UMTD_HealthSet::GetHealthAttribute(), Value });
     
-    EVALUTE_ATTRIBUTE(PlayerData->AttributeTable, ManaAttributeName, Level, Value);
-    Asc->ApplyModToAttribute(UMTD_ManaSet::GetMaxManaAttribute(), EGameplayModOp::Type::Override, Value);
-    Asc->ApplyModToAttribute(UMTD_ManaSet::GetManaAttribute(), EGameplayModOp::Type::Override, 0.f);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, ManaAttributeName, Level, Value);
+    InitValues.Add({ UMTD_ManaSet::GetMaxManaAttribute(), Value });
+    InitValues.Add({ UMTD_ManaSet::GetManaAttribute(), 0.f });
     
-    EVALUTE_ATTRIBUTE(PlayerData->AttributeTable, BalanceDamageAttributeName, Level, Value);
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetDamageAttribute(), EGameplayModOp::Type::Override, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, BalanceDamageAttributeName, Level, Value);
+    InitValues.Add({ UMTD_BalanceSet::GetDamageAttribute(), Value });
     
-    EVALUTE_ATTRIBUTE(PlayerData->AttributeTable, BalanceResistAttributeName, Level, Value);
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetResistAttribute(), EGameplayModOp::Type::Override, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, BalanceResistAttributeName, Level, Value);
+    InitValues.Add({ UMTD_BalanceSet::GetResistAttribute(), Value });
+
+    MtdAsc->InitializeAttributeValues(InitValues);
 
     MTDS_VERBOSE("Player [%s]'s attributes have been initialized.", *GetName());
 }
@@ -0,0 +1,153 @@
+#include "Character/MTD_CharacterCoreTypes.h"
+
+#include "Kismet/DataTableFunctionLibrary.h"
+#include "UObject/UObjectIterator.h"
+
+void UMTD_PlayerData::PostLoad()
+{
+    Super::PostLoad();
+
+    AttributeCache.BakeIfStale(AttributeTable);
+}
+
+const FMTD_AttributeCurveCache &UMTD_PlayerData::GetAttributeCache() const
+{
+    AttributeCache.BakeIfStale(AttributeTable);
+    return AttributeCache;
+}
+
+void UMTD_TowerData::PostLoad()
+{
+    Super::PostLoad();
+
+    AttributeCache.BakeIfStale(AttributeTable);
+}
+
+const FMTD_AttributeCurveCache &UMTD_TowerData::GetAttributeCache() const
+{
+    AttributeCache.BakeIfStale(AttributeTable);
+    return AttributeCache;
+}
+
+void UMTD_EnemyData::PostLoad()
+{
+    Super::PostLoad();
+
+    AttributeCache.BakeIfStale(TemporaryAttributeTable);
+}
+
+const FMTD_AttributeCurveCache &UMTD_EnemyData::GetAttributeCache() const
+{
+    AttributeCache.BakeIfStale(TemporaryAttributeTable);
+    return AttributeCache;
+}
+
+#if !UE_BUILD_SHIPPING
+namespace AttributeCurveCacheDebug
+{
+    /** Attributes each kind of data is initialized with on spawn. */
+    const FName PlayerAttributes[] =
+        { HealthAttributeName, ManaAttributeName, BalanceDamageAttributeName, BalanceResistAttributeName };
+    const FName TowerAttributes[] =
+        { DamageAttributeName, RangeAttributeName, VisionDegreesAttributeName, FirerateAttributeName,
+          ProjectileSpeedAttributeName, BalanceDamageAttributeName, HealthAttributeName };
+    const FName EnemyAttributes[] =
+        { HealthScaleAttributeName, DamageScaleScaleAttributeName };
+
+    /** Evaluate the attributes the way a spawn does, both by the curve table and by the cache, and log the timings. */
+    void BenchmarkSpawns(const UObject *Data, UCurveTable *CurveTable, const FMTD_AttributeCurveCache &Cache,
+        TConstArrayView<FName> AttributeNames, int32 Spawns, float Level)
+    {
+        if (!IsValid(CurveTable))
+        {
+            return;
+        }
+
+        float Sum = 0.f;
+        const double StartSeconds = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Spawns; i++)
+        {
+            for (const FName &AttributeName : AttributeNames)
+            {
+                TEnumAsByte<EEvaluateCurveTableResult::Type> Result;
+                float Value = 0.f;
+                UDataTableFunctionLibrary::EvaluateCurveTableRow(
+                    CurveTable, AttributeName, Level, Result, Value, FString());
+                Sum += Value;
+            }
+        }
+        const double TableEndSeconds = FPlatformTime::Seconds();
+
+        float CachedSum = 0.f;
+        for (int32 i = 0; i < Spawns; i++)
+        {
+            for (const FName &AttributeName : AttributeNames)
+            {
+                float Value = 0.f;
+                Cache.Evaluate(AttributeName, Level, Value);
+                CachedSum += Value;
+            }
+        }
+        const double CacheEndSeconds = FPlatformTime::Seconds();
+
+        MTD_LOG("[%s] %d spawns: %.3f us per spawn evaluated, %.3f us per spawn cached, sums %s.",
+            *Data->GetName(), Spawns, (TableEndSeconds - StartSeconds) * 1000000.0 / Spawns,
+            (CacheEndSeconds - TableEndSeconds) * 1000000.0 / Spawns,
+            (Sum == CachedSum) ? (TEXT("match")) : (TEXT("differ")));
+    }
+}
+
+static FAutoConsoleCommand AttributeCacheCheckCommand(
+    TEXT("mtd.AttributeCacheCheck"),
+    TEXT("Compare cached attributes of every loaded player, tower and enemy data against their curve tables."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        int32 Caches = 0;
+        int32 Mismatches = 0;
+        for (TObjectIterator<UMTD_PlayerData> It; It; ++It)
+        {
+            Mismatches += It->GetAttributeCache().Validate();
+            Caches++;
+        }
+
+        for (TObjectIterator<UMTD_TowerData> It; It; ++It)
+        {
+            Mismatches += It->GetAttributeCache().Validate();
+            Caches++;
+        }
+
+        for (TObjectIterator<UMTD_EnemyData> It; It; ++It)
+        {
+            Mismatches += It->GetAttributeCache().Validate();
+            Caches++;
+        }
+
+        MTD_LOG("Attribute cache check finished with [%d] mismatch(es) over [%d] cache(s).", Mismatches, Caches);
+    }));
+
+static FAutoConsoleCommandWithArgs AttributeCacheBenchmarkCommand(
+    TEXT("mtd.AttributeCacheBenchmark"),
+    TEXT("Evaluate spawn attributes of every loaded data. Usage: mtd.AttributeCacheBenchmark [Spawns=1000] [Level=1]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString> &Args)
+    {
+        const int32 Spawns = (Args.IsValidIndex(0)) ? (FMath::Max(FCString::Atoi(*Args[0]), 1)) : (1000);
+        const float Level = (Args.IsValidIndex(1)) ? (FCString::Atof(*Args[1])) : (1.f);
+
+        using namespace AttributeCurveCacheDebug;
+        for (TObjectIterator<UMTD_PlayerData> It; It; ++It)
+        {
+            BenchmarkSpawns(*It, It->AttributeTable, It->GetAttributeCache(), PlayerAttributes, Spawns, Level);
+        }
+
+        for (TObjectIterator<UMTD_TowerData> It; It; ++It)
+        {
+            BenchmarkSpawns(*It, It->AttributeTable, It->GetAttributeCache(), TowerAttributes, Spawns, Level);
+        }
+
+        for (TObjectIterator<UMTD_EnemyData> It; It; ++It)
+        {
+            BenchmarkSpawns(
+                *It, It->TemporaryAttributeTable, It->GetAttributeCache(), EnemyAttributes, Spawns, Level);
+        }
+    }));
+#endif
@@ -1,6 +1,7 @@
 #include "Character/MTD_CharacterSpawner.h"
 
 #include "Character/MTD_BaseCharacter.h"
+#include "Character/MTD_BaseEnemyCharacter.h"
 #include "Kismet/GameplayStatics.h"
 
 AMTD_CharacterSpawner::AMTD_CharacterSpawner()
@@ -71,14 +72,76 @@ void AMTD_CharacterSpawner::OnSpawn()
 {
     PrepareNextSpawnCall();
 
-    const FTransform Transform = GetSpawnTransform();
-    
+    AMTD_BaseCharacter *Character = SpawnCharacter(GetSpawnTransform());
+    if (IsValid(Character))
+    {
+        OnSpawnDelegate.Broadcast(Character);
+    }
+}
+
+AMTD_BaseCharacter *AMTD_CharacterSpawner::SpawnCharacter(const FTransform &Transform,
+    const TFunction<void(AMTD_BaseCharacter*)> &PreFinishSpawning) const
+{
+    if ((!IsValid(World)) || (!CharacterClass))
+    {
+        return nullptr;
+    }
+
     const auto HdlMethod = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
     
     auto Character = World->SpawnActorDeferred<AMTD_BaseCharacter>(
         CharacterClass, Transform, nullptr, nullptr, HdlMethod);
-    Character->SpawnDefaultController();
+    if (!IsValid(Character))
+    {
+        return nullptr;
+    }
+
+    if (PreFinishSpawning)
+    {
+        PreFinishSpawning(Character);
+    }
+
+    // Controller-less enemies are driven by the crowd subsystem, which halves the actors a wave spawns
+    const auto Enemy = Cast<AMTD_BaseEnemyCharacter>(Character);
+    if ((!IsValid(Enemy)) || (!Enemy->IsControllerless()))
+    {
+        Character->SpawnDefaultController();
+    }
+
     UGameplayStatics::FinishSpawningActor(Character, Transform);
-    
-    OnSpawnDelegate.Broadcast(Character);
+
+    return Character;
+}
+
+TArray<AMTD_BaseCharacter*> AMTD_CharacterSpawner::SpawnWave(int32 Count,
+    const TFunction<void(AMTD_BaseCharacter*)> &PreFinishSpawning) const
+{
+    // Keep neighbours about a hundred units apart however large the wave is
+    const float Radius = 100.f * FMath::Sqrt(static_cast<float>(FMath::Max(Count, 1)));
+    return SpawnWave(GetActorLocation(), Radius, Count, PreFinishSpawning);
+}
+
+TArray<AMTD_BaseCharacter*> AMTD_CharacterSpawner::SpawnWave(const FVector &Center, float Radius, int32 Count,
+    const TFunction<void(AMTD_BaseCharacter*)> &PreFinishSpawning) const
+{
+    TArray<AMTD_BaseCharacter*> Wave;
+    Wave.Reserve(Count);
+
+    // Sunflower pattern: turning by the golden angle from one character to the next never lines them up, and the
+    // square root keeps the density even from the center to the edge
+    const float GoldenAngle = PI * (3.f - FMath::Sqrt(5.f));
+    for (int32 i = 0; i < Count; i++)
+    {
+        const float Distance = Radius * FMath::Sqrt((i + 0.5f) / Count);
+        const float Angle = i * GoldenAngle;
+        const FVector Offset(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f);
+
+        AMTD_BaseCharacter *Character = SpawnCharacter(FTransform(Center + Offset), PreFinishSpawning);
+        if (IsValid(Character))
+        {
+            Wave.Add(Character);
+        }
+    }
+
+    return Wave;
 }
@@ -0,0 +1,102 @@
+#include "Character/MTD_ComboComponent.h"
+
+UMTD_ComboComponent::UMTD_ComboComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+int32 UMTD_ComboComponent::AdvanceCombo(float ComboWindow)
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    // A combo can't last less than a moment, even if no window is given
+    const float Window = FMath::Max(ComboWindow, 0.01f);
+
+    int32 ComboIndex = 0;
+    if (IsComboActive())
+    {
+        ComboLevel++;
+        ComboIndex = ComboLevel;
+    }
+    else
+    {
+        ComboLevel = 1;
+    }
+
+    ComboExpireTime = Now + Window;
+    return ComboIndex;
+}
+
+void UMTD_ComboComponent::ResetCombo()
+{
+    ComboLevel = 0;
+    ComboExpireTime = 0.0;
+}
+
+bool UMTD_ComboComponent::IsComboActive() const
+{
+    return ((ComboLevel > 0) && (GetWorld()->GetTimeSeconds() < ComboExpireTime));
+}
+
+int32 UMTD_ComboComponent::GetComboIndex() const
+{
+    if (!IsComboActive())
+    {
+        return -1;
+    }
+
+    return (ComboLevel == 1) ? (0) : (ComboLevel);
+}
+
+float UMTD_ComboComponent::GetComboDamageMultiplier() const
+{
+    const int32 Steps = (IsComboActive()) ? (ComboLevel - 1) : (0);
+    return 1.f + DamageMultiplierPerComboStep * Steps;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs ComboSequenceCheckCommand(
+    TEXT("mtd.ComboSequenceCheck"),
+    TEXT("Check that combo of the first player yields the same indices as attack gameplay effect levels used to."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        const APlayerController *PlayerController = (IsValid(World)) ? (World->GetFirstPlayerController()) : (nullptr);
+        const APawn *Pawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+        UMTD_ComboComponent *ComboComponent = UMTD_ComboComponent::FindComboComponent(Pawn);
+
+        if (!IsValid(ComboComponent))
+        {
+            MTD_WARN("First player has no combo component.");
+            return;
+        }
+
+        // Attack GE used to be applied with level 1 reporting index 0, and raised by one level on each next attack
+        const int32 Attacks = (Args.IsValidIndex(0)) ? (FMath::Max(FCString::Atoi(*Args[0]), 1)) : (5);
+        int32 Mismatches = 0;
+
+        // World time doesn't change within the command, so each attack happens inside the combo window
+        ComboComponent->ResetCombo();
+        for (int32 Attack = 0; Attack < Attacks; Attack++)
+        {
+            const int32 Expected = (Attack == 0) ? (0) : (Attack + 1);
+            const int32 ComboIndex = ComboComponent->AdvanceCombo(0.f);
+            if ((ComboIndex != Expected) || (ComboComponent->GetComboIndex() != Expected))
+            {
+                MTD_WARN("Attack [%d] has combo index [%d], expected [%d].", Attack, ComboIndex, Expected);
+                Mismatches++;
+            }
+        }
+
+        // Expired combo has to start over
+        ComboComponent->ResetCombo();
+        if ((ComboComponent->GetComboIndex() != -1) || (ComboComponent->AdvanceCombo(0.f) != 0))
+        {
+            MTD_WARN("Combo has not started over after a reset.");
+            Mismatches++;
+        }
+        ComboComponent->ResetCombo();
+
+        MTD_LOG("Combo sequence check finished with [%d] mismatch(es) over [%d] attack(s).", Mismatches, Attacks);
+    }));
+#endif
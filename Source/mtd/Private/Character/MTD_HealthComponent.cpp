@@ -3,6 +3,7 @@
 #include "AbilitySystem/Attributes/MTD_HealthSet.h"
 #include "AbilitySystem/MTD_AbilitySystemComponent.h"
 #include "AbilitySystem/MTD_GameplayTags.h"
+#include "CombatSystem/MTD_LiteCombat.h"
 #include "GameplayEffectExtension.h"
 
 UMTD_HealthComponent::UMTD_HealthComponent()
@@ -41,6 +42,7 @@ void UMTD_HealthComponent::InitializeWithAbilitySystem(UMTD_AbilitySystemCompone
         UMTD_HealthSet::GetHealthAttribute()).AddUObject(this, &ThisClass::OnHealthChanged);
     AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
         UMTD_HealthSet::GetMaxHealthAttribute()).AddUObject(this, &ThisClass::OnMaxHealthChanged);
+    AbilitySystemComponent->OnAttributesInitializedDelegate.AddUObject(this, &ThisClass::OnAttributesInitialized);
 
     HealthSet->OnOutOfHealthDelegate.AddUObject(this, &ThisClass::OnOutOfHealth);
 
@@ -55,30 +57,83 @@ void UMTD_HealthComponent::UninitializeFromAbilitySystem()
         HealthSet->OnOutOfHealthDelegate.RemoveAll(this);
     }
 
+    if (AbilitySystemComponent)
+    {
+        AbilitySystemComponent->OnAttributesInitializedDelegate.RemoveAll(this);
+    }
+
     HealthSet = nullptr;
     AbilitySystemComponent = nullptr;
+    LiteStats = nullptr;
+}
+
+void UMTD_HealthComponent::InitializeWithLiteStats(FMTD_LiteCombatStats *InLiteStats)
+{
+    const AActor *Owner = GetOwner();
+    check(Owner);
+
+    if ((AbilitySystemComponent) || (LiteStats))
+    {
+        MTDS_ERROR("Health component for owner [%s] has already been initilized", *Owner->GetName());
+        return;
+    }
+
+    LiteStats = InLiteStats;
+    if (!LiteStats)
+    {
+        MTDS_ERROR("Cannot initilize health component for owner [%s] with NULL lite stats", *Owner->GetName());
+        return;
+    }
+
+    OnHealthChangedDelegate.Broadcast(this, LiteStats->Health, LiteStats->Health, nullptr);
+    OnMaxHealthChangedDelegate.Broadcast(this, LiteStats->MaxHealth, LiteStats->MaxHealth, nullptr);
+}
+
+void UMTD_HealthComponent::ApplyLiteDamage(float Damage, AActor *DamageInstigator)
+{
+    if ((!LiteStats) || (IsDeadOrDying()))
+    {
+        return;
+    }
+
+    const float OldHealth = LiteStats->Health;
+    LiteStats->Health = FMath::Clamp(OldHealth - Damage, 0.f, LiteStats->MaxHealth);
+
+    if (LiteStats->Health != OldHealth)
+    {
+        OnHealthChangedDelegate.Broadcast(this, OldHealth, LiteStats->Health, DamageInstigator);
+    }
+
+    if ((OldHealth > 0.f) && (LiteStats->Health <= 0.f))
+    {
+        StartDeath();
+    }
 }
 
 float UMTD_HealthComponent::GetHealth() const
 {
+    if (LiteStats)
+    {
+        return LiteStats->Health;
+    }
     return (IsValid(HealthSet)) ? (HealthSet->GetHealth()) : (0.f);
 }
 
 float UMTD_HealthComponent::GetMaxHealth() const
 {
+    if (LiteStats)
+    {
+        return LiteStats->MaxHealth;
+    }
     return (IsValid(HealthSet)) ? (HealthSet->GetMaxHealth()) : (0.f);
 }
 
 float UMTD_HealthComponent::GetHealthNormilized() const
 {
-    if (IsValid(HealthSet))
-    {
-        const float Health = HealthSet->GetHealth();
-        const float MaxHealth = HealthSet->GetMaxHealth();
+    const float Health = GetHealth();
+    const float MaxHealth = GetMaxHealth();
 
-        return (MaxHealth > 0.f) ? (Health / MaxHealth) : (0.f);
-    }
-    return 0.f;
+    return (MaxHealth > 0.f) ? (Health / MaxHealth) : (0.f);
 }
 
 void UMTD_HealthComponent::StartDeath()
@@ -157,6 +212,21 @@ void UMTD_HealthComponent::OnMaxHealthChanged(const FOnAttributeChangeData &Chan
         GetInstigatorFromAttrChangeData(ChangeData));
 }
 
+void UMTD_HealthComponent::OnAttributesInitialized(TConstArrayView<FMTD_AttributeInitChange> Changes)
+{
+    for (const FMTD_AttributeInitChange &Change : Changes)
+    {
+        if (Change.Attribute == UMTD_HealthSet::GetHealthAttribute())
+        {
+            OnHealthChangedDelegate.Broadcast(this, Change.OldValue, Change.NewValue, nullptr);
+        }
+        else if (Change.Attribute == UMTD_HealthSet::GetMaxHealthAttribute())
+        {
+            OnMaxHealthChangedDelegate.Broadcast(this, Change.OldValue, Change.NewValue, nullptr);
+        }
+    }
+}
+
 void UMTD_HealthComponent::OnOutOfHealth(
     AActor *DamageInstigator,
     AActor *DamageCauser,
@@ -176,7 +176,7 @@ void UMTD_HeroComponent::InitializePlayerInput(UInputComponent *InputComponent)
         MTDS_WARN("Player Data on Player [%s] is invalid.", *Player->GetName());
     }
 
-    const FMTD_GameplayTags GameplayTags = FMTD_GameplayTags::Get();
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
     UMTD_InputConfig *InputConfig = PlayerData->InputConfig;
     if (!IsValid(InputConfig))
     {
@@ -40,6 +40,7 @@ void UMTD_ManaComponent::InitializeWithAbilitySystem(UMTD_AbilitySystemComponent
         UMTD_ManaSet::GetManaAttribute()).AddUObject(this, &ThisClass::OnManaChanged);
     AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
         UMTD_ManaSet::GetMaxManaAttribute()).AddUObject(this, &ThisClass::OnMaxManaChanged);
+    AbilitySystemComponent->OnAttributesInitializedDelegate.AddUObject(this, &ThisClass::OnAttributesInitialized);
 
     OnManaChangedDelegate.Broadcast(this, ManaSet->GetMana(), ManaSet->GetMana(), nullptr);
     OnMaxManaChangedDelegate.Broadcast(this, ManaSet->GetMaxMana(), ManaSet->GetMaxMana(), nullptr);
@@ -47,6 +48,11 @@ void UMTD_ManaComponent::InitializeWithAbilitySystem(UMTD_AbilitySystemComponent
 
 void UMTD_ManaComponent::UninitializeFromAbilitySystem()
 {
+    if (AbilitySystemComponent)
+    {
+        AbilitySystemComponent->OnAttributesInitializedDelegate.RemoveAll(this);
+    }
+
     ManaSet = nullptr;
     AbilitySystemComponent = nullptr;
 }
@@ -96,3 +102,18 @@ void UMTD_ManaComponent::OnMaxManaChanged(const FOnAttributeChangeData &ChangeDa
     OnMaxManaChangedDelegate.Broadcast(
         this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
 }
+
+void UMTD_ManaComponent::OnAttributesInitialized(TConstArrayView<FMTD_AttributeInitChange> Changes)
+{
+    for (const FMTD_AttributeInitChange &Change : Changes)
+    {
+        if (Change.Attribute == UMTD_ManaSet::GetManaAttribute())
+        {
+            OnManaChangedDelegate.Broadcast(this, Change.OldValue, Change.NewValue, nullptr);
+        }
+        else if (Change.Attribute == UMTD_ManaSet::GetMaxManaAttribute())
+        {
+            OnMaxManaChangedDelegate.Broadcast(this, Change.OldValue, Change.NewValue, nullptr);
+        }
+    }
+}
@@ -128,7 +128,7 @@ bool UMTD_PawnExtensionComponent::CheckPawnReadyToInitialize()
     const bool bHasAuthority = Pawn->HasAuthority();
     const bool bIsLocallyControlled = Pawn->IsLocallyControlled();
 
-    if ((bHasAuthority) || (bIsLocallyControlled))
+    if ((bRequiresController) && ((bHasAuthority) || (bIsLocallyControlled)))
     {
         // Check for being possessed by a controller
         if (!IsValid(Pawn->GetController()))
@@ -157,6 +157,12 @@ bool UMTD_PawnExtensionComponent::CheckPawnReadyToInitialize()
     return true;
 }
 
+void UMTD_PawnExtensionComponent::SetRequiresController(bool bInRequiresController)
+{
+    bRequiresController = bInRequiresController;
+    CheckPawnReadyToInitialize();
+}
+
 void UMTD_PawnExtensionComponent::OnPawnReadyToInitialize_RegisterAndCall(FSimpleMulticastDelegate::FDelegate Delegate)
 {
     if (!OnPawnReadyToInitialize.IsBoundToObject(Delegate.GetUObject()))
@@ -199,19 +205,33 @@ FMTD_AbilityAnimations UMTD_PawnExtensionComponent::GetAbilityAnimMontages(FGame
 
 UAnimMontage *UMTD_PawnExtensionComponent::GetRandomAnimMontage(FGameplayTag AbilityTag) const
 {
-    const TArray<TObjectPtr<UAnimMontage>> Anims = GetAbilityAnimMontages(AbilityTag).Animations;
-    const int32 Size = Anims.Num();
+    const FMTD_AbilityAnimations *Found =
+        (IsValid(AnimationSet)) ? (AnimationSet->FindAbilityAnimMontages(AbilityTag)) : (nullptr);
+    const int32 Size = (Found) ? (Found->Animations.Num()) : (0);
     if (Size == 0)
     {
         return nullptr;
     }
 
     const int32 Index = FMath::RandRange(0, Size - 1);
-    UAnimMontage *Anim = Anims[Index];
+    UAnimMontage *Anim = Found->Animations[Index];
 
     return Anim;
 }
 
+UAnimMontage *UMTD_PawnExtensionComponent::GetComboAnimMontage(FGameplayTag AbilityTag, int32 ComboIndex) const
+{
+    const FMTD_AbilityAnimations *Found =
+        (IsValid(AnimationSet)) ? (AnimationSet->FindAbilityAnimMontages(AbilityTag)) : (nullptr);
+    const int32 Size = (Found) ? (Found->Animations.Num()) : (0);
+    if ((Size == 0) || (ComboIndex < 0))
+    {
+        return nullptr;
+    }
+
+    return Found->Animations[ComboIndex % Size];
+}
+
 void UMTD_PawnExtensionComponent::OnRegister()
 {
     Super::OnRegister();
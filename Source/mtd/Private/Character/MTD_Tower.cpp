@@ -7,7 +7,9 @@
 #include "AbilitySystem/MTD_GameplayTags.h"
 #include "AbilitySystemGlobals.h"
 #include "AbilitySystem/Attributes/MTD_BalanceSet.h"
+#include "AbilitySystem/Attributes/MTD_CombatSet.h"
 #include "AbilitySystem/Attributes/MTD_HealthSet.h"
+#include "AbilitySystem/Attributes/MTD_PlayerSet.h"
 #include "Character/MTD_CharacterCoreTypes.h"
 #include "Character/MTD_HealthComponent.h"
 #include "Character/MTD_HeroComponent.h"
@@ -15,13 +17,26 @@
 #include "Components/BoxComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SphereComponent.h"
+#include "EngineUtils.h"
 #include "GameModes/MTD_GameModeBase.h"
-#include "Kismet/DataTableFunctionLibrary.h"
 #include "Player/MTD_PlayerState.h"
 #include "Player/MTD_TowerController.h"
 #include "Projectile/MTD_Projectile.h"
 #include "Projectile/MTD_ProjectileMovementComponent.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Spec Builds"), STAT_MtdProjectileSpecBuilds, STATGROUP_Mtd);
+
+/** Source attributes the projectile gameplay effects capture. */
+static TArray<FGameplayAttribute, TInlineAllocator<4>> GetProjectileSourceAttributes()
+{
+    return {
+        UMTD_BalanceSet::GetDamageAttribute(),
+        UMTD_CombatSet::GetDamageAdditiveAttribute(),
+        UMTD_CombatSet::GetDamageMultiplierAttribute(),
+        UMTD_PlayerSet::GetDamageStatAttribute()
+    };
+}
+
 AMTD_Tower::AMTD_Tower()
 {
     PrimaryActorTick.bCanEverTick = true;
@@ -228,41 +243,48 @@ void AMTD_Tower::InitializeAttributes()
     // vision related data along the owner player stats. The spawned tower will have PlayerCharacter as Owner and its
     // PlayerState as Instigator.
 
+    const FMTD_AttributeCurveCache &AttributeCache = TowerData->GetAttributeCache();
     float Value;
 
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, DamageAttributeName, Level, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, DamageAttributeName, Level, Value);
     BaseDamage = Value;
     
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, RangeAttributeName, Level, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, RangeAttributeName, Level, Value);
     BaseVisionRange = Value;
     
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, VisionDegreesAttributeName, Level, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, VisionDegreesAttributeName, Level, Value);
     BaseVisionHalfDegrees = Value / 2.f;
     
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, FirerateAttributeName, Level, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, FirerateAttributeName, Level, Value);
     BaseFirerate = Value;
     
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, ProjectileSpeedAttributeName, Level, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, ProjectileSpeedAttributeName, Level, Value);
     BaseProjectileSpeed = Value;
     
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, BalanceDamageAttributeName, Level, Value);
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, BalanceDamageAttributeName, Level, Value);
     BalanceDamage = Value;
 
-    UAbilitySystemComponent *Asc = GetAbilitySystemComponent();
-    if (!IsValid(Asc))
+    UMTD_AbilitySystemComponent *MtdAsc = GetMtdAbilitySystemComponent();
+    if (!IsValid(MtdAsc))
     {
         MTDS_WARN("Ability System Component on Tower [%s] is invalid.", *GetName());
         return;
     }
     
-    EVALUTE_ATTRIBUTE(TowerData->AttributeTable, HealthAttributeName, Level, Value);
-    Asc->ApplyModToAttribute(UMTD_HealthSet::GetMaxHealthAttribute(), EGameplayModOp::Type::Override, Value);
-    Asc->ApplyModToAttribute(UMTD_HealthSet::GetHealthAttribute(), EGameplayModOp::Type::Override, Value);
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetDamageAttribute(), EGameplayModOp::Type::Override, BalanceDamage);
+    TArray<FMTD_AttributeInitValue, TInlineAllocator<8>> InitValues;
+    
+    EVALUATE_CACHED_ATTRIBUTE(AttributeCache, HealthAttributeName, Level, Value);
+    InitValues.Add({ UMTD_HealthSet::GetMaxHealthAttribute(), Value });
+    InitValues.Add({ UMTD_HealthSet::GetHealthAttribute(), Value });
+    InitValues.Add({ UMTD_BalanceSet::GetDamageAttribute(), BalanceDamage });
 
     // Tower ignore any balance damage
-    Asc->ApplyModToAttribute(UMTD_BalanceSet::GetResistAttribute(), EGameplayModOp::Type::Override, 100.f);
-    
+    InitValues.Add({ UMTD_BalanceSet::GetResistAttribute(), 100.f });
+
+    MtdAsc->InitializeAttributeValues(InitValues);
+
+    // Specs capture source attributes, hence rebuild them before the next shot
+    bProjectileGameplayEffectSpecsDirty = true;
 
     OnAttributesChanged.Broadcast();
     MTDS_VERBOSE("Tower [%s]'s attributes have been initialized.", *GetName());
@@ -352,7 +374,13 @@ void AMTD_Tower::SetupProjectile(AMTD_Projectile &Projectile, AActor *FireTarget
     SetupProjectileHitCallback();
     SetupProjectileGameplayEffectClasses(Projectile);
 
+    const auto TowerData = TowerExtensionComponent->GetTowerData<UMTD_TowerData>();
+    const FMTD_ProjectileParameters &Parameters = TowerData->ProjectileData->ProjectileParameters;
+
     Projectile.BalanceDamage = BalanceDamage;
+    Projectile.bIsRadial = Parameters.bIsRadial;
+    Projectile.RadialDamageRadius = Parameters.RadialDamageRadius;
+    Projectile.RadialDamageEdgeMultiplier = Parameters.RadialDamageEdgeMultiplier;
 }
 
 void AMTD_Tower::SetupProjectileCollision(AMTD_Projectile &Projectile) const
@@ -376,18 +404,59 @@ void AMTD_Tower::SetupProjectileMovement(AMTD_Projectile &Projectile, AActor *Fi
     MovementComponent->AddAcceleration(Speed);
 }
 
-void AMTD_Tower::SetupProjectileGameplayEffectClasses(AMTD_Projectile &Projectile) const
+void AMTD_Tower::SetupProjectileGameplayEffectClasses(AMTD_Projectile &Projectile)
 {
-    const auto TowerData = TowerExtensionComponent->GetTowerData<UMTD_TowerData>();
-    const UMTD_ProjectileData *ProjectileData = TowerData->ProjectileData;
-    
     Projectile.Damage = GetScaledDamage();
     Projectile.DamageMultiplier = 1.f;
 
-    for (const TSubclassOf<UMTD_GameplayEffect> &Ge : ProjectileData->GameplayEffectsToGrantClasses)
+    if ((bProjectileGameplayEffectSpecsDirty) || (ProjectileGameplayEffectSpecsLevel != Level))
     {
-        Projectile.AddGameplayEffectClassToGrantOnHit(Ge);
+        BuildProjectileGameplayEffectSpecs();
     }
+
+    // Projectiles share the handles, their damage is patched into the specs on hit
+    Projectile.AddGameplayEffectSpecsToGrantOnHit(ProjectileGameplayEffectSpecs);
+}
+
+void AMTD_Tower::BuildProjectileGameplayEffectSpecs()
+{
+    INC_DWORD_STAT(STAT_MtdProjectileSpecBuilds);
+
+    bProjectileGameplayEffectSpecsDirty = false;
+    ProjectileGameplayEffectSpecsLevel = Level;
+    ProjectileGameplayEffectSpecs.Reset();
+
+    const UAbilitySystemComponent *Asc = GetAbilitySystemComponent();
+    const auto TowerData = TowerExtensionComponent->GetTowerData<UMTD_TowerData>();
+    if ((!IsValid(Asc)) || (!IsValid(TowerData)) || (!IsValid(TowerData->ProjectileData)))
+    {
+        return;
+    }
+
+    TArray<TSubclassOf<UMTD_GameplayEffect>> GeClasses;
+    GetProjectileGameplayEffectClasses(*TowerData->ProjectileData, GeClasses);
+
+    AMTD_Projectile::MakeSharedGameplayEffectSpecs(*Asc, GeClasses, Level, ProjectileGameplayEffectSpecs);
+}
+
+void AMTD_Tower::GetProjectileGameplayEffectClasses(
+    const UMTD_ProjectileData &ProjectileData,
+    TArray<TSubclassOf<UMTD_GameplayEffect>> &OutGeClasses) const
+{
+    // The data's extra effects, followed by the balance damage and damage the projectile class applies on every hit
+    OutGeClasses.Append(ProjectileData.GameplayEffectsToGrantClasses);
+
+    const TSubclassOf<AMTD_Projectile> ProjectileClass = ProjectileData.ProjectileClass;
+    if (ProjectileClass)
+    {
+        ProjectileClass->GetDefaultObject<AMTD_Projectile>()->GetHitGameplayEffectClasses(OutGeClasses);
+    }
+}
+
+void AMTD_Tower::OnProjectileSourceAttributeChanged(const FOnAttributeChangeData &ChangeData)
+{
+    // Specs snapshot the source attributes they capture, hence rebuild them before the next shot
+    bProjectileGameplayEffectSpecsDirty = true;
 }
 
 void AMTD_Tower::SetupProjectileHitCallback()
@@ -413,11 +482,26 @@ void AMTD_Tower::OnAbilitySystemInitialized()
     check(MtdAsc);
 
     HealthComponent->InitializeWithAbilitySystem(MtdAsc);
+
+    for (const FGameplayAttribute &Attribute : GetProjectileSourceAttributes())
+    {
+        MtdAsc->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(
+            this, &ThisClass::OnProjectileSourceAttributeChanged);
+    }
 }
 
 void AMTD_Tower::OnAbilitySystemUninitialized()
 {
     HealthComponent->UninitializeFromAbilitySystem();
+
+    UMTD_AbilitySystemComponent *MtdAsc = GetMtdAbilitySystemComponent();
+    if (IsValid(MtdAsc))
+    {
+        for (const FGameplayAttribute &Attribute : GetProjectileSourceAttributes())
+        {
+            MtdAsc->GetGameplayAttributeValueChangeDelegate(Attribute).RemoveAll(this);
+        }
+    }
 }
 
 void AMTD_Tower::DestroyDueToDeath()
@@ -474,3 +558,93 @@ UAbilitySystemComponent *AMTD_Tower::GetAbilitySystemComponent() const
 {
     return GetMtdAbilitySystemComponent();
 }
+
+#if !UE_BUILD_SHIPPING
+void AMTD_Tower::RunProjectileSpecBenchmark(int32 Count)
+{
+    const UAbilitySystemComponent *Asc = GetAbilitySystemComponent();
+    const auto TowerData = TowerExtensionComponent->GetTowerData<UMTD_TowerData>();
+    if ((!IsValid(Asc)) || (!IsValid(TowerData)) || (!IsValid(TowerData->ProjectileData)))
+    {
+        MTDS_WARN("Tower [%s] has no ability system component or projectile data.", *GetName());
+        return;
+    }
+
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+    const float Damage = GetScaledDamage();
+
+    TArray<TSubclassOf<UMTD_GameplayEffect>> GeClasses;
+    GetProjectileGameplayEffectClasses(*TowerData->ProjectileData, GeClasses);
+
+    const FHitResult HitResult(this, nullptr, GetActorLocation(), GetActorForwardVector());
+
+    // Old way: make a context and a spec per gameplay effect on every hit. Each of them is a heap allocation
+    int32 Allocations = 0;
+    double StartSeconds = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Count; i++)
+    {
+        FGameplayEffectContextHandle GeContextHandle = Asc->MakeEffectContext();
+        GeContextHandle.AddHitResult(HitResult, true);
+        Allocations++;
+
+        for (const TSubclassOf<UMTD_GameplayEffect> &GeClass : GeClasses)
+        {
+            FGameplayEffectSpecHandle SpecHandle = Asc->MakeOutgoingSpec(GeClass, Level, GeContextHandle);
+            if (SpecHandle.IsValid())
+            {
+                SpecHandle.Data->SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Base, Damage);
+                SpecHandle.Data->SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Multiplier, 1.f);
+                Allocations++;
+            }
+        }
+    }
+    const double PerHitSeconds = (FPlatformTime::Seconds() - StartSeconds) / FMath::Max(Count, 1);
+    const int32 PerHitAllocations = Allocations;
+
+    // New way: a context per hit patched into the shared specs, which are made once
+    Allocations = 0;
+    StartSeconds = FPlatformTime::Seconds();
+    BuildProjectileGameplayEffectSpecs();
+    Allocations += ProjectileGameplayEffectSpecs.Num();
+    for (int32 i = 0; i < Count; i++)
+    {
+        FGameplayEffectContextHandle GeContextHandle = Asc->MakeEffectContext();
+        GeContextHandle.AddHitResult(HitResult, true);
+        Allocations++;
+
+        for (const FGameplayEffectSpecHandle &SpecHandle : ProjectileGameplayEffectSpecs)
+        {
+            SpecHandle.Data->SetContext(GeContextHandle, true);
+            SpecHandle.Data->SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Base, Damage);
+            SpecHandle.Data->SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Multiplier, 1.f);
+        }
+    }
+    const double CachedPerHitSeconds = (FPlatformTime::Seconds() - StartSeconds) / FMath::Max(Count, 1);
+    const int32 CachedAllocations = Allocations;
+
+    MTD_LOG("%d hits with %d gameplay effects: %.3f us per hit and %d spec and context allocations with new specs, "
+        "%.3f us per hit and %d allocations with cached specs.", Count, GeClasses.Num(), PerHitSeconds * 1000000.0,
+        PerHitAllocations, CachedPerHitSeconds * 1000000.0, CachedAllocations);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ProjectileSpecBenchmarkCommand(
+    TEXT("mtd.ProjectileSpecBenchmark"),
+    TEXT("Time preparing projectile specs of the first tower. Usage: mtd.ProjectileSpecBenchmark [Count=10000]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        if (!IsValid(World))
+        {
+            return;
+        }
+
+        TActorIterator<AMTD_Tower> It(World);
+        if (!It)
+        {
+            MTD_WARN("There are no towers in the world.");
+            return;
+        }
+
+        const int32 Count = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (10000);
+        It->RunProjectileSpecBenchmark(Count);
+    }));
+#endif
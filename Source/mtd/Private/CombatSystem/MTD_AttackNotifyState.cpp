@@ -1,6 +1,23 @@
 #include "CombatSystem/MTD_AttackNotifyState.h"
 
 #include "CombatSystem/MTD_MeleeEventsInterface.h"
+#include "CombatSystem/MTD_MeleeHitboxData.h"
+
+void UMTD_AttackNotifyState::PostLoad()
+{
+    Super::PostLoad();
+
+    CacheMeleeHitboxIds();
+}
+
+#if WITH_EDITOR
+void UMTD_AttackNotifyState::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    CacheMeleeHitboxIds();
+}
+#endif
 
 void UMTD_AttackNotifyState::NotifyBegin(USkeletalMeshComponent *MeshComp, UAnimSequenceBase *Animation,
     float TotalDuration)
@@ -10,7 +27,13 @@ void UMTD_AttackNotifyState::NotifyBegin(USkeletalMeshComponent *MeshComp, UAnim
     
     if (Interface)
     {
-        Interface->AddMeleeHitboxes(MeleeHitboxNicknames);
+        // Notifies created at runtime are never loaded
+        if (MeleeHitboxIds.Num() != MeleeHitboxNicknames.Num())
+        {
+            CacheMeleeHitboxIds();
+        }
+
+        Interface->AddMeleeHitboxesById(MeleeHitboxIds);
     }
 }
 
@@ -21,6 +44,15 @@ void UMTD_AttackNotifyState::NotifyEnd(USkeletalMeshComponent *MeshComp, UAnimSe
     
     if (Interface)
     {
-        Interface->RemoveMeleeHitboxes(MeleeHitboxNicknames);
+        Interface->RemoveMeleeHitboxesById(MeleeHitboxIds);
+    }
+}
+
+void UMTD_AttackNotifyState::CacheMeleeHitboxIds()
+{
+    MeleeHitboxIds.Reset(MeleeHitboxNicknames.Num());
+    for (const FName &Nickname : MeleeHitboxNicknames)
+    {
+        MeleeHitboxIds.Add(FMTD_MeleeHitboxIds::FindOrAdd(Nickname));
     }
 }
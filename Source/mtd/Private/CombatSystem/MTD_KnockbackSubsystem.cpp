@@ -0,0 +1,231 @@
+#include "CombatSystem/MTD_KnockbackSubsystem.h"
+
+#include "AbilitySystem/MTD_DamageSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Character/MTD_BalanceComponent.h"
+#include "Character/MTD_BaseEnemyCharacter.h"
+#include "Character/MTD_CharacterSpawner.h"
+#include "Character/MTD_HealthComponent.h"
+#include "CombatSystem/MTD_LiteCombat.h"
+#include "EngineUtils.h"
+#include "Player/MTD_EnemyController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Knockbacks"), STAT_MtdKnockbacks, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Knockbacks Applied"), STAT_MtdKnockbacksApplied, STATGROUP_Mtd);
+
+UMTD_KnockbackSubsystem *UMTD_KnockbackSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<UMTD_KnockbackSubsystem>()) : (nullptr);
+}
+
+bool UMTD_KnockbackSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void UMTD_KnockbackSubsystem::Deinitialize()
+{
+    PendingKnockbacks.Empty();
+    ActiveKnockbacks.Empty();
+
+    Super::Deinitialize();
+}
+
+void UMTD_KnockbackSubsystem::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if ((PendingKnockbacks.IsEmpty()) && (ActiveKnockbacks.IsEmpty()))
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_MtdKnockbacks);
+
+    const double NowSeconds = GetWorld()->GetTimeSeconds();
+    ExpireKnockbacks(NowSeconds);
+    ApplyKnockbacks(NowSeconds);
+}
+
+TStatId UMTD_KnockbackSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMTD_KnockbackSubsystem, STATGROUP_Tickables);
+}
+
+void UMTD_KnockbackSubsystem::QueueKnockback(AMTD_EnemyController *Controller, const FMTD_BalanceHit &HitData)
+{
+    if ((IsValid(Controller)) && (!Controller->bKnockback))
+    {
+        PendingKnockbacks.Add(Controller);
+    }
+}
+
+int32 UMTD_KnockbackSubsystem::ApplyKnockbacks(double NowSeconds)
+{
+    int32 Applied = 0;
+    const double EndSeconds = NowSeconds + KnockbackKeySeconds;
+    for (const TWeakObjectPtr<AMTD_EnemyController> &WeakController : PendingKnockbacks)
+    {
+        // A controller may have been queued several times during the frame
+        AMTD_EnemyController *Controller = WeakController.Get();
+        if ((!IsValid(Controller)) || (Controller->bKnockback))
+        {
+            continue;
+        }
+
+        Controller->SetKnockback(true);
+
+        FActiveKnockback &Knockback = ActiveKnockbacks.AddDefaulted_GetRef();
+        Knockback.Controller = Controller;
+        Knockback.EndSeconds = EndSeconds;
+
+        Applied++;
+    }
+
+    INC_DWORD_STAT_BY(STAT_MtdKnockbacksApplied, Applied);
+    PendingKnockbacks.Reset();
+
+    return Applied;
+}
+
+void UMTD_KnockbackSubsystem::ExpireKnockbacks(double NowSeconds)
+{
+    int32 Expired = 0;
+    while ((Expired < ActiveKnockbacks.Num()) && (ActiveKnockbacks[Expired].EndSeconds <= NowSeconds))
+    {
+        AMTD_EnemyController *Controller = ActiveKnockbacks[Expired].Controller.Get();
+        if (IsValid(Controller))
+        {
+            Controller->SetKnockback(false);
+        }
+        Expired++;
+    }
+
+    ActiveKnockbacks.RemoveAt(0, Expired, false);
+}
+
+#if !UE_BUILD_SHIPPING
+void UMTD_KnockbackSubsystem::RunKnockbackBenchmark(const TArray<AMTD_BaseEnemyCharacter*> &Wave, int32 Rounds)
+{
+    Rounds = FMath::Max(Rounds, 1);
+
+    TArray<AMTD_BaseEnemyCharacter*> Enemies;
+    for (AMTD_BaseEnemyCharacter *Enemy : Wave)
+    {
+        if ((IsValid(Enemy)) && (IsValid(Enemy->GetBalanceComponent())) &&
+            (!Enemy->GetHealthComponent()->IsDeadOrDying()))
+        {
+            Enemies.Add(Enemy);
+        }
+    }
+
+    if (Enemies.IsEmpty())
+    {
+        MTD_WARN("There are no enemies to knock back.");
+        return;
+    }
+
+    UMTD_DamageSubsystem *DamageSubsystem = UMTD_DamageSubsystem::Get(this);
+
+    // Enough to surpass any balance threshold, while no health damage is dealt
+    constexpr float BalanceDamage = 1000000.f;
+
+    FMTD_DamageHit Hit;
+    Hit.DamageBase = 0.f;
+    Hit.bBalanceDamage = true;
+    Hit.BalanceDamage = BalanceDamage;
+    Hit.KnockbackDirection = FVector::ForwardVector;
+
+    // Hits are resolved the way real ones are: natively for lite enemies, and through the balance damage gameplay
+    // effect, the balance set and the knockback gameplay event for the others. Every round knocks the whole wave back
+    // once, and ends their knockbacks, hence the next one knocks them back again
+    int32 Applied = 0;
+    const int32 StartObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 Round = 0; Round < Rounds; Round++)
+    {
+        for (AMTD_BaseEnemyCharacter *Enemy : Enemies)
+        {
+            if (FMTD_LiteCombat::ApplyHit(Enemy, 0.f, BalanceDamage, FVector::ForwardVector, nullptr))
+            {
+                continue;
+            }
+
+            Hit.Target = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Enemy);
+            if (IsValid(DamageSubsystem))
+            {
+                DamageSubsystem->QueueDamage(Hit);
+            }
+        }
+
+        if (IsValid(DamageSubsystem))
+        {
+            DamageSubsystem->FlushDamage();
+        }
+
+        Applied += ApplyKnockbacks(0.0);
+        ExpireKnockbacks(MAX_dbl);
+    }
+    const double EndSeconds = FPlatformTime::Seconds();
+    const int32 CreatedObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjects;
+
+    const int32 Hits = Enemies.Num() * Rounds;
+    MTD_LOG("%d enemies knocked back for %d rounds: %.3f us per hit, %d knockbacks applied out of %d hits, "
+        "%d objects created.", Enemies.Num(), Rounds, (EndSeconds - StartSeconds) * 1000000.0 / Hits, Applied, Hits,
+        CreatedObjects);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs KnockbackBenchmarkCommand(
+    TEXT("mtd.KnockbackBenchmark"),
+    TEXT("Knock a wave spawned by the first character spawner back with balance hits repeatedly. "
+        "Usage: mtd.KnockbackBenchmark [Enemies=300] [Rounds=100]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_KnockbackSubsystem *KnockbackSubsystem = UMTD_KnockbackSubsystem::Get(World);
+        if (!IsValid(KnockbackSubsystem))
+        {
+            return;
+        }
+
+        TActorIterator<AMTD_CharacterSpawner> SpawnerIt(World);
+        if (!SpawnerIt)
+        {
+            MTD_WARN("There are no character spawners.");
+            return;
+        }
+
+        const int32 EnemyCount = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (300);
+        const int32 Rounds = (Args.IsValidIndex(1)) ? (FCString::Atoi(*Args[1])) : (100);
+
+        TArray<TWeakObjectPtr<AMTD_BaseEnemyCharacter>> Wave;
+        for (AMTD_BaseCharacter *Character : SpawnerIt->SpawnWave(EnemyCount))
+        {
+            Wave.Add(Cast<AMTD_BaseEnemyCharacter>(Character));
+        }
+
+        // Knockbacks go through the blackboards, give the controllers a moment after possess to set them up
+        FTimerHandle TimerHandle;
+        World->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateWeakLambda(KnockbackSubsystem,
+            [KnockbackSubsystem, Wave, Rounds]()
+            {
+                TArray<AMTD_BaseEnemyCharacter*> Enemies;
+                for (const TWeakObjectPtr<AMTD_BaseEnemyCharacter> &Enemy : Wave)
+                {
+                    if (Enemy.IsValid())
+                    {
+                        Enemies.Add(Enemy.Get());
+                    }
+                }
+
+                KnockbackSubsystem->RunKnockbackBenchmark(Enemies, Rounds);
+
+                for (AMTD_BaseEnemyCharacter *Enemy : Enemies)
+                {
+                    Enemy->Destroy();
+                }
+            }), 0.1f, false);
+    }));
+#endif
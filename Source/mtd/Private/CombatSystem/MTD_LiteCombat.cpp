@@ -0,0 +1,176 @@
+#include "CombatSystem/MTD_LiteCombat.h"
+
+#include "AbilitySystem/MTD_DamageSubsystem.h"
+#include "AbilitySystem/MTD_GameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Character/MTD_BalanceComponent.h"
+#include "Character/MTD_BaseEnemyCharacter.h"
+#include "Character/MTD_HealthComponent.h"
+#include "EngineUtils.h"
+#include "GameplayCueManager.h"
+#include "GameFramework/PlayerState.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectHash.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lite Combat Hits"), STAT_MtdLiteCombatHits, STATGROUP_Mtd);
+
+bool FMTD_LiteCombat::IsLiteTarget(const AActor *Actor)
+{
+    const UMTD_HealthComponent *HealthComponent = UMTD_HealthComponent::FindHealthComponent(Actor);
+    return ((IsValid(HealthComponent)) && (HealthComponent->IsLite()));
+}
+
+bool FMTD_LiteCombat::ApplyHit(
+    AActor *Target,
+    float Damage,
+    float BalanceDamage,
+    const FVector &KnockbackDirection,
+    AActor *DamageInstigator)
+{
+    UMTD_HealthComponent *HealthComponent = UMTD_HealthComponent::FindHealthComponent(Target);
+    if ((!IsValid(HealthComponent)) || (!HealthComponent->IsLite()))
+    {
+        return false;
+    }
+
+    INC_DWORD_STAT(STAT_MtdLiteCombatHits);
+
+    if (HealthComponent->IsDeadOrDying())
+    {
+        return true;
+    }
+
+    // Balance goes first, so that the knockback is not applied to an enemy that has just died
+    UMTD_BalanceComponent *BalanceComponent = UMTD_BalanceComponent::FindBalanceComponent(Target);
+    if ((BalanceDamage > 0.f) && (IsValid(BalanceComponent)))
+    {
+        BalanceComponent->ApplyLiteBalanceDamage(BalanceDamage, KnockbackDirection);
+    }
+
+    HealthComponent->ApplyLiteDamage(Damage, DamageInstigator);
+
+    // There is no gameplay effect to execute the cue, e.g. to show the damage number
+    if (Damage > 0.f)
+    {
+        FGameplayCueParameters CueParameters;
+        CueParameters.RawMagnitude = Damage;
+        CueParameters.Location = Target->GetActorLocation();
+        CueParameters.Instigator = DamageInstigator;
+        CueParameters.EffectCauser = DamageInstigator;
+
+        UGameplayCueManager::ExecuteGameplayCue_NonReplicated(
+            Target, FMTD_GameplayTags::Get().GameplayCue_DamageInstant, CueParameters);
+    }
+
+    return true;
+}
+
+#if !UE_BUILD_SHIPPING
+/** Bytes the actor takes along with its player state, and all the objects they own, e.g. ability system. */
+static SIZE_T CountActorBytes(const AActor *Actor)
+{
+    TArray<const UObject*, TInlineAllocator<2>> Roots;
+    Roots.Add(Actor);
+
+    const auto Pawn = Cast<APawn>(Actor);
+    if ((IsValid(Pawn)) && (IsValid(Pawn->GetPlayerState())))
+    {
+        Roots.Add(Pawn->GetPlayerState());
+    }
+
+    SIZE_T Bytes = 0;
+    for (const UObject *Root : Roots)
+    {
+        Bytes += FArchiveCountMem(const_cast<UObject*>(Root)).GetMax();
+        ForEachObjectWithOuter(Root, [&Bytes](UObject *Object)
+        {
+            Bytes += FArchiveCountMem(Object).GetMax();
+        }, true);
+    }
+
+    return Bytes;
+}
+
+void FMTD_LiteCombat::RunLiteCombatBenchmark(UWorld *World, int32 HitCount, float Damage)
+{
+    HitCount = FMath::Max(HitCount, 1);
+
+    TArray<AMTD_BaseEnemyCharacter*> LiteEnemies;
+    TArray<UAbilitySystemComponent*> FullEnemyAscs;
+    SIZE_T LiteBytes = 0;
+    SIZE_T FullBytes = 0;
+
+    for (TActorIterator<AMTD_BaseEnemyCharacter> It(World); It; ++It)
+    {
+        AMTD_BaseEnemyCharacter *Enemy = *It;
+        if (IsLiteTarget(Enemy))
+        {
+            LiteEnemies.Add(Enemy);
+            LiteBytes += CountActorBytes(Enemy);
+            continue;
+        }
+
+        UAbilitySystemComponent *Asc = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Enemy);
+        if (IsValid(Asc))
+        {
+            FullEnemyAscs.Add(Asc);
+            FullBytes += CountActorBytes(Enemy);
+        }
+    }
+
+    if (!LiteEnemies.IsEmpty())
+    {
+        const double StartSeconds = FPlatformTime::Seconds();
+        for (int32 i = 0; i < HitCount; i++)
+        {
+            ApplyHit(LiteEnemies[i % LiteEnemies.Num()], Damage, 0.f, FVector::ForwardVector, nullptr);
+        }
+        const double EndSeconds = FPlatformTime::Seconds();
+
+        MTD_LOG("Lite combat: %d enemies, %.1f KB per enemy, %.3f us per hit.", LiteEnemies.Num(),
+            LiteBytes / 1024.0 / LiteEnemies.Num(), (EndSeconds - StartSeconds) * 1000000.0 / HitCount);
+    }
+
+    UMTD_DamageSubsystem *DamageSubsystem = UMTD_DamageSubsystem::Get(World);
+    if ((!FullEnemyAscs.IsEmpty()) && (IsValid(DamageSubsystem)))
+    {
+        // Flush every hit on its own, so that each of them goes through a gameplay effect
+        FMTD_DamageHit Hit;
+        Hit.DamageBase = Damage;
+
+        const double StartSeconds = FPlatformTime::Seconds();
+        for (int32 i = 0; i < HitCount; i++)
+        {
+            Hit.Target = FullEnemyAscs[i % FullEnemyAscs.Num()];
+            DamageSubsystem->QueueDamage(Hit);
+            DamageSubsystem->FlushDamage();
+        }
+        const double EndSeconds = FPlatformTime::Seconds();
+
+        MTD_LOG("Ability system combat: %d enemies, %.1f KB per enemy, %.3f us per hit.", FullEnemyAscs.Num(),
+            FullBytes / 1024.0 / FullEnemyAscs.Num(), (EndSeconds - StartSeconds) * 1000000.0 / HitCount);
+    }
+
+    if ((LiteEnemies.IsEmpty()) && (FullEnemyAscs.IsEmpty()))
+    {
+        MTD_WARN("There are no enemies to hit.");
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs LiteCombatBenchmarkCommand(
+    TEXT("mtd.LiteCombatBenchmark"),
+    TEXT("Compare memory and hit cost of lite and regular enemies. "
+        "Usage: mtd.LiteCombatBenchmark [Hits=1000] [Damage=1]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        if (!IsValid(World))
+        {
+            return;
+        }
+
+        const int32 HitCount = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (1000);
+        const float Damage = (Args.IsValidIndex(1)) ? (FCString::Atof(*Args[1])) : (1.f);
+        FMTD_LiteCombat::RunLiteCombatBenchmark(World, HitCount, Damage);
+    }));
+#endif
@@ -1,6 +1,6 @@
 #include "CombatSystem/MTD_MeleeHitboxData.h"
 
-TArray<FMTD_MeleeHitSphereDefinition> UMTD_MeleeHitboxData::GetMeleeHitSpheres(TArray<int32> Indices)
+TArray<FMTD_MeleeHitSphereDefinition> UMTD_MeleeHitboxData::GetMeleeHitSpheres(const TArray<int32> &Indices) const
 {
     TArray<FMTD_MeleeHitSphereDefinition> HitSphereSubset;
 
@@ -15,3 +15,38 @@ TArray<FMTD_MeleeHitSphereDefinition> UMTD_MeleeHitboxData::GetMeleeHitSpheres(T
 
     return HitSphereSubset;
 }
+
+namespace MeleeHitboxIds
+{
+    FCriticalSection Lock;
+    TMap<FName, uint16> Ids;
+}
+
+uint16 FMTD_MeleeHitboxIds::FindOrAdd(FName Nickname)
+{
+    FScopeLock ScopeLock(&MeleeHitboxIds::Lock);
+
+    const uint16 *Found = MeleeHitboxIds::Ids.Find(Nickname);
+    if (Found)
+    {
+        return *Found;
+    }
+
+    const int32 Id = MeleeHitboxIds::Ids.Num();
+    if (Id >= InvalidId)
+    {
+        MTD_WARN("There are too many melee hitbox nicknames, [%s] won't be registered.", *Nickname.ToString());
+        return InvalidId;
+    }
+
+    MeleeHitboxIds::Ids.Add(Nickname, static_cast<uint16>(Id));
+    return static_cast<uint16>(Id);
+}
+
+uint16 FMTD_MeleeHitboxIds::Find(FName Nickname)
+{
+    FScopeLock ScopeLock(&MeleeHitboxIds::Lock);
+
+    const uint16 *Found = MeleeHitboxIds::Ids.Find(Nickname);
+    return (Found) ? (*Found) : (InvalidId);
+}
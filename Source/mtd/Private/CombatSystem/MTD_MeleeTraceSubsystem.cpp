@@ -0,0 +1,554 @@
+#include "CombatSystem/MTD_MeleeTraceSubsystem.h"
+
+#include "Character/MTD_BaseCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "DrawDebugHelpers.h"
+#include "EngineUtils.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+DECLARE_CYCLE_STAT(TEXT("Melee Trace"), STAT_MtdMeleeTrace, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Hitboxes Traced"), STAT_MtdMeleeHitboxes, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Async Queries"), STAT_MtdMeleeAsyncQueries, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Deferred Characters"), STAT_MtdMeleeDeferredCharacters, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Late Async Queries"), STAT_MtdMeleeLateAsyncQueries, STATGROUP_Mtd);
+
+UMTD_MeleeTraceSubsystem *UMTD_MeleeTraceSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<UMTD_MeleeTraceSubsystem>()) : (nullptr);
+}
+
+bool UMTD_MeleeTraceSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void UMTD_MeleeTraceSubsystem::Deinitialize()
+{
+    MeleeCharacters.Empty();
+    PendingHits.Empty();
+    HitboxHits.Empty();
+    IssuedQueries.Empty();
+    ResolvingQueries.Empty();
+    AsyncCharacters.Empty();
+    PlayerFacingCharacters.Empty();
+    DeferredCharacters.Empty();
+
+    Super::Deinitialize();
+}
+
+void UMTD_MeleeTraceSubsystem::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    TraceMelee();
+}
+
+TStatId UMTD_MeleeTraceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMTD_MeleeTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UMTD_MeleeTraceSubsystem::RegisterMeleeCharacter(AMTD_BaseCharacter *Character)
+{
+    if (IsValid(Character))
+    {
+        MeleeCharacters.AddUnique(Character);
+    }
+}
+
+void UMTD_MeleeTraceSubsystem::UnregisterMeleeCharacter(AMTD_BaseCharacter *Character)
+{
+    const int32 Index = MeleeCharacters.Find(Character);
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Don't shift the characters that are being iterated over, they are compacted once the pass is over
+    if (bTracing)
+    {
+        MeleeCharacters[Index] = nullptr;
+    }
+    else
+    {
+        MeleeCharacters.RemoveAtSwap(Index);
+    }
+}
+
+void UMTD_MeleeTraceSubsystem::TraceMelee()
+{
+    if ((MeleeCharacters.IsEmpty()) && (IssuedQueries.IsEmpty()))
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_MtdMeleeTrace);
+
+    bTracing = true;
+
+    // Queries issued on the previous frame are done by now
+    ResolveAsyncQueries();
+
+    // Characters may be registered while hits are performed, they are traced on the same pass
+    AsyncCharacters.Reset();
+    for (int32 i = 0; i < MeleeCharacters.Num(); i++)
+    {
+        AMTD_BaseCharacter *Character = MeleeCharacters[i];
+        if (!IsValid(Character))
+        {
+            continue;
+        }
+
+        // Player's own attacks are always traced on the spot
+        if ((bAsyncQueries) && (!Character->IsPlayerControlled()))
+        {
+            AsyncCharacters.Add(Character);
+        }
+        else
+        {
+            TraceCharacter(Character, true);
+        }
+    }
+
+    TraceCharactersAsync(AsyncCharacters);
+
+    bTracing = false;
+
+    MeleeCharacters.RemoveAllSwap([](const TObjectPtr<AMTD_BaseCharacter> &Character)
+        {
+            return ((!IsValid(Character)) || (!Character->bIsMeleeInProgress));
+        });
+}
+
+void UMTD_MeleeTraceSubsystem::SetAsyncQueriesEnabled(bool bEnabled)
+{
+    bAsyncQueries = bEnabled;
+}
+
+bool UMTD_MeleeTraceSubsystem::AreAsyncQueriesEnabled() const
+{
+    return bAsyncQueries;
+}
+
+bool UMTD_MeleeTraceSubsystem::SweepHitbox(const UWorld *World, const FVector &Start, const FVector &End,
+    float Radius, const FCollisionObjectQueryParams &ObjectParams, const FCollisionQueryParams &QueryParams,
+    TArray<FHitResult> &OutHits)
+{
+    return World->SweepMultiByObjectType(
+        OutHits, Start, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), QueryParams);
+}
+
+void UMTD_MeleeTraceSubsystem::TraceCharacter(AMTD_BaseCharacter *Character, bool bPerformHits)
+{
+    const UWorld *World = GetWorld();
+    const FVector ActorLocation = Character->GetActorLocation();
+    const FRotator ForwardRot = Character->GetActorForwardVector().Rotation();
+
+    static const FName MeleeTraceName = TEXT("MtdMeleeTrace");
+    const FCollisionQueryParams QueryParams(MeleeTraceName, false);
+
+    PendingHits.Reset();
+    for (uint64 Mask = Character->ActiveHitboxMask; Mask != 0; Mask &= (Mask - 1))
+    {
+        FMTD_ActiveHitboxEntry &HitboxEntry = Character->Hitboxes[FMath::CountTrailingZeros64(Mask)];
+
+        FVector Start;
+        FVector End;
+        AdvanceHitbox(HitboxEntry, ActorLocation, ForwardRot, Start, End);
+
+        HitboxHits.Reset();
+        SweepHitbox(World, Start, End, HitboxEntry.HitboxInfo.Radius, Character->MeleeObjectQueryParams,
+            QueryParams, HitboxHits);
+        INC_DWORD_STAT(STAT_MtdMeleeHitboxes);
+
+        if (Character->bDebugMelee)
+        {
+            const FColor Color = (HitboxHits.IsEmpty()) ? (FColor::Red) : (FColor::Green);
+            DrawDebugSweptSphere(World, Start, End, HitboxEntry.HitboxInfo.Radius, Color, false, Character->DrawTime);
+        }
+
+        PendingHits.Append(HitboxHits);
+    }
+
+    // Hits are performed once all hitboxes are swept, since a hit may change the active hitboxes
+    if (bPerformHits)
+    {
+        PerformHits(Character, PendingHits);
+    }
+}
+
+int32 UMTD_MeleeTraceSubsystem::IssueAsyncQueries(AMTD_BaseCharacter *Character)
+{
+    UWorld *World = GetWorld();
+    const FVector ActorLocation = Character->GetActorLocation();
+    const FRotator ForwardRot = Character->GetActorForwardVector().Rotation();
+
+    static const FName MeleeTraceName = TEXT("MtdMeleeAsyncTrace");
+    const FCollisionQueryParams QueryParams(MeleeTraceName, false);
+
+    for (uint64 Mask = Character->ActiveHitboxMask; Mask != 0; Mask &= (Mask - 1))
+    {
+        FMTD_ActiveHitboxEntry &HitboxEntry = Character->Hitboxes[FMath::CountTrailingZeros64(Mask)];
+
+        FVector Start;
+        FVector End;
+        AdvanceHitbox(HitboxEntry, ActorLocation, ForwardRot, Start, End);
+
+        // Capsule covering the whole distance the hitbox has travelled since it was traced last time
+        const float Radius = HitboxEntry.HitboxInfo.Radius;
+        const FVector Segment = End - Start;
+        const float HalfLength = Segment.Size() * 0.5f;
+        const FVector Center = Start + Segment * 0.5f;
+        const FQuat Rotation =
+            (HalfLength > KINDA_SMALL_NUMBER) ? (FRotationMatrix::MakeFromZ(Segment).ToQuat()) : (FQuat::Identity);
+
+        FAsyncMeleeQuery &Query = IssuedQueries.AddDefaulted_GetRef();
+        Query.Character = Character;
+        Query.Start = Start;
+        Query.Location = End;
+        Query.Radius = Radius;
+        Query.Handle = World->AsyncOverlapByObjectType(Center, Rotation, Character->MeleeObjectQueryParams,
+            FCollisionShape::MakeCapsule(Radius, Radius + HalfLength), QueryParams);
+
+        if (Character->bDebugMelee)
+        {
+            DrawDebugCapsule(
+                World, Center, Radius + HalfLength, Radius, Rotation, FColor::Yellow, false, Character->DrawTime);
+        }
+    }
+
+    const int32 Queries = FMath::CountBits(Character->ActiveHitboxMask);
+    INC_DWORD_STAT_BY(STAT_MtdMeleeHitboxes, Queries);
+    INC_DWORD_STAT_BY(STAT_MtdMeleeAsyncQueries, Queries);
+    return Queries;
+}
+
+void UMTD_MeleeTraceSubsystem::ResolveAsyncQueries()
+{
+    Swap(IssuedQueries, ResolvingQueries);
+    IssuedQueries.Reset();
+
+    UWorld *World = GetWorld();
+    FOverlapDatum OverlapDatum;
+    for (const FAsyncMeleeQuery &Query : ResolvingQueries)
+    {
+        // Attack may have ended while the query was in flight, its hit targets are reset by now
+        AMTD_BaseCharacter *Character = Query.Character.Get();
+        if ((!IsValid(Character)) || (!Character->bIsMeleeInProgress))
+        {
+            continue;
+        }
+
+        HitboxHits.Reset();
+
+        // The hitbox has already moved on, hence sweep the segment the query covers, or it would never be traced
+        if (!World->QueryOverlapData(Query.Handle, OverlapDatum))
+        {
+            static const FName MeleeTraceName = TEXT("MtdMeleeLateTrace");
+            SweepHitbox(World, Query.Start, Query.Location, Query.Radius, Character->MeleeObjectQueryParams,
+                FCollisionQueryParams(MeleeTraceName, false), HitboxHits);
+            INC_DWORD_STAT(STAT_MtdMeleeLateAsyncQueries);
+
+            PerformHits(Character, HitboxHits);
+            continue;
+        }
+
+        for (const FOverlapResult &Overlap : OverlapDatum.OutOverlaps)
+        {
+            AActor *HitActor = Overlap.GetActor();
+            UPrimitiveComponent *HitComponent = Overlap.GetComponent();
+            if ((!IsValid(HitActor)) || (!IsValid(HitComponent)))
+            {
+                continue;
+            }
+
+            const FVector Normal = (Query.Location - HitComponent->GetComponentLocation()).GetSafeNormal();
+            HitboxHits.Emplace(HitActor, HitComponent, Query.Location, Normal);
+        }
+
+        PerformHits(Character, HitboxHits);
+    }
+
+    ResolvingQueries.Reset();
+}
+
+void UMTD_MeleeTraceSubsystem::TraceCharactersAsync(const TArray<AMTD_BaseCharacter*> &Characters)
+{
+    if (Characters.IsEmpty())
+    {
+        return;
+    }
+
+    TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController *PlayerController = It->Get();
+        const APawn *Pawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+        if (IsValid(Pawn))
+        {
+            PlayerLocations.Add(Pawn->GetActorLocation());
+        }
+    }
+
+    // Attacks close to player pawns are traced first, the rest take turns on whatever budget is left
+    const float MaxDistanceSquared = FMath::Square(PlayerFacingDistance);
+    PlayerFacingCharacters.Reset();
+    DeferredCharacters.Reset();
+    for (AMTD_BaseCharacter *Character : Characters)
+    {
+        const FVector Location = Character->GetActorLocation();
+        const bool bPlayerFacing = PlayerLocations.ContainsByPredicate([&Location, MaxDistanceSquared](
+            const FVector &PlayerLocation)
+            {
+                return (FVector::DistSquared(PlayerLocation, Location) <= MaxDistanceSquared);
+            });
+
+        if (bPlayerFacing)
+        {
+            PlayerFacingCharacters.Add(Character);
+        }
+        else
+        {
+            DeferredCharacters.Add(Character);
+        }
+    }
+
+    // Hitboxes of the characters left out keep their previous location, next sweep covers the distance they skip
+    int32 Queries = 0;
+    int32 LeftOut = IssueAsyncQueriesWithinBudget(PlayerFacingCharacters, PlayerFacingCharacterOffset, Queries);
+    LeftOut += IssueAsyncQueriesWithinBudget(DeferredCharacters, DeferredCharacterOffset, Queries);
+    INC_DWORD_STAT_BY(STAT_MtdMeleeDeferredCharacters, LeftOut);
+}
+
+int32 UMTD_MeleeTraceSubsystem::IssueAsyncQueriesWithinBudget(
+    const TArray<AMTD_BaseCharacter*> &Characters,
+    int32 &InOutOffset,
+    int32 &InOutQueries)
+{
+    // A character that has more hitboxes than the whole budget is still traced if it's the first one
+    const int32 FrameBudget = FMath::Max(MaxAsyncQueriesPerFrame, 1);
+    const int32 Count = Characters.Num();
+    int32 Traced = 0;
+    for (; Traced < Count; Traced++)
+    {
+        AMTD_BaseCharacter *Character = Characters[(InOutOffset + Traced) % Count];
+        const int32 Hitboxes = FMath::CountBits(Character->ActiveHitboxMask);
+        if ((InOutQueries > 0) && (InOutQueries + Hitboxes > FrameBudget))
+        {
+            break;
+        }
+
+        InOutQueries += IssueAsyncQueries(Character);
+    }
+
+    InOutOffset = (Count > 0) ? ((InOutOffset + Traced) % Count) : (0);
+    return (Count - Traced);
+}
+
+void UMTD_MeleeTraceSubsystem::AdvanceHitbox(FMTD_ActiveHitboxEntry &HitboxEntry, const FVector &ActorLocation,
+    const FRotator &ForwardRot, FVector &OutStart, FVector &OutEnd)
+{
+    OutEnd = ActorLocation + ForwardRot.RotateVector(HitboxEntry.HitboxInfo.Offset);
+    OutStart = (HitboxEntry.bHasPreviousLocation) ? (HitboxEntry.PreviousLocation) : (OutEnd);
+
+    HitboxEntry.PreviousLocation = OutEnd;
+    HitboxEntry.bHasPreviousLocation = true;
+}
+
+void UMTD_MeleeTraceSubsystem::PerformHits(AMTD_BaseCharacter *Character, const TArray<FHitResult> &Hits)
+{
+    for (const FHitResult &Hit : Hits)
+    {
+        const AActor *HitActor = Hit.GetActor();
+        if ((IsValid(HitActor)) && (!Character->MeleeHitTargets.Contains(HitActor)))
+        {
+            Character->PerformHit(Hit);
+        }
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+void UMTD_MeleeTraceSubsystem::RunMeleeSwarmBenchmark(int32 Frames)
+{
+    UWorld *World = GetWorld();
+    Frames = FMath::Max(Frames, 1);
+
+    // Activate all the hitboxes, the ones that are already active are put back when we are done
+    TArray<AMTD_BaseCharacter*> Characters;
+    TArray<TArray<FMTD_ActiveHitboxEntry>> SavedHitboxes;
+    TArray<uint64> SavedMasks;
+    int32 HitboxCount = 0;
+    for (TActorIterator<AMTD_BaseCharacter> It(World); It; ++It)
+    {
+        AMTD_BaseCharacter *Character = *It;
+        const int32 Hitboxes = Character->Hitboxes.Num();
+        if (Hitboxes == 0)
+        {
+            continue;
+        }
+
+        Characters.Add(Character);
+        SavedHitboxes.Add(Character->Hitboxes);
+        SavedMasks.Add(Character->ActiveHitboxMask);
+
+        Character->ActiveHitboxMask =
+            (Hitboxes >= AMTD_BaseCharacter::MaxHitboxes) ? (MAX_uint64) : ((uint64(1) << Hitboxes) - 1);
+        HitboxCount += Hitboxes;
+    }
+
+    if (Characters.IsEmpty())
+    {
+        MTD_WARN("There are no characters with hitboxes to trace.");
+        return;
+    }
+
+    const double LegacyStartSeconds = FPlatformTime::Seconds();
+    for (int32 Frame = 0; Frame < Frames; Frame++)
+    {
+        for (const AMTD_BaseCharacter *Character : Characters)
+        {
+            const FVector ActorLocation = Character->GetActorLocation();
+            const FRotator ForwardRot = Character->GetActorForwardVector().Rotation();
+            const TArray<AActor*> IgnoredActors = Character->MeleeHitTargets.Array();
+
+            for (const FMTD_ActiveHitboxEntry &HitboxEntry : Character->Hitboxes)
+            {
+                const FVector TraceLocation = ActorLocation + ForwardRot.RotateVector(HitboxEntry.HitboxInfo.Offset);
+
+                TArray<FHitResult> OutHits;
+                UKismetSystemLibrary::SphereTraceMultiForObjects(
+                    World, TraceLocation, TraceLocation, HitboxEntry.HitboxInfo.Radius, Character->ObjectTypesToHit,
+                    false, IgnoredActors, EDrawDebugTrace::None, OutHits, false);
+            }
+        }
+    }
+    const double LegacyEndSeconds = FPlatformTime::Seconds();
+
+    for (int32 Frame = 0; Frame < Frames; Frame++)
+    {
+        for (AMTD_BaseCharacter *Character : Characters)
+        {
+            TraceCharacter(Character, false);
+        }
+    }
+    const double BatchedEndSeconds = FPlatformTime::Seconds();
+
+    // Results of the async queries are dropped, only the cost of issuing them is of interest
+    const int32 IssuedQueryCount = IssuedQueries.Num();
+    for (int32 Frame = 0; Frame < Frames; Frame++)
+    {
+        for (AMTD_BaseCharacter *Character : Characters)
+        {
+            IssueAsyncQueries(Character);
+        }
+    }
+    IssuedQueries.SetNum(IssuedQueryCount);
+    const double AsyncEndSeconds = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < Characters.Num(); i++)
+    {
+        Characters[i]->Hitboxes = MoveTemp(SavedHitboxes[i]);
+        Characters[i]->ActiveHitboxMask = SavedMasks[i];
+    }
+
+    const double LegacyMs = (LegacyEndSeconds - LegacyStartSeconds) * 1000.0 / Frames;
+    const double BatchedMs = (BatchedEndSeconds - LegacyEndSeconds) * 1000.0 / Frames;
+    const double AsyncMs = (AsyncEndSeconds - BatchedEndSeconds) * 1000.0 / Frames;
+    MTD_LOG("%d characters with %d hitboxes over %d frames: %.3f ms per frame traced, %.3f ms per frame swept, "
+        "%.3f ms per frame issued async.", Characters.Num(), HitboxCount, Frames, LegacyMs, BatchedMs, AsyncMs);
+}
+
+void UMTD_MeleeTraceSubsystem::RunTunnellingCheck()
+{
+    const UWorld *World = GetWorld();
+    const APlayerController *PlayerController = World->GetFirstPlayerController();
+    const APawn *Pawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+    const UCapsuleComponent *Capsule = (IsValid(Pawn)) ? (Pawn->FindComponentByClass<UCapsuleComponent>()) : (nullptr);
+
+    if (!IsValid(Capsule))
+    {
+        MTD_WARN("First player has no capsule to swing at.");
+        return;
+    }
+
+    // Hitbox is on one side of the capsule on the previous frame, and on the other one on the current frame
+    constexpr float HitboxRadius = 10.f;
+    const float Distance = Capsule->GetScaledCapsuleRadius() + HitboxRadius * 2.f + 10.f;
+    const FVector Center = Capsule->GetComponentLocation();
+    const FVector Previous = Center - Pawn->GetActorRightVector() * Distance;
+    const FVector Current = Center + Pawn->GetActorRightVector() * Distance;
+
+    const FCollisionObjectQueryParams ObjectParams(Capsule->GetCollisionObjectType());
+    static const FName TunnellingCheckName = TEXT("MtdMeleeTunnellingCheck");
+    const FCollisionQueryParams QueryParams(TunnellingCheckName, false);
+
+    const auto HasHitPawn = [Pawn](const TArray<FHitResult> &Hits)
+        {
+            return Hits.ContainsByPredicate([Pawn](const FHitResult &Hit) { return Hit.GetActor() == Pawn; });
+        };
+
+    TArray<FHitResult> Hits;
+    SweepHitbox(World, Current, Current, HitboxRadius, ObjectParams, QueryParams, Hits);
+    const bool bPointHit = HasHitPawn(Hits);
+
+    Hits.Reset();
+    SweepHitbox(World, Previous, Current, HitboxRadius, ObjectParams, QueryParams, Hits);
+    const bool bSweepHit = HasHitPawn(Hits);
+
+    if ((!bPointHit) && (bSweepHit))
+    {
+        MTD_LOG("Tunnelling check passed: swept hitbox hits the target a point trace misses.");
+    }
+    else
+    {
+        MTD_WARN("Tunnelling check failed: point trace %s, swept trace %s.",
+            (bPointHit) ? (TEXT("hit")) : (TEXT("missed")), (bSweepHit) ? (TEXT("hit")) : (TEXT("missed")));
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs MeleeSwarmBenchmarkCommand(
+    TEXT("mtd.MeleeSwarmBenchmark"),
+    TEXT("Trace all hitboxes of every character. Usage: mtd.MeleeSwarmBenchmark [Frames=100]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_MeleeTraceSubsystem *MeleeTraceSubsystem = UMTD_MeleeTraceSubsystem::Get(World);
+        if (!IsValid(MeleeTraceSubsystem))
+        {
+            return;
+        }
+
+        const int32 Frames = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (100);
+        MeleeTraceSubsystem->RunMeleeSwarmBenchmark(Frames);
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs MeleeAsyncQueriesCommand(
+    TEXT("mtd.MeleeAsyncQueries"),
+    TEXT("Toggle async melee traces of non-player characters. Usage: mtd.MeleeAsyncQueries [0/1]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_MeleeTraceSubsystem *MeleeTraceSubsystem = UMTD_MeleeTraceSubsystem::Get(World);
+        if (!IsValid(MeleeTraceSubsystem))
+        {
+            return;
+        }
+
+        const bool bEnabled = (Args.IsValidIndex(0)) ?
+            (FCString::ToBool(*Args[0])) : (!MeleeTraceSubsystem->AreAsyncQueriesEnabled());
+        MeleeTraceSubsystem->SetAsyncQueriesEnabled(bEnabled);
+        MTD_LOG("Async melee queries are %s.", (bEnabled) ? (TEXT("enabled")) : (TEXT("disabled")));
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs MeleeTunnellingCheckCommand(
+    TEXT("mtd.MeleeTunnellingCheck"),
+    TEXT("Check that a hitbox swung across the first player within a frame hits it."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_MeleeTraceSubsystem *MeleeTraceSubsystem = UMTD_MeleeTraceSubsystem::Get(World);
+        if (IsValid(MeleeTraceSubsystem))
+        {
+            MeleeTraceSubsystem->RunTunnellingCheck();
+        }
+    }));
+#endif
@@ -24,6 +24,26 @@ AActor *AMTD_GameModeBase::GetGameTarget(APawn *Client) const
     return nullptr;
 }
 
+AActor *AMTD_GameModeBase::GetCachedGameTarget(APawn *Client, TWeakObjectPtr<AActor> &CachedGameTarget)
+{
+    AActor *GameTarget = CachedGameTarget.Get();
+    if (IsValid(GameTarget))
+    {
+        return GameTarget;
+    }
+
+    const UWorld *World = (IsValid(Client)) ? (Client->GetWorld()) : (nullptr);
+    const auto GameMode = (IsValid(World)) ? (Cast<AMTD_GameModeBase>(World->GetAuthGameMode())) : (nullptr);
+    if (!IsValid(GameMode))
+    {
+        return nullptr;
+    }
+
+    GameTarget = GameMode->GetGameTarget(Client);
+    CachedGameTarget = GameTarget;
+    return GameTarget;
+}
+
 void AMTD_GameModeBase::TerminateGame(EMTD_GameResult Reason)
 {
     // Avoid dispatching if already did
@@ -82,7 +82,6 @@ void AMTD_FloatingToken::OnPawnAdded(APawn *Pawn)
         
         Displacement.ToDirectionAndLength(Direction, Distance);
         
-        MovementComponent->SetUpdatedComponent(GetRootComponent());
         MovementComponent->AddForce(Direction * MinimalForceTowardsTarget);
         SetNewTarget(Pawn);
     }
@@ -106,7 +105,7 @@ void AMTD_FloatingToken::SetNewTarget(APawn *Pawn)
         return;
     }
     
-    MovementComponent->HomingTargetComponent = (IsValid(Pawn)) ? (Pawn->GetRootComponent()) : (nullptr);
+    MovementComponent->SetHomingTarget((IsValid(Pawn)) ? (Pawn->GetRootComponent()) : (nullptr));
 }
 
 void AMTD_FloatingToken::IgnoreTriggersFor(float Seconds)
@@ -7,6 +7,9 @@
 #include "GameFramework/WorldSettings.h"
 #include "ProfilingDebugging/CsvProfiler.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Awake Tokens"), STAT_MtdAwakeTokens, STATGROUP_Mtd);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sleeping Tokens"), STAT_MtdSleepingTokens, STATGROUP_Mtd);
+
 UMTD_TokenMovementComponent::UMTD_TokenMovementComponent()
 {
     PrimaryComponentTick.bCanEverTick = true;
@@ -22,6 +25,11 @@ void UMTD_TokenMovementComponent::InitializeComponent()
 {
     Super::InitializeComponent();
 
+    const UWorld *World = GetWorld();
+    CachedWorldSettings = (IsValid(World)) ? (World->GetWorldSettings(true)) : (nullptr);
+
+    SetSleepState(ESleepState::Awake);
+
     if (Velocity.SizeSquared() > 0.f)
     {
         const bool Valid = IsValid(UpdatedComponent);
@@ -41,8 +49,22 @@ void UMTD_TokenMovementComponent::InitializeComponent()
     }
 }
 
+void UMTD_TokenMovementComponent::UninitializeComponent()
+{
+    SetSleepState(ESleepState::None);
+
+    Super::UninitializeComponent();
+}
+
 void UMTD_TokenMovementComponent::UpdateTickRegistration()
 {
+    if (IsSleeping())
+    {
+        // Sleeping tokens must not be ticked, regardless of the updated component
+        SetComponentTickEnabled(false);
+        return;
+    }
+    
     if (bAutoUpdateTickRegistration)
     {
         Super::UpdateTickRegistration();
@@ -165,6 +187,11 @@ void UMTD_TokenMovementComponent::TickComponent(float DeltaSeconds, enum ELevelT
         }
     }
 
+    if (UpdateSleepState(DeltaSeconds, Hit))
+    {
+        return;
+    }
+
     UpdateComponentVelocity();
     Direction = Velocity.GetSafeNormal();
 }
@@ -502,10 +529,8 @@ FVector UMTD_TokenMovementComponent::LimitVelocity(FVector NewVelocity) const
 
 void UMTD_TokenMovementComponent::StopSimulating(const FHitResult &HitResult)
 {
-    Velocity = PendingForce = PendingForceThisUpdate = FVector::ZeroVector;
-    
-    UpdateComponentVelocity();
-    SetUpdatedComponent(nullptr);
+    // Keep the updated component around, so that the token can be woken up later on
+    Sleep();
     
     OnTokenStopDelegate.Broadcast(HitResult);
 }
@@ -517,14 +542,13 @@ bool UMTD_TokenMovementComponent::CheckStillInWorld()
         return false;
     }
 
-    const UWorld *MyWorld = GetWorld();
-    if (!IsValid(MyWorld))
+    // Check the variations of KillZ
+    const AWorldSettings *WorldSettings = CachedWorldSettings;
+    if (!IsValid(WorldSettings))
     {
         return false;
     }
-
-    // Check the variations of KillZ
-    const AWorldSettings *WorldSettings = MyWorld->GetWorldSettings(true);
+    
     if (!WorldSettings->AreWorldBoundsChecksEnabled())
     {
         return true;
@@ -566,3 +590,130 @@ bool UMTD_TokenMovementComponent::CheckStillInWorld()
     }
     return true;
 }
+
+bool UMTD_TokenMovementComponent::UpdateSleepState(float DeltaSeconds, const FHitResult &Hit)
+{
+    // The simulation may have been stopped during the movement update
+    if (IsSleeping())
+    {
+        return true;
+    }
+    
+    const bool bSettled = ((bCanSleep) && (!HomingTargetComponent.IsValid()) && (PendingForce.IsZero()) &&
+        (Velocity.SizeSquared() < FMath::Square(SleepVelocityThreshold)));
+
+    if (!bSettled)
+    {
+        SettledTime = 0.f;
+        return false;
+    }
+
+    SettledTime += DeltaSeconds;
+    if (SettledTime < SleepDelay)
+    {
+        return false;
+    }
+
+    StopSimulating(Hit);
+    return true;
+}
+
+void UMTD_TokenMovementComponent::Sleep()
+{
+    if (IsSleeping())
+    {
+        return;
+    }
+
+    Velocity = PendingForce = PendingForceThisUpdate = FVector::ZeroVector;
+    UpdateComponentVelocity();
+
+    bIsSliding = false;
+    PreviousHitTime = 1.f;
+    SettledTime = 0.f;
+
+    SetSleepState(ESleepState::Asleep);
+    UpdateTickRegistration();
+}
+
+void UMTD_TokenMovementComponent::WakeUp()
+{
+    if (!IsSleeping())
+    {
+        // Simulation could have been stopped, restore the updated component anyway
+        if (!IsValid(UpdatedComponent))
+        {
+            const AActor *ActorOwner = GetOwner();
+            SetUpdatedComponent((IsValid(ActorOwner)) ? (ActorOwner->GetRootComponent()) : (nullptr));
+        }
+        return;
+    }
+
+    SettledTime = 0.f;
+    SetSleepState(ESleepState::Awake);
+
+    if (!IsValid(UpdatedComponent))
+    {
+        // SetUpdatedComponent() updates tick registration on its own
+        const AActor *ActorOwner = GetOwner();
+        SetUpdatedComponent((IsValid(ActorOwner)) ? (ActorOwner->GetRootComponent()) : (nullptr));
+    }
+    else
+    {
+        UpdateTickRegistration();
+    }
+}
+
+void UMTD_TokenMovementComponent::SetHomingTarget(USceneComponent *InHomingTarget)
+{
+    HomingTargetComponent = InHomingTarget;
+
+    if (IsValid(InHomingTarget))
+    {
+        WakeUp();
+    }
+}
+
+void UMTD_TokenMovementComponent::AddForce(FVector Force)
+{
+    PendingForce += Force;
+
+    if (!Force.IsZero())
+    {
+        WakeUp();
+    }
+}
+
+void UMTD_TokenMovementComponent::SetSleepState(ESleepState NewState)
+{
+    if (SleepState == NewState)
+    {
+        return;
+    }
+
+    switch (SleepState)
+    {
+    case ESleepState::Awake:
+        DEC_DWORD_STAT(STAT_MtdAwakeTokens);
+        break;
+    case ESleepState::Asleep:
+        DEC_DWORD_STAT(STAT_MtdSleepingTokens);
+        break;
+    default:
+        break;
+    }
+
+    switch (NewState)
+    {
+    case ESleepState::Awake:
+        INC_DWORD_STAT(STAT_MtdAwakeTokens);
+        break;
+    case ESleepState::Asleep:
+        INC_DWORD_STAT(STAT_MtdSleepingTokens);
+        break;
+    default:
+        break;
+    }
+
+    SleepState = NewState;
+}
@@ -0,0 +1,365 @@
+#include "Player/MTD_EnemyAiSubsystem.h"
+
+#include "Character/MTD_BaseEnemyCharacter.h"
+#include "Character/MTD_CharacterSpawner.h"
+#include "Character/MTD_HealthComponent.h"
+#include "EngineUtils.h"
+#include "GameModes/MTD_GameModeBase.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Player/MTD_EnemyController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy AI"), STAT_MtdEnemyAi, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy AI Updates"), STAT_MtdEnemyAiUpdates, STATGROUP_Mtd);
+
+UMTD_EnemyAiSubsystem *UMTD_EnemyAiSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<UMTD_EnemyAiSubsystem>()) : (nullptr);
+}
+
+bool UMTD_EnemyAiSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void UMTD_EnemyAiSubsystem::Deinitialize()
+{
+    for (const FEnemyAgent &Agent : Agents)
+    {
+        AMTD_EnemyController *Controller = Agent.Controller.Get();
+        if (IsValid(Controller))
+        {
+            Controller->NativeAiIndex = INDEX_NONE;
+        }
+    }
+
+    Agents.Empty();
+    NextAgentIndex = 0;
+
+#if !UE_BUILD_SHIPPING
+    StopEnemyAiBenchmark();
+#endif
+
+    Super::Deinitialize();
+}
+
+void UMTD_EnemyAiSubsystem::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (Agents.IsEmpty())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_MtdEnemyAi);
+
+    const double NowSeconds = GetWorld()->GetTimeSeconds();
+    const int32 Updates = FMath::Min(Agents.Num(), FMath::Max(MaxAgentsPerFrame, 1));
+    for (int32 i = 0; i < Updates; i++)
+    {
+        if (NextAgentIndex >= Agents.Num())
+        {
+            NextAgentIndex = 0;
+        }
+
+        UpdateAgent(Agents[NextAgentIndex], NowSeconds);
+        NextAgentIndex++;
+    }
+
+    INC_DWORD_STAT_BY(STAT_MtdEnemyAiUpdates, Updates);
+}
+
+TStatId UMTD_EnemyAiSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMTD_EnemyAiSubsystem, STATGROUP_Tickables);
+}
+
+void UMTD_EnemyAiSubsystem::RegisterController(AMTD_EnemyController *Controller)
+{
+    if ((!IsValid(Controller)) || (Controller->NativeAiIndex != INDEX_NONE))
+    {
+        return;
+    }
+
+    Controller->NativeAiIndex = Agents.Num();
+
+    FEnemyAgent &Agent = Agents.AddDefaulted_GetRef();
+    Agent.Controller = Controller;
+}
+
+void UMTD_EnemyAiSubsystem::UnregisterController(AMTD_EnemyController *Controller)
+{
+    if ((!IsValid(Controller)) || (!Agents.IsValidIndex(Controller->NativeAiIndex)))
+    {
+        return;
+    }
+
+    const int32 Index = Controller->NativeAiIndex;
+    Controller->NativeAiIndex = INDEX_NONE;
+
+    // Swap the last agent in, and point its controller to its new place
+    Agents.RemoveAtSwap(Index, 1, false);
+    if (Agents.IsValidIndex(Index))
+    {
+        AMTD_EnemyController *MovedController = Agents[Index].Controller.Get();
+        if (IsValid(MovedController))
+        {
+            MovedController->NativeAiIndex = Index;
+        }
+    }
+}
+
+void UMTD_EnemyAiSubsystem::KnockBack(AMTD_EnemyController *Controller, float Seconds)
+{
+    if ((!IsValid(Controller)) || (!Agents.IsValidIndex(Controller->NativeAiIndex)))
+    {
+        return;
+    }
+
+    FEnemyAgent &Agent = Agents[Controller->NativeAiIndex];
+    if (Agent.State == EMTD_EnemyAiState::Dead)
+    {
+        return;
+    }
+
+    Controller->StopMovement();
+    Controller->ClearFocus(EAIFocusPriority::Gameplay);
+
+    // Forget the move goal, hence the move is issued again once the knockback is over
+    Agent.MoveGoal = nullptr;
+    Agent.State = EMTD_EnemyAiState::Knockback;
+    Agent.StateEndSeconds = GetWorld()->GetTimeSeconds() + Seconds;
+}
+
+EMTD_EnemyAiState UMTD_EnemyAiSubsystem::GetState(const AMTD_EnemyController *Controller) const
+{
+    return ((IsValid(Controller)) && (Agents.IsValidIndex(Controller->NativeAiIndex))) ?
+        (Agents[Controller->NativeAiIndex].State) : (EMTD_EnemyAiState::Dead);
+}
+
+void UMTD_EnemyAiSubsystem::UpdateAgent(FEnemyAgent &Agent, double NowSeconds) const
+{
+    if (Agent.State == EMTD_EnemyAiState::Dead)
+    {
+        return;
+    }
+
+    AMTD_EnemyController *Controller = Agent.Controller.Get();
+    auto Enemy = (IsValid(Controller)) ? (Cast<AMTD_BaseEnemyCharacter>(Controller->GetPawn())) : (nullptr);
+    if (!IsValid(Enemy))
+    {
+        return;
+    }
+
+    if (Enemy->GetHealthComponent()->IsDeadOrDying())
+    {
+        Controller->StopMovement();
+        Agent.State = EMTD_EnemyAiState::Dead;
+        return;
+    }
+
+    if ((Agent.State == EMTD_EnemyAiState::Knockback) && (NowSeconds < Agent.StateEndSeconds))
+    {
+        return;
+    }
+
+    AActor *Target = (IsValid(Controller->Target)) ? (Controller->Target.Get()) : (nullptr);
+
+    // Attack whatever is inside the attack trigger
+    if (Controller->bAttack)
+    {
+        if (Agent.State != EMTD_EnemyAiState::Attack)
+        {
+            Controller->StopMovement();
+            AActor *Focus = (IsValid(Target)) ?
+                (Target) : (AMTD_GameModeBase::GetCachedGameTarget(Enemy, Agent.GameTarget));
+            Controller->SetFocus(Focus);
+
+            Agent.MoveGoal = nullptr;
+            Agent.State = EMTD_EnemyAiState::Attack;
+        }
+
+        Enemy->PerformNativeAttack();
+        return;
+    }
+
+    if (Agent.State == EMTD_EnemyAiState::Attack)
+    {
+        Controller->ClearFocus(EAIFocusPriority::Gameplay);
+    }
+
+    const EMTD_EnemyAiState NewState =
+        (IsValid(Target)) ? (EMTD_EnemyAiState::ChaseTarget) : (EMTD_EnemyAiState::MoveToCore);
+    AActor *Goal = (IsValid(Target)) ? (Target) : (AMTD_GameModeBase::GetCachedGameTarget(Enemy, Agent.GameTarget));
+    Agent.State = NewState;
+
+    if (!IsValid(Goal))
+    {
+        return;
+    }
+
+    // Requests are issued only when something has changed, or when the last one is over
+    if ((Goal != Agent.MoveGoal.Get()) || (Controller->GetMoveStatus() == EPathFollowingStatus::Idle))
+    {
+        Controller->MoveToActor(Goal, AcceptanceRadius);
+        Agent.MoveGoal = Goal;
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+/** Frames a benchmark wave is given to be possessed and to settle in its mode before it's measured. */
+static constexpr int32 BenchmarkSettleFrames = 60;
+
+void UMTD_EnemyAiSubsystem::StartEnemyAiBenchmark(int32 EnemyCount, int32 Frames)
+{
+    if (Benchmark.IsSet())
+    {
+        MTD_WARN("An enemy AI benchmark is already running.");
+        return;
+    }
+
+    TActorIterator<AMTD_CharacterSpawner> SpawnerIt(GetWorld());
+    if (!SpawnerIt)
+    {
+        MTD_WARN("There are no character spawners.");
+        return;
+    }
+
+    FEnemyAiBenchmark &NewBenchmark = Benchmark.Emplace();
+    for (AMTD_BaseCharacter *Character : SpawnerIt->SpawnWave(FMath::Max(EnemyCount, 1)))
+    {
+        NewBenchmark.Wave.Add(Character);
+    }
+
+    if (NewBenchmark.Wave.IsEmpty())
+    {
+        MTD_WARN("Character spawner [%s] has spawned nothing.", *SpawnerIt->GetName());
+        Benchmark.Reset();
+        return;
+    }
+
+    NewBenchmark.Frames = FMath::Max(Frames, 1);
+    NewBenchmark.Frame = -BenchmarkSettleFrames;
+    NewBenchmark.TickStartHandle =
+        FWorldDelegates::OnWorldTickStart.AddUObject(this, &ThisClass::OnBenchmarkWorldTickStart);
+    NewBenchmark.PostActorTickHandle =
+        FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnBenchmarkWorldPostActorTick);
+}
+
+void UMTD_EnemyAiSubsystem::SetBenchmarkWaveAi(bool bNativeAi)
+{
+    for (const TWeakObjectPtr<AMTD_BaseCharacter> &Character : Benchmark->Wave)
+    {
+        auto Controller = (Character.IsValid()) ? (Cast<AMTD_EnemyController>(Character->GetController())) : (nullptr);
+        if (IsValid(Controller))
+        {
+            Controller->SetNativeAi(bNativeAi);
+        }
+    }
+}
+
+void UMTD_EnemyAiSubsystem::StopEnemyAiBenchmark()
+{
+    if (!Benchmark.IsSet())
+    {
+        return;
+    }
+
+    for (const TWeakObjectPtr<AMTD_BaseCharacter> &Character : Benchmark->Wave)
+    {
+        if (Character.IsValid())
+        {
+            Character->Destroy();
+        }
+    }
+
+    FWorldDelegates::OnWorldTickStart.Remove(Benchmark->TickStartHandle);
+    FWorldDelegates::OnWorldPostActorTick.Remove(Benchmark->PostActorTickHandle);
+    Benchmark.Reset();
+}
+
+void UMTD_EnemyAiSubsystem::OnBenchmarkWorldTickStart(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if ((InWorld == GetWorld()) && (Benchmark.IsSet()))
+    {
+        Benchmark->TickStartSeconds = FPlatformTime::Seconds();
+    }
+}
+
+void UMTD_EnemyAiSubsystem::OnBenchmarkWorldPostActorTick(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if ((InWorld != GetWorld()) || (!Benchmark.IsSet()))
+    {
+        return;
+    }
+
+    FEnemyAiBenchmark &Bench = Benchmark.GetValue();
+    const int32 Mode = (Bench.bNativeAi) ? (1) : (0);
+
+    if (Bench.Frame < 0)
+    {
+        // Controllers pick their own mode on the tick after possess, hence the wave's one is enforced while it settles
+        SetBenchmarkWaveAi(Bench.bNativeAi);
+        Bench.Frame++;
+        return;
+    }
+
+    // The world tick covers controllers, their behavior tree components and this subsystem, time-sliced as configured
+    Bench.TickSeconds[Mode] += FPlatformTime::Seconds() - Bench.TickStartSeconds;
+    Bench.Frame++;
+    if (Bench.Frame < Bench.Frames)
+    {
+        return;
+    }
+
+    if (!Bench.bNativeAi)
+    {
+        // The very same wave is switched, hence both modes drive the same enemies
+        Bench.bNativeAi = true;
+        Bench.Frame = -BenchmarkSettleFrames;
+        return;
+    }
+
+    int32 Controllers = 0;
+    for (const TWeakObjectPtr<AMTD_BaseCharacter> &Character : Bench.Wave)
+    {
+        if ((Character.IsValid()) && (IsValid(Cast<AMTD_EnemyController>(Character->GetController()))))
+        {
+            Controllers++;
+        }
+    }
+
+    if (Controllers < Bench.Wave.Num())
+    {
+        MTD_WARN("%d out of %d enemies have no enemy controller, e.g. are controller-less or gone.",
+            Bench.Wave.Num() - Controllers, Bench.Wave.Num());
+    }
+
+    const double TreeFrameMs = Bench.TickSeconds[0] * 1000.0 / Bench.Frames;
+    const double NativeFrameMs = Bench.TickSeconds[1] * 1000.0 / Bench.Frames;
+    MTD_LOG("%d enemies with controllers over %d frames: with behavior trees the world ticked in %.3f ms per frame, "
+        "with the native state machine updating at most %d of them per frame it ticked in %.3f ms per frame.",
+        Controllers, Bench.Frames, TreeFrameMs, FMath::Max(MaxAgentsPerFrame, 1), NativeFrameMs);
+
+    StopEnemyAiBenchmark();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs EnemyAiBenchmarkCommand(
+    TEXT("mtd.EnemyAiBenchmark"),
+    TEXT("Spawn a wave from the first character spawner, drive it by behavior trees and by the native state machine "
+        "in turn, and compare the world tick time. Usage: mtd.EnemyAiBenchmark [Enemies=500] [Frames=100]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_EnemyAiSubsystem *EnemyAiSubsystem = UMTD_EnemyAiSubsystem::Get(World);
+        if (!IsValid(EnemyAiSubsystem))
+        {
+            return;
+        }
+
+        const int32 EnemyCount = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (500);
+        const int32 Frames = (Args.IsValidIndex(1)) ? (FCString::Atoi(*Args[1])) : (100);
+        EnemyAiSubsystem->StartEnemyAiBenchmark(EnemyCount, Frames);
+    }));
+#endif
@@ -8,7 +8,9 @@
 #include "Character/MTD_EnemyExtensionComponent.h"
 #include "Character/MTD_HealthComponent.h"
 #include "Character/MTD_TeamComponent.h"
+#include "CombatSystem/MTD_KnockbackSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Player/MTD_EnemyAiSubsystem.h"
 #include "Utility/MTD_Utility.h"
 
 AMTD_EnemyController::AMTD_EnemyController()
@@ -21,7 +23,9 @@ AMTD_EnemyController::AMTD_EnemyController()
     Team = CreateDefaultSubobject<UMTD_TeamComponent>(TEXT("MTD Team Component"));
 
     bAttachToPawn = true;
-    bWantsPlayerState = true;
+
+    // Player state owns the ability system, hence it's created on possess only for enemies that aren't lite
+    bWantsPlayerState = false;
 }
 
 void AMTD_EnemyController::Tick(float DeltaSeconds)
@@ -36,11 +40,33 @@ void AMTD_EnemyController::Tick(float DeltaSeconds)
     }
 }
 
+void AMTD_EnemyController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (bNativeAi)
+    {
+        UMTD_EnemyAiSubsystem *EnemyAiSubsystem = UMTD_EnemyAiSubsystem::Get(this);
+        if (IsValid(EnemyAiSubsystem))
+        {
+            EnemyAiSubsystem->UnregisterController(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void AMTD_EnemyController::OnPossess(APawn *InPawn)
 {
+    auto Enemy = CastChecked<AMTD_BaseEnemyCharacter>(InPawn);
+
+    // Pawn picks the player state up on possess
+    if ((!Enemy->IsLiteCombat()) && (!IsValid(PlayerState)))
+    {
+        bWantsPlayerState = true;
+        InitPlayerState();
+    }
+
     Super::OnPossess(InPawn);
 
-    auto Enemy = CastChecked<AMTD_BaseEnemyCharacter>(InPawn);
     Enemy->OnNewTargetDelegate.AddDynamic(this, &ThisClass::OnNewTarget);
 
     UMTD_HealthComponent *HealthComponent = Enemy->GetHealthComponent();
@@ -62,13 +88,35 @@ void AMTD_EnemyController::OnPossess(APawn *InPawn)
 void AMTD_EnemyController::PostOnPossess()
 {
     auto Enemy = Cast<AMTD_BaseEnemyCharacter>(GetPawn());
-    
-    StartRunningBehaviorTree(Enemy);
+
+    UMTD_EnemyAiSubsystem *EnemyAiSubsystem = UMTD_EnemyAiSubsystem::Get(this);
+    if ((Enemy->UsesNativeAi()) && (IsValid(EnemyAiSubsystem)))
+    {
+        bNativeAi = true;
+        EnemyAiSubsystem->RegisterController(this);
+    }
+    else
+    {
+        StartRunningBehaviorTree(Enemy);
+    }
+
     SetupKnockbacks(Enemy);
 }
 
 void AMTD_EnemyController::OnPawnDied_Implementation(AActor *Actor)
 {
+    if (bNativeAi)
+    {
+        UMTD_EnemyAiSubsystem *EnemyAiSubsystem = UMTD_EnemyAiSubsystem::Get(this);
+        if (IsValid(EnemyAiSubsystem))
+        {
+            EnemyAiSubsystem->UnregisterController(this);
+        }
+
+        StopMovement();
+        return;
+    }
+
     BehaviorTreeComponent->StopTree();
 }
 
@@ -88,12 +136,14 @@ void AMTD_EnemyController::OnNewTarget(AActor *OldTarget, AActor *NewTarget)
         HealthComponent->OnDeathStarted.AddDynamic(this, &ThisClass::OnTargetDied);
     }
 
-    GetBlackboardComponent()->SetValueAsObject(FName("Target"), NewTarget);
+    Target = NewTarget;
+    TargetKey.SetValue(*GetBlackboardComponent(), NewTarget);
 }
 
 void AMTD_EnemyController::OnTargetDied(AActor *Actor)
 {
-    GetBlackboardComponent()->SetValueAsObject(FName("Target"), nullptr);
+    Target = nullptr;
+    TargetKey.SetValue(*GetBlackboardComponent(), nullptr);
 }
 
 void AMTD_EnemyController::OnStartAttacking()
@@ -101,7 +151,7 @@ void AMTD_EnemyController::OnStartAttacking()
     if (!bAttack)
     {
         bAttack = true;
-        GetBlackboardComponent()->SetValueAsBool(FName("Attack"), bAttack);
+        AttackKey.SetValue(*GetBlackboardComponent(), bAttack);
     }
 }
 
@@ -110,27 +160,64 @@ void AMTD_EnemyController::OnStopAttacking()
     if (bAttack)
     {
         bAttack = false;
-        GetBlackboardComponent()->SetValueAsBool(FName("Attack"), bAttack);
+        AttackKey.SetValue(*GetBlackboardComponent(), bAttack);
     }
 }
 
-void AMTD_EnemyController::OnKnockback(const UMTD_BalanceHitData *HitData)
+void AMTD_EnemyController::OnKnockback(const FMTD_BalanceHit &HitData)
 {
-    check(HitData);
-
-    if (KnockbackTimerHandle.IsValid())
+    if (bKnockback)
     {
         return;
     }
 
-    GetBlackboardComponent()->SetValueAsBool(FName("Knockback"), true);
-    GetWorldTimerManager().SetTimer(KnockbackTimerHandle, this, &ThisClass::ResetKnockback, 0.01f, false);
+    UMTD_KnockbackSubsystem *KnockbackSubsystem = UMTD_KnockbackSubsystem::Get(this);
+    if (IsValid(KnockbackSubsystem))
+    {
+        KnockbackSubsystem->QueueKnockback(this, HitData);
+    }
 }
 
-void AMTD_EnemyController::ResetKnockback()
+void AMTD_EnemyController::SetKnockback(bool bInKnockback)
 {
-    KnockbackTimerHandle.Invalidate();
-    GetBlackboardComponent()->SetValueAsBool(FName("Knockback"), false);
+    if (bKnockback != bInKnockback)
+    {
+        bKnockback = bInKnockback;
+        KnockbackKey.SetValue(*GetBlackboardComponent(), bKnockback);
+    }
+
+    // The state machine may not update the enemy this frame, hence it's told about the knockback right away
+    if ((bNativeAi) && (bInKnockback))
+    {
+        UMTD_EnemyAiSubsystem *EnemyAiSubsystem = UMTD_EnemyAiSubsystem::Get(this);
+        if (IsValid(EnemyAiSubsystem))
+        {
+            EnemyAiSubsystem->KnockBack(this, KnockbackTime);
+        }
+    }
+}
+
+void AMTD_EnemyController::SetNativeAi(bool bInNativeAi)
+{
+    auto Enemy = Cast<AMTD_BaseEnemyCharacter>(GetPawn());
+    UMTD_EnemyAiSubsystem *EnemyAiSubsystem = UMTD_EnemyAiSubsystem::Get(this);
+    if ((bNativeAi == bInNativeAi) || (!IsValid(Enemy)) || (!IsValid(EnemyAiSubsystem)))
+    {
+        return;
+    }
+
+    bNativeAi = bInNativeAi;
+    if (bNativeAi)
+    {
+        BehaviorTreeComponent->StopTree();
+        EnemyAiSubsystem->RegisterController(this);
+    }
+    else
+    {
+        EnemyAiSubsystem->UnregisterController(this);
+        StopMovement();
+        StartRunningBehaviorTree(Enemy);
+    }
 }
 
 void AMTD_EnemyController::StartRunningBehaviorTree(AMTD_BaseEnemyCharacter *Enemy)
@@ -142,10 +229,29 @@ void AMTD_EnemyController::StartRunningBehaviorTree(AMTD_BaseEnemyCharacter *Ene
         return;
     }
 
-    GetBlackboardComponent()->InitializeBlackboard(*(BehaviorTree->BlackboardAsset));
+    UBlackboardComponent &BlackboardComponent = *GetBlackboardComponent();
+    BlackboardComponent.InitializeBlackboard(*(BehaviorTree->BlackboardAsset));
+    ResolveBlackboardKeys();
+
+    // Blackboard is initialized empty, e.g. when switching from the native state machine, hence it's caught up
+    TargetKey.SetValue(BlackboardComponent, Target.Get());
+    AttackKey.SetValue(BlackboardComponent, bAttack);
+    KnockbackKey.SetValue(BlackboardComponent, bKnockback);
+    KnockbackTimeKey.SetValue(BlackboardComponent, KnockbackTime);
+
     BehaviorTreeComponent->StartTree(*BehaviorTree, EBTExecutionMode::Looped);
 }
 
+void AMTD_EnemyController::ResolveBlackboardKeys()
+{
+    const UBlackboardComponent &BlackboardComponent = *GetBlackboardComponent();
+
+    TargetKey.Resolve(BlackboardComponent);
+    AttackKey.Resolve(BlackboardComponent);
+    KnockbackKey.Resolve(BlackboardComponent);
+    KnockbackTimeKey.Resolve(BlackboardComponent);
+}
+
 void AMTD_EnemyController::SetupKnockbacks(AMTD_BaseEnemyCharacter *Enemy)
 {
     UMTD_BalanceComponent *BalanceComponent = Enemy->GetBalanceComponent();
@@ -155,6 +261,7 @@ void AMTD_EnemyController::SetupKnockbacks(AMTD_BaseEnemyCharacter *Enemy)
     const auto EnemyData = EnemyExtensionComponent->GetEnemyData<UMTD_EnemyData>();
     if (IsValid(EnemyData))
     {
-        GetBlackboardComponent()->SetValueAsFloat(FName("KnockbackTime"), EnemyData->KnockbackTime);
+        KnockbackTime = EnemyData->KnockbackTime;
+        KnockbackTimeKey.SetValue(*GetBlackboardComponent(), EnemyData->KnockbackTime);
     }
 }
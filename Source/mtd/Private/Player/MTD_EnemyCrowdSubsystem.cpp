@@ -0,0 +1,429 @@
+#include "Player/MTD_EnemyCrowdSubsystem.h"
+
+#include "Character/MTD_BaseEnemyCharacter.h"
+#include "Character/MTD_CharacterSpawner.h"
+#include "Character/MTD_HealthComponent.h"
+#include "EngineUtils.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameModes/MTD_GameModeBase.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavigationSystem.h"
+#include "Utility/MTD_Utility.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Crowd"), STAT_MtdEnemyCrowd, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Crowd Paths"), STAT_MtdEnemyCrowdPaths, STATGROUP_Mtd);
+
+UMTD_EnemyCrowdSubsystem *UMTD_EnemyCrowdSubsystem::Get(const UObject *WorldContextObject)
+{
+    const UWorld *World = (IsValid(WorldContextObject)) ? (WorldContextObject->GetWorld()) : (nullptr);
+    return (IsValid(World)) ? (World->GetSubsystem<UMTD_EnemyCrowdSubsystem>()) : (nullptr);
+}
+
+bool UMTD_EnemyCrowdSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return ((IsValid(World)) && (World->IsGameWorld()) && (Super::ShouldCreateSubsystem(Outer)));
+}
+
+void UMTD_EnemyCrowdSubsystem::Deinitialize()
+{
+    for (const FCrowdAgent &Agent : Agents)
+    {
+        AMTD_BaseEnemyCharacter *Enemy = Agent.Enemy.Get();
+        if (IsValid(Enemy))
+        {
+            Enemy->CrowdIndex = INDEX_NONE;
+        }
+    }
+
+    Agents.Empty();
+    NextPathAgentIndex = 0;
+
+#if !UE_BUILD_SHIPPING
+    StopCrowdBenchmark();
+#endif
+
+    Super::Deinitialize();
+}
+
+void UMTD_EnemyCrowdSubsystem::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (Agents.IsEmpty())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_MtdEnemyCrowd);
+
+    const double NowSeconds = GetWorld()->GetTimeSeconds();
+    const int32 MaxPaths = FMath::Max(MaxPathsPerFrame, 1);
+    const int32 StartIndex = NextPathAgentIndex % Agents.Num();
+    int32 Paths = 0;
+
+    // Every agent is steered, while paths are found for the first ones needing them, starting where the last frame
+    // has run out of its budget
+    for (int32 i = 0; i < Agents.Num(); i++)
+    {
+        const int32 Index = (StartIndex + i) % Agents.Num();
+        FCrowdAgent &Agent = Agents[Index];
+        if ((UpdateAgent(Agent, NowSeconds)) && (Paths < MaxPaths))
+        {
+            FindPath(Agent, GetGoal(Agent), NowSeconds);
+
+            Paths++;
+            if (Paths == MaxPaths)
+            {
+                NextPathAgentIndex = Index + 1;
+            }
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_MtdEnemyCrowdPaths, Paths);
+}
+
+TStatId UMTD_EnemyCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMTD_EnemyCrowdSubsystem, STATGROUP_Tickables);
+}
+
+void UMTD_EnemyCrowdSubsystem::RegisterEnemy(AMTD_BaseEnemyCharacter *Enemy)
+{
+    if ((!IsValid(Enemy)) || (Enemy->CrowdIndex != INDEX_NONE))
+    {
+        return;
+    }
+
+    Enemy->CrowdIndex = Agents.Num();
+
+    FCrowdAgent &Agent = Agents.AddDefaulted_GetRef();
+    Agent.Enemy = Enemy;
+}
+
+void UMTD_EnemyCrowdSubsystem::UnregisterEnemy(AMTD_BaseEnemyCharacter *Enemy)
+{
+    if ((!IsValid(Enemy)) || (!Agents.IsValidIndex(Enemy->CrowdIndex)))
+    {
+        return;
+    }
+
+    const int32 Index = Enemy->CrowdIndex;
+    Enemy->CrowdIndex = INDEX_NONE;
+
+    // Swap the last agent in, and point its enemy to its new place
+    Agents.RemoveAtSwap(Index, 1, false);
+    if (Agents.IsValidIndex(Index))
+    {
+        AMTD_BaseEnemyCharacter *MovedEnemy = Agents[Index].Enemy.Get();
+        if (IsValid(MovedEnemy))
+        {
+            MovedEnemy->CrowdIndex = Index;
+        }
+    }
+}
+
+void UMTD_EnemyCrowdSubsystem::KnockBack(AMTD_BaseEnemyCharacter *Enemy, float Seconds)
+{
+    if ((!IsValid(Enemy)) || (!Agents.IsValidIndex(Enemy->CrowdIndex)))
+    {
+        return;
+    }
+
+    FCrowdAgent &Agent = Agents[Enemy->CrowdIndex];
+    if (Agent.State == EMTD_EnemyAiState::Dead)
+    {
+        return;
+    }
+
+    Enemy->GetCharacterMovement()->StopMovementImmediately();
+
+    Agent.State = EMTD_EnemyAiState::Knockback;
+    Agent.StateEndSeconds = GetWorld()->GetTimeSeconds() + Seconds;
+}
+
+bool UMTD_EnemyCrowdSubsystem::UpdateAgent(FCrowdAgent &Agent, double NowSeconds) const
+{
+    AMTD_BaseEnemyCharacter *Enemy = Agent.Enemy.Get();
+    if ((!IsValid(Enemy)) || (Agent.State == EMTD_EnemyAiState::Dead))
+    {
+        return false;
+    }
+
+    UCharacterMovementComponent *MovementComponent = Enemy->GetCharacterMovement();
+    if (Enemy->GetHealthComponent()->IsDeadOrDying())
+    {
+        MovementComponent->StopMovementImmediately();
+        Agent.State = EMTD_EnemyAiState::Dead;
+        return false;
+    }
+
+    if ((Agent.State == EMTD_EnemyAiState::Knockback) && (NowSeconds < Agent.StateEndSeconds))
+    {
+        return false;
+    }
+
+    // Attack whatever is inside the attack trigger
+    if (!Enemy->AttackTargets.IsEmpty())
+    {
+        const APawn *AttackTarget = Enemy->AttackTargets[0];
+        if ((Agent.State != EMTD_EnemyAiState::Attack) && (IsValid(AttackTarget)))
+        {
+            const FVector Direction = AttackTarget->GetActorLocation() - Enemy->GetActorLocation();
+            Enemy->SetActorRotation(FRotator(0.f, Direction.Rotation().Yaw, 0.f));
+        }
+
+        Agent.State = EMTD_EnemyAiState::Attack;
+        Enemy->PerformNativeAttack();
+        return false;
+    }
+
+    AActor *Goal = GetGoal(Agent);
+    Agent.State = (IsValid(Enemy->Target)) ? (EMTD_EnemyAiState::ChaseTarget) : (EMTD_EnemyAiState::MoveToCore);
+    if (!IsValid(Goal))
+    {
+        return false;
+    }
+
+    // A path to another goal is of no use, while a path to a moving target is followed until a new one is found
+    if (Goal != Agent.PathGoal.Get())
+    {
+        return true;
+    }
+
+    const bool bNeedsPath =
+        ((Agent.State == EMTD_EnemyAiState::ChaseTarget) && (NowSeconds >= Agent.RepathSeconds));
+
+    const FVector Location = Enemy->GetNavAgentLocation();
+    if (FVector::DistSquared2D(Location, Goal->GetActorLocation()) <= FMath::Square(AcceptanceRadius))
+    {
+        return bNeedsPath;
+    }
+
+    const float PathPointRadiusSquared = FMath::Square(PathPointRadius);
+    while ((Agent.PathPoints.IsValidIndex(Agent.PathPointIndex)) &&
+        (FVector::DistSquared2D(Location, Agent.PathPoints[Agent.PathPointIndex]) <= PathPointRadiusSquared))
+    {
+        Agent.PathPointIndex++;
+    }
+
+    if (!Agent.PathPoints.IsValidIndex(Agent.PathPointIndex))
+    {
+        return bNeedsPath;
+    }
+
+    const FVector Direction = (Agent.PathPoints[Agent.PathPointIndex] - Location).GetSafeNormal2D();
+    MovementComponent->RequestDirectMove(Direction * MovementComponent->GetMaxSpeed(), false);
+
+    return bNeedsPath;
+}
+
+void UMTD_EnemyCrowdSubsystem::FindPath(FCrowdAgent &Agent, AActor *Goal, double NowSeconds) const
+{
+    Agent.PathGoal = Goal;
+    Agent.PathPoints.Reset();
+    Agent.PathPointIndex = 0;
+    Agent.RepathSeconds = NowSeconds + RepathSeconds;
+
+    AMTD_BaseEnemyCharacter *Enemy = Agent.Enemy.Get();
+    const FMTD_PathFindingContext Context = FMTD_PathFindingContext::Create(Enemy);
+    if ((!IsValid(Goal)) || (!Context.IsValid()))
+    {
+        return;
+    }
+
+    const FSharedConstNavQueryFilter QueryFilter =
+        UNavigationQueryFilter::GetQueryFilter(*Context.NavigationData, Enemy, Context.NavQueryFilter);
+    const FPathFindingQuery Query(
+        Enemy, *Context.NavigationData, Context.StartPosition, Goal->GetActorLocation(), QueryFilter);
+
+    const FPathFindingResult Result = Context.NavigationSystem->FindPathSync(Query);
+    if ((!Result.IsSuccessful()) || (!Result.Path.IsValid()))
+    {
+        return;
+    }
+
+    for (const FNavPathPoint &PathPoint : Result.Path->GetPathPoints())
+    {
+        Agent.PathPoints.Add(PathPoint.Location);
+    }
+}
+
+AActor *UMTD_EnemyCrowdSubsystem::GetGoal(FCrowdAgent &Agent) const
+{
+    AMTD_BaseEnemyCharacter *Enemy = Agent.Enemy.Get();
+    if (IsValid(Enemy->Target))
+    {
+        return Enemy->Target;
+    }
+
+    return AMTD_GameModeBase::GetCachedGameTarget(Enemy, Agent.GameTarget);
+}
+
+#if !UE_BUILD_SHIPPING
+/** Frames a benchmark wave is given to be possessed and find its first paths before it's measured. */
+static constexpr int32 BenchmarkSettleFrames = 60;
+
+void UMTD_EnemyCrowdSubsystem::StartCrowdBenchmark(int32 EnemyCount, int32 Frames)
+{
+    if (Benchmark.IsSet())
+    {
+        MTD_WARN("A crowd benchmark is already running.");
+        return;
+    }
+
+    TActorIterator<AMTD_CharacterSpawner> SpawnerIt(GetWorld());
+    if (!SpawnerIt)
+    {
+        MTD_WARN("There are no character spawners.");
+        return;
+    }
+
+    FCrowdBenchmark &NewBenchmark = Benchmark.Emplace();
+    NewBenchmark.Spawner = *SpawnerIt;
+    NewBenchmark.EnemyCount = FMath::Max(EnemyCount, 1);
+    NewBenchmark.Frames = FMath::Max(Frames, 1);
+    NewBenchmark.TickStartHandle =
+        FWorldDelegates::OnWorldTickStart.AddUObject(this, &ThisClass::OnBenchmarkWorldTickStart);
+    NewBenchmark.PostActorTickHandle =
+        FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnBenchmarkWorldPostActorTick);
+
+    SpawnBenchmarkWave();
+}
+
+void UMTD_EnemyCrowdSubsystem::SpawnBenchmarkWave()
+{
+    FCrowdBenchmark &Bench = Benchmark.GetValue();
+    AMTD_CharacterSpawner *Spawner = Bench.Spawner.Get();
+    if (!IsValid(Spawner))
+    {
+        MTD_WARN("Character spawner is gone, the crowd benchmark is aborted.");
+        StopCrowdBenchmark();
+        return;
+    }
+
+    // Both waves use lite combat, since controller-less enemies require it, hence only the controllers differ
+    const bool bControllerless = Bench.bControllerless;
+    const auto OverrideLiteCombat = [bControllerless](AMTD_BaseCharacter *Character)
+    {
+        const auto Enemy = Cast<AMTD_BaseEnemyCharacter>(Character);
+        if (IsValid(Enemy))
+        {
+            Enemy->OverrideLiteCombat(bControllerless);
+        }
+    };
+
+    // Both waves are spawned at the same spots
+    for (AMTD_BaseCharacter *Character : Spawner->SpawnWave(Bench.EnemyCount, OverrideLiteCombat))
+    {
+        Bench.Wave.Add(Character);
+    }
+
+    if (Bench.Wave.IsEmpty())
+    {
+        MTD_WARN("Character spawner [%s] has spawned nothing, the crowd benchmark is aborted.", *Spawner->GetName());
+        StopCrowdBenchmark();
+        return;
+    }
+
+    if (!Bench.Wave[0]->IsA<AMTD_BaseEnemyCharacter>())
+    {
+        MTD_WARN("Character spawner [%s] doesn't spawn enemies, both waves are the same.", *Spawner->GetName());
+    }
+
+    Bench.Frame = -BenchmarkSettleFrames;
+}
+
+void UMTD_EnemyCrowdSubsystem::DestroyBenchmarkWave()
+{
+    for (const TWeakObjectPtr<AMTD_BaseCharacter> &Character : Benchmark->Wave)
+    {
+        if (Character.IsValid())
+        {
+            Character->Destroy();
+        }
+    }
+
+    Benchmark->Wave.Reset();
+}
+
+void UMTD_EnemyCrowdSubsystem::StopCrowdBenchmark()
+{
+    if (!Benchmark.IsSet())
+    {
+        return;
+    }
+
+    FWorldDelegates::OnWorldTickStart.Remove(Benchmark->TickStartHandle);
+    FWorldDelegates::OnWorldPostActorTick.Remove(Benchmark->PostActorTickHandle);
+    Benchmark.Reset();
+}
+
+void UMTD_EnemyCrowdSubsystem::OnBenchmarkWorldTickStart(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if ((InWorld == GetWorld()) && (Benchmark.IsSet()))
+    {
+        Benchmark->TickStartSeconds = FPlatformTime::Seconds();
+    }
+}
+
+void UMTD_EnemyCrowdSubsystem::OnBenchmarkWorldPostActorTick(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if ((InWorld != GetWorld()) || (!Benchmark.IsSet()))
+    {
+        return;
+    }
+
+    FCrowdBenchmark &Bench = Benchmark.GetValue();
+    const int32 Mode = (Bench.bControllerless) ? (1) : (0);
+
+    if (Bench.Frame < 0)
+    {
+        Bench.Frame++;
+        Bench.Actors[Mode] = InWorld->GetActorCount();
+        return;
+    }
+
+    // The world tick covers actors, controllers, their components and tickable objects, this subsystem included
+    Bench.TickSeconds[Mode] += FPlatformTime::Seconds() - Bench.TickStartSeconds;
+    Bench.Frame++;
+    if (Bench.Frame < Bench.Frames)
+    {
+        return;
+    }
+
+    DestroyBenchmarkWave();
+
+    if (!Bench.bControllerless)
+    {
+        Bench.bControllerless = true;
+        SpawnBenchmarkWave();
+        return;
+    }
+
+    const double ControllersFrameMs = Bench.TickSeconds[0] * 1000.0 / Bench.Frames;
+    const double ControllerlessFrameMs = Bench.TickSeconds[1] * 1000.0 / Bench.Frames;
+    MTD_LOG("%d lite enemies over %d frames: with controllers the world had %d actors and ticked in %.3f ms per "
+        "frame, controller-less it had %d actors and ticked in %.3f ms per frame.", Bench.EnemyCount, Bench.Frames,
+        Bench.Actors[0], ControllersFrameMs, Bench.Actors[1], ControllerlessFrameMs);
+
+    StopCrowdBenchmark();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CrowdBenchmarkCommand(
+    TEXT("mtd.CrowdBenchmark"),
+    TEXT("Spawn a wave of lite enemies from the first character spawner with controllers, then the same wave "
+        "controller-less, and compare the world tick time. Usage: mtd.CrowdBenchmark [Enemies=500] [Frames=100]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        UMTD_EnemyCrowdSubsystem *CrowdSubsystem = UMTD_EnemyCrowdSubsystem::Get(World);
+        if (!IsValid(CrowdSubsystem))
+        {
+            return;
+        }
+
+        const int32 EnemyCount = (Args.IsValidIndex(0)) ? (FCString::Atoi(*Args[0])) : (500);
+        const int32 Frames = (Args.IsValidIndex(1)) ? (FCString::Atoi(*Args[1])) : (100);
+        CrowdSubsystem->StartCrowdBenchmark(EnemyCount, Frames);
+    }));
+#endif
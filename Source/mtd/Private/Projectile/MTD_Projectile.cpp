@@ -2,11 +2,23 @@
 
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "AbilitySystem/Effects/MTD_GameplayEffect.h"
+#include "AbilitySystem/MTD_DamageSubsystem.h"
 #include "AbilitySystem/MTD_GameplayTags.h"
+#include "Character/MTD_BalanceComponent.h"
+#include "Character/MTD_BaseCharacter.h"
+#include "Character/MTD_CharacterSpawner.h"
+#include "Character/MTD_HealthComponent.h"
+#include "CombatSystem/MTD_LiteCombat.h"
 #include "Components/CapsuleComponent.h"
+#include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "Projectile/MTD_ProjectileMovementComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Projectile Hit"), STAT_MtdProjectileHit, STATGROUP_Mtd);
+DECLARE_CYCLE_STAT(TEXT("Projectile Radial Hit"), STAT_MtdProjectileRadialHit, STATGROUP_Mtd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Radial Targets"), STAT_MtdProjectileRadialTargets, STATGROUP_Mtd);
+
 AMTD_Projectile::AMTD_Projectile()
 {
     PrimaryActorTick.bCanEverTick = false;
@@ -38,11 +50,68 @@ void AMTD_Projectile::AddGameplayEffectClassToGrantOnHit(const TSubclassOf<UMTD_
     GameplayEffectClassesToGrantOnHit.Add(GeClass);
 }
 
+void AMTD_Projectile::AddGameplayEffectSpecsToGrantOnHit(const TArray<FGameplayEffectSpecHandle> &SpecHandles)
+{
+    GameplayEffectsToGrantOnHit.Append(SpecHandles);
+}
+
 void AMTD_Projectile::SetGameplayEffectDamageClass(const TSubclassOf<UMTD_GameplayEffect> &GeClass)
 {
     GameplayEffectDamageClass = GeClass;
 }
 
+void AMTD_Projectile::GetHitGameplayEffectClasses(TArray<TSubclassOf<UMTD_GameplayEffect>> &OutGeClasses) const
+{
+    if (GameplayEffectBalanceClass)
+    {
+        OutGeClasses.Add(GameplayEffectBalanceClass);
+    }
+
+    // Applied last, since dying overrides any animation the other effects may have started
+    if (GameplayEffectDamageClass)
+    {
+        OutGeClasses.Add(GameplayEffectDamageClass);
+    }
+}
+
+void AMTD_Projectile::MakeSharedGameplayEffectSpecs(
+    const UAbilitySystemComponent &Asc,
+    const TArray<TSubclassOf<UMTD_GameplayEffect>> &GeClasses,
+    float Level,
+    TArray<FGameplayEffectSpecHandle> &OutSpecHandles)
+{
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+
+    // Replaced by each hit's own context
+    const FGameplayEffectContextHandle GeContextHandle = Asc.MakeEffectContext();
+
+    for (const TSubclassOf<UMTD_GameplayEffect> &GeClass : GeClasses)
+    {
+        if (!GeClass)
+        {
+            continue;
+        }
+
+        FGameplayEffectSpecHandle SpecHandle = Asc.MakeOutgoingSpec(GeClass, Level, GeContextHandle);
+        if (!SpecHandle.IsValid())
+        {
+            continue;
+        }
+
+        // Add every magnitude up front, so that patching them per hit doesn't grow the magnitude map
+        FGameplayEffectSpec &Spec = *SpecHandle.Data;
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Base, 0.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Additive, 0.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Multiplier, 1.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Balance_Damage, 0.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionX, 0.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionY, 0.f);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionZ, 0.f);
+
+        OutSpecHandles.Add(SpecHandle);
+    }
+}
+
 void AMTD_Projectile::BeginPlay()
 {
     Super::BeginPlay();
@@ -64,10 +133,25 @@ void AMTD_Projectile::OnBeginOverlap(
 {
     const FGameplayEventData EventData = PrepareGameplayEventData(SweepResult);
     const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
-    
+
     OnProjectilePreHit(EventData);
-    
-    ApplyGameplayEffectsToTarget(OtherActor);
+
+    // Projectiles neither a tower nor the blueprint has given specs to make their own, once
+    if ((GameplayEffectsToGrantOnHit.IsEmpty()) && (HasNativeHitGameplayEffects()))
+    {
+        BuildGameplayEffectSpecs();
+    }
+
+    HitContextHandle = EventData.ContextHandle;
+
+    if (bIsRadial)
+    {
+        ApplyRadialGameplayEffects(OtherActor);
+    }
+    else
+    {
+        ApplyGameplayEffectsToTarget(OtherActor);
+    }
     
     AbilitySystemComponent->HandleGameplayEvent(GameplayTags.Gameplay_Event_RangeHit, &EventData);
     OnProjectilePostHit(EventData);
@@ -82,30 +166,178 @@ void AMTD_Projectile::OnSelfDestroy_Implementation()
 
 void AMTD_Projectile::ApplyGameplayEffectsToTarget(AActor *Target)
 {
+    SCOPE_CYCLE_COUNTER(STAT_MtdProjectileHit);
+
+    if (ApplyLiteHit(Target, 1.f))
+    {
+        return;
+    }
+
     UAbilitySystemComponent *TargetAsc = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Target);
     if (!IsValid(TargetAsc))
     {
         return;
     }
 
+    ApplyGameplayEffectSpecs(TargetAsc, 1.f);
+}
+
+void AMTD_Projectile::ApplyRadialGameplayEffects(AActor *HitTarget)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MtdProjectileRadialHit);
+
+    const FVector ImpactLocation = GetActorLocation();
+
+    TArray<AActor*> Targets;
+    GatherRadialTargets(ImpactLocation, Targets);
+
+    // The hit target may stick out of the radius with its center, while it's still hit directly
+    if (IsValid(HitTarget))
+    {
+        Targets.AddUnique(HitTarget);
+    }
+
+    INC_DWORD_STAT_BY(STAT_MtdProjectileRadialTargets, Targets.Num());
+
+    for (AActor *Target : Targets)
+    {
+        const float Multiplier = GetRadialMultiplier(Target, ImpactLocation, HitTarget);
+
+        if (ApplyLiteHit(Target, Multiplier))
+        {
+            continue;
+        }
+
+        UAbilitySystemComponent *TargetAsc = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Target);
+        if (!IsValid(TargetAsc))
+        {
+            continue;
+        }
+
+        ApplyGameplayEffectSpecs(TargetAsc, Multiplier);
+    }
+}
+
+float AMTD_Projectile::GetRadialMultiplier(
+    const AActor *Target,
+    const FVector &ImpactLocation,
+    const AActor *HitTarget) const
+{
+    if (Target == HitTarget)
+    {
+        return 1.f;
+    }
+
+    const float Radius = FMath::Max(RadialDamageRadius, KINDA_SMALL_NUMBER);
+    const float Distance = FVector::Dist(ImpactLocation, Target->GetActorLocation());
+    const float Alpha = FMath::Clamp(Distance / Radius, 0.f, 1.f);
+
+    return FMath::Lerp(1.f, RadialDamageEdgeMultiplier, Alpha);
+}
+
+void AMTD_Projectile::GatherRadialTargets(const FVector &Location, TArray<AActor*> &OutTargets) const
+{
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileRadialHit), false, this);
+    QueryParams.AddIgnoredActor(GetOwner());
+
+    // Whatever the projectile would hit directly is hit by the impact
+    TArray<FOverlapResult> Overlaps;
+    GetWorld()->OverlapMultiByProfile(Overlaps, Location, FQuat::Identity,
+        CollisionComponent->GetCollisionProfileName(), FCollisionShape::MakeSphere(RadialDamageRadius), QueryParams);
+
+    // An actor may have several components overlapped
+    OutTargets.Reset(Overlaps.Num());
+    for (const FOverlapResult &Overlap : Overlaps)
+    {
+        AActor *Actor = Overlap.GetActor();
+        if (IsValid(Actor))
+        {
+            OutTargets.AddUnique(Actor);
+        }
+    }
+}
+
+void AMTD_Projectile::ApplyGameplayEffectSpecs(UAbilitySystemComponent *TargetAsc, float Multiplier) const
+{
+    check(TargetAsc);
+
+    const FMTD_GameplayTags &GameplayTags = FMTD_GameplayTags::Get();
+    UMTD_DamageSubsystem *DamageSubsystem = UMTD_DamageSubsystem::Get(this);
+
+    const AActor *TargetActor = TargetAsc->GetAvatarActor();
+    const FVector KnockbackDirection = (IsValid(TargetActor)) ?
+        ((TargetActor->GetActorLocation() - GetActorLocation()).GetSafeNormal2D()) : (GetActorForwardVector());
+
     for (const FGameplayEffectSpecHandle &SpecHandle : GameplayEffectsToGrantOnHit)
     {
         if ((!SpecHandle.IsValid()) || (!SpecHandle.Data))
         {
             continue;
         }
-        
-        // TODO: Check if it's a radial projectile, apply GEs around if so
 
-        FActiveGameplayEffectHandle ActiveGeHandle = TargetAsc->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
+        // Specs are shared by all the projectiles a tower has fired, hence every target gets a copy with this hit's
+        // context and magnitudes, so that neither radial targets nor overlapping shots see each other's values
+        FGameplayEffectSpec Spec(*SpecHandle.Data);
+        if (HitContextHandle.IsValid())
+        {
+            Spec.SetContext(HitContextHandle, true);
+        }
+
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Base, Damage);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Damage_Multiplier, DamageMultiplier * Multiplier);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_Balance_Damage, BalanceDamage * Multiplier);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionX, KnockbackDirection.X);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionY, KnockbackDirection.Y);
+        Spec.SetSetByCallerMagnitude(GameplayTags.SetByCaller_KnockbackDirectionZ, KnockbackDirection.Z);
+
+        // Damage is resolved along with the rest of the hits the target receives this frame
+        if ((IsValid(DamageSubsystem)) && (DamageSubsystem->QueueDamageSpec(Spec, TargetAsc)))
+        {
+            continue;
+        }
+
+        FActiveGameplayEffectHandle ActiveGeHandle = TargetAsc->ApplyGameplayEffectSpecToSelf(Spec);
         if (!ActiveGeHandle.WasSuccessfullyApplied())
         {
             MTDS_WARN("Failed to apply gameplay effect handle [%s] to [%s]",
-                *ActiveGeHandle.ToString(), *Target->GetName());
+                *ActiveGeHandle.ToString(), *GetNameSafe(TargetAsc->GetAvatarActor()));
         }
     }
 }
 
+bool AMTD_Projectile::HasNativeHitGameplayEffects() const
+{
+    return ((GameplayEffectDamageClass) || (GameplayEffectBalanceClass));
+}
+
+void AMTD_Projectile::BuildGameplayEffectSpecs()
+{
+    if (!IsValid(AbilitySystemComponent))
+    {
+        return;
+    }
+
+    TArray<TSubclassOf<UMTD_GameplayEffect>> GeClasses = GameplayEffectClassesToGrantOnHit;
+    GetHitGameplayEffectClasses(GeClasses);
+
+    MakeSharedGameplayEffectSpecs(*AbilitySystemComponent, GeClasses, 1.f, GameplayEffectsToGrantOnHit);
+}
+
+bool AMTD_Projectile::ApplyLiteHit(AActor *Target, float Multiplier) const
+{
+    if (!FMTD_LiteCombat::IsLiteTarget(Target))
+    {
+        return false;
+    }
+
+    const FVector KnockbackDirection = (Target->GetActorLocation() - GetActorLocation()).GetSafeNormal2D();
+    AActor *DamageInstigator =
+        (IsValid(AbilitySystemComponent)) ? (AbilitySystemComponent->GetOwnerActor()) : (nullptr);
+
+    return FMTD_LiteCombat::ApplyHit(Target,
+        Damage * DamageMultiplier * Multiplier, BalanceDamage * Multiplier, KnockbackDirection, DamageInstigator);
+}
+
 void AMTD_Projectile::OnProjectilePreHit_Implementation(const FGameplayEventData &EventData)
 {
     // Empty
@@ -130,6 +362,8 @@ FGameplayEventData AMTD_Projectile::PrepareGameplayEventData(FHitResult HitResul
     
     FGameplayEventData EventData;
     EventData.ContextHandle = AbilitySystemComponent->MakeEffectContext();
+    EventData.ContextHandle.AddSourceObject(this);
+    EventData.ContextHandle.AddHitResult(HitResult, true);
     EventData.Instigator = GetOwner(); // Should be PlayerState
     EventData.Target = HitResult.GetActor();
     EventData.TargetData.Data.Add(
@@ -137,3 +371,242 @@ FGameplayEventData AMTD_Projectile::PrepareGameplayEventData(FHitResult HitResul
 
     return EventData;
 }
+
+#if !UE_BUILD_SHIPPING
+void AMTD_Projectile::RunRadialImpactBenchmark(
+    const FVector &Location,
+    int32 Count,
+    const TArray<AMTD_BaseCharacter*> &Cluster)
+{
+    SetActorLocation(Location);
+
+    TArray<AActor*> Targets;
+
+    double WorstSeconds = 0.0;
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < Count; i++)
+    {
+        const double ImpactStartSeconds = FPlatformTime::Seconds();
+        GatherRadialTargets(Location, Targets);
+        WorstSeconds = FMath::Max(WorstSeconds, FPlatformTime::Seconds() - ImpactStartSeconds);
+    }
+
+    const double TotalSeconds = FPlatformTime::Seconds() - StartSeconds;
+    MTD_LOG("%d radial impacts of %.1f radius reached %d targets each: %.3f us average, %.3f us worst.",
+        Count, RadialDamageRadius, Targets.Num(), TotalSeconds * 1000000.0 / FMath::Max(Count, 1),
+        WorstSeconds * 1000000.0);
+
+    if (Cluster.IsEmpty())
+    {
+        return;
+    }
+
+    struct FSample
+    {
+        const UMTD_HealthComponent *HealthComponent = nullptr;
+        const UMTD_BalanceComponent *BalanceComponent = nullptr;
+        float HealthBefore = 0.f;
+        float BalanceDamageBefore = 0.f;
+        float Multiplier = 0.f;
+        bool bExpectHit = false;
+    };
+
+    // The overlap is tested against capsules, hence skip the ones too close to the edge of the radius to tell
+    constexpr float EdgeTolerance = 10.f;
+
+    TArray<FSample> Samples;
+    Samples.Reserve(Cluster.Num());
+    int32 Skipped = 0;
+
+    for (const AMTD_BaseCharacter *Character : Cluster)
+    {
+        const UMTD_HealthComponent *HealthComponent =
+            (IsValid(Character)) ? (UMTD_HealthComponent::FindHealthComponent(Character)) : (nullptr);
+        if ((!IsValid(HealthComponent)) || (HealthComponent->IsDeadOrDying()))
+        {
+            Skipped++;
+            continue;
+        }
+
+        const float Reach = RadialDamageRadius + Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+        const float Distance = FVector::Dist2D(Location, Character->GetActorLocation());
+        if (FMath::Abs(Distance - Reach) < EdgeTolerance)
+        {
+            Skipped++;
+            continue;
+        }
+
+        FSample &Sample = Samples.AddDefaulted_GetRef();
+        Sample.HealthComponent = HealthComponent;
+        Sample.BalanceComponent = UMTD_BalanceComponent::FindBalanceComponent(Character);
+        Sample.HealthBefore = HealthComponent->GetHealth();
+        Sample.BalanceDamageBefore = (IsValid(Sample.BalanceComponent)) ?
+            (Sample.BalanceComponent->GetLastBalanceHit().BalanceDamage) : (0.f);
+        Sample.Multiplier = GetRadialMultiplier(Character, Location, nullptr);
+        Sample.bExpectHit = (Distance < Reach);
+    }
+
+    if (GameplayEffectsToGrantOnHit.IsEmpty())
+    {
+        BuildGameplayEffectSpecs();
+    }
+
+    if (GameplayEffectsToGrantOnHit.IsEmpty())
+    {
+        MTD_WARN("Projectile [%s] has no hit gameplay effects set, only lite targets can be hit.",
+            *GetClass()->GetName());
+    }
+
+    ApplyRadialGameplayEffects(nullptr);
+
+    // Damage is batched until the end of the frame
+    UMTD_DamageSubsystem *DamageSubsystem = UMTD_DamageSubsystem::Get(this);
+    if (IsValid(DamageSubsystem))
+    {
+        DamageSubsystem->FlushDamage();
+    }
+
+    // Whatever the ability system scales damage and balance damage by, it has to be the same for the whole cluster,
+    // hence compare what every target has received divided by its falloff multiplier against the first target
+    int32 ExpectedHits = 0;
+    int32 Hits = 0;
+    int32 WrongHits = 0;
+    int32 WrongDamage = 0;
+    int32 WrongBalanceDamage = 0;
+    float DamageRatio = -1.f;
+    float BalanceDamageRatio = -1.f;
+
+    auto IsRatioWrong = [](float &FirstRatio, float Ratio)
+    {
+        if (FirstRatio < 0.f)
+        {
+            FirstRatio = Ratio;
+            return false;
+        }
+        return (!FMath::IsNearlyEqual(Ratio, FirstRatio, FirstRatio * 0.01f + KINDA_SMALL_NUMBER));
+    };
+
+    for (const FSample &Sample : Samples)
+    {
+        const float DamageDealt = Sample.HealthBefore - Sample.HealthComponent->GetHealth();
+        const bool bHit = (DamageDealt > 0.f);
+
+        ExpectedHits += (Sample.bExpectHit) ? (1) : (0);
+        if (bHit != Sample.bExpectHit)
+        {
+            WrongHits++;
+            continue;
+        }
+
+        if (!bHit)
+        {
+            continue;
+        }
+
+        Hits++;
+        if (IsRatioWrong(DamageRatio, DamageDealt / (Damage * DamageMultiplier * Sample.Multiplier)))
+        {
+            WrongDamage++;
+        }
+
+        // Balance damage below the threshold isn't recorded
+        const float BalanceDamageDealt = (IsValid(Sample.BalanceComponent)) ?
+            (Sample.BalanceComponent->GetLastBalanceHit().BalanceDamage) : (Sample.BalanceDamageBefore);
+        if ((BalanceDamageDealt != Sample.BalanceDamageBefore) &&
+            (IsRatioWrong(BalanceDamageRatio, BalanceDamageDealt / (BalanceDamage * Sample.Multiplier))))
+        {
+            WrongBalanceDamage++;
+        }
+    }
+
+    const bool bPassed = ((WrongHits == 0) && (WrongDamage == 0) && (WrongBalanceDamage == 0));
+    MTD_LOG("Radial impact on a cluster of %d: %d hit out of %d expected, %d skipped near the edge. Wrong hits: %d, "
+        "wrong damage: %d, wrong balance damage: %d. %s", Cluster.Num(), Hits, ExpectedHits, Skipped, WrongHits,
+        WrongDamage, WrongBalanceDamage, (bPassed) ? (TEXT("Passed.")) : (TEXT("Failed.")));
+
+    ensureMsgf(bPassed, TEXT("Radial impact hits don't match the falloff."));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs RadialImpactBenchmarkCommand(
+    TEXT("mtd.RadialImpactBenchmark"),
+    TEXT("Time radial impacts around the first player, and verify the falloff on a cluster of enemies spawned by the "
+        "first character spawner with a projectile blueprint that sets its hit gameplay effects. "
+        "Usage: mtd.RadialImpactBenchmark [Radius=500] [Count=100] [Enemies=200] [ProjectileClassPath]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+    {
+        const APlayerController *PlayerController = (IsValid(World)) ? (World->GetFirstPlayerController()) : (nullptr);
+        APawn *Pawn = (IsValid(PlayerController)) ? (PlayerController->GetPawn()) : (nullptr);
+        if (!IsValid(Pawn))
+        {
+            MTD_WARN("First player has no pawn.");
+            return;
+        }
+
+        const float Radius = (Args.IsValidIndex(0)) ? (FCString::Atof(*Args[0])) : (500.f);
+        const int32 Count = (Args.IsValidIndex(1)) ? (FCString::Atoi(*Args[1])) : (100);
+        const int32 EnemyCount = (Args.IsValidIndex(2)) ? (FCString::Atoi(*Args[2])) : (200);
+        const FVector Location = Pawn->GetActorLocation();
+
+        UClass *ProjectileClass = (Args.IsValidIndex(3)) ?
+            (LoadClass<AMTD_Projectile>(nullptr, *Args[3])) : (AMTD_Projectile::StaticClass());
+        if (!IsValid(ProjectileClass))
+        {
+            MTD_WARN("Projectile class [%s] couldn't be loaded.", *Args[3]);
+            return;
+        }
+
+        // Spread the cluster evenly over a disc reaching past the radius, so that both hits and misses are tested
+        TArray<AMTD_BaseCharacter*> Cluster;
+        TActorIterator<AMTD_CharacterSpawner> SpawnerIt(World);
+        if (SpawnerIt)
+        {
+            Cluster = SpawnerIt->SpawnWave(Location, Radius * 1.5f, EnemyCount);
+        }
+        else
+        {
+            MTD_WARN("There are no character spawners, only the overlap query is timed.");
+        }
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Owner = Pawn;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        auto Projectile =
+            World->SpawnActor<AMTD_Projectile>(ProjectileClass, Location, FRotator::ZeroRotator, SpawnParams);
+        if (!IsValid(Projectile))
+        {
+            return;
+        }
+
+        // The cluster is hit by hand, the projectile mustn't hit it on its own
+        Projectile->GetCollisionComponent()->SetGenerateOverlapEvents(false);
+        Projectile->GetCollisionComponent()->SetCollisionProfileName(AllyProjectileCollisionProfileName);
+        Projectile->bIsRadial = true;
+        Projectile->RadialDamageRadius = Radius;
+        Projectile->Damage = 1.f;
+        Projectile->BalanceDamage = 1000.f;
+
+        UAbilitySystemComponent *Asc = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn);
+        if (IsValid(Asc))
+        {
+            Projectile->InitializeAbilitySystem(Asc);
+        }
+
+        // Let the cluster finish initializing before it's hit
+        World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(Projectile,
+            [Projectile, Location, Count, Cluster]()
+            {
+                Projectile->RunRadialImpactBenchmark(Location, Count, Cluster);
+                Projectile->Destroy();
+
+                for (AMTD_BaseCharacter *Character : Cluster)
+                {
+                    if (IsValid(Character))
+                    {
+                        Character->Destroy();
+                    }
+                }
+            }));
+    }));
+#endif
@@ -22,6 +22,11 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite,
         meta=(EditCondition="bIsRadial"))
     float RadialDamageRadius = 100.f;
+
+    /** Damage multiplier on the edge of the radius. Damage falls off linearly from the impact point. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite,
+        meta=(EditCondition="bIsRadial", ClampMin="0.0", ClampMax="1.0"))
+    float RadialDamageEdgeMultiplier = 0.5f;
 };
 
 UCLASS(BlueprintType, Const, meta=(ShortTooltip="Data asset used to define a Projectile."))
@@ -0,0 +1,3 @@
+#include "Utility/MTD_BlackboardKey.h"
+
+DEFINE_STAT(STAT_MtdBlackboardWrites);
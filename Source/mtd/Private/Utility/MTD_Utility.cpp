@@ -19,10 +19,12 @@ FGenericTeamId FMTD_Utility::GetMtdGenericTeamId(const AActor *InActor)
         return InvalidTeamId;
     }
 
+    // Pawns nobody possesses may be team agents themselves
     const AController *Controller = Pawn->GetController();
     if (!IsValid(Controller))
     {
-        return InvalidTeamId;
+        const auto TeamAgent = Cast<IGenericTeamAgentInterface>(Pawn);
+        return (TeamAgent) ? (TeamAgent->GetGenericTeamId()) : (InvalidTeamId);
     }
 
     const auto Team = GetActorComponent<UMTD_TeamComponent>(Controller);
@@ -82,8 +84,10 @@ FMTD_PathFindingContext FMTD_PathFindingContext::Create(const APawn *Pawn)
     check(Pawn);
     
     FMTD_PathFindingContext Context;
+
+    // Pawns nobody possesses query with their own agent properties and the default filter
     auto AiController = Pawn->GetController<AAIController>();
-    if (!(::IsValid(AiController)))
+    if ((!(::IsValid(AiController))) && (::IsValid(Pawn->GetController())))
     {
         return Context;
     }
@@ -101,15 +105,17 @@ FMTD_PathFindingContext FMTD_PathFindingContext::Create(const APawn *Pawn)
     }
     
     const FVector StartPosition = Pawn->GetNavAgentLocation();
-    const FNavAgentProperties &NavAgentProps = AiController->GetNavAgentPropertiesRef();
+    const FNavAgentProperties &NavAgentProps = (::IsValid(AiController)) ?
+        (AiController->GetNavAgentPropertiesRef()) : (Pawn->GetNavAgentPropertiesRef());
     ANavigationData *NavigationData = NavigationSystem->GetNavDataForProps(NavAgentProps, StartPosition);
     if (!(::IsValid(NavigationData)))
     {
         return Context;
     }
 
-    const TSubclassOf<UNavigationQueryFilter> NavQueryFilter = AiController->GetDefaultNavigationFilterClass();
-    if (!(::IsValid(NavQueryFilter)))
+    const TSubclassOf<UNavigationQueryFilter> NavQueryFilter =
+        (::IsValid(AiController)) ? (AiController->GetDefaultNavigationFilterClass()) : (nullptr);
+    if ((::IsValid(AiController)) && (!(::IsValid(NavQueryFilter))))
     {
         return Context;
     }
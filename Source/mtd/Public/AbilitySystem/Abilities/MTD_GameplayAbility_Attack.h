@@ -5,11 +5,11 @@
 
 #include "MTD_GameplayAbility_Attack.generated.h"
 
-struct FMTD_AbilityAnimations;
 class UMTD_AbilitySystemComponent;
+class UMTD_ComboComponent;
 
 /*
- * Note: C++ implementation is only about triggering new/continuing previous GE attacks for combos, animation and end
+ * Note: C++ implementation is only about starting new/continuing previous combos, animation and end
  * ability condition. Damage related code has to be handled inside BPs instead. To know if someone was hit, fire events
  * from collision handling code, and listen for them.
  */
@@ -43,17 +43,23 @@ protected:
         bool bReplicateEndAbility,
         bool bWasCancelled) override;
 
+    /** Damage multiplier the current attack should deal damage with according to the combo it's a part of. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="MTD|Combo")
+    float GetComboDamageMultiplier() const;
+
 private:
-    void HandleAttackGameplayEffect(UMTD_AbilitySystemComponent *MtdAsc, int32 &OutAttackEffectLevel) const;
-    FActiveGameplayEffectHandle GetFirstActiveAttackGameplayEffect(const UMTD_AbilitySystemComponent *MtdAsc) const;
-    int32 GetAttackMontageIndexToPlay(const TArray<UAnimMontage *> Animations, int32 AttackEffectLevel) const;
-    UAnimMontage *GetAbilityAnimMontage(TArray<UAnimMontage *> Animations, int32 AttackEffectLevel) const;
+    int32 HandleCombo(UMTD_AbilitySystemComponent *MtdAsc, UMTD_ComboComponent *ComboComponent) const;
+    UAnimMontage *GetAttackAnimMontage(int32 ComboIndex) const;
     void CancelPreviousAttack(UMTD_AbilitySystemComponent *MtdAsc) const;
-    void CreateAndApplyAttackGameplayEffectOnSelf(UMTD_AbilitySystemComponent *MtdAsc) const;
     void PlayAttackAnimation(const ACharacter *PlayOn, UAnimMontage *AbilityAnimMontage);
 
 protected:
+    /** Time in seconds the next attack has to be made within to continue the combo. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MTD|Ability",
         meta=(AllowPrivateAccess="true", DisplayName="Attack Gameplay Effect Duration"))
     float AttackGeDuration = 0.f;
+
+    /** If true, animation montages are played one after another through the combo. Random one is played otherwise. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MTD|Ability", meta=(AllowPrivateAccess="true"))
+    bool bPlayMontagesInComboOrder = false;
 };
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "mtd.h"
+#include "AbilitySystem/Effects/MTD_GameplayEffect.h"
+#include "MTD_GameplayEffect_DamageBatch.generated.h"
+
+/**
+ * Gameplay effect that instantly applies all the damage a target has received during a frame at once. Magnitudes are
+ * computed by the damage subsystem, hence there is no execution to run.
+ */
+UCLASS()
+class MTD_API UMTD_GameplayEffect_DamageBatch : public UMTD_GameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UMTD_GameplayEffect_DamageBatch();
+};
+
+/**
+ * Batched damage gameplay effect that also deals balance damage. Kept apart, since a zero balance damage would still
+ * be compared against the balance threshold.
+ */
+UCLASS()
+class MTD_API UMTD_GameplayEffect_BalanceDamageBatch : public UMTD_GameplayEffect_DamageBatch
+{
+    GENERATED_BODY()
+
+public:
+    UMTD_GameplayEffect_BalanceDamageBatch();
+};
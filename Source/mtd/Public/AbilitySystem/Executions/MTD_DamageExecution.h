@@ -20,4 +20,18 @@ public:
     virtual void Execute_Implementation(
         const FGameplayEffectCustomExecutionParameters &ExecParams,
         FGameplayEffectCustomExecutionOutput &ExecOutput) const override;
+
+    /** Damage the execution deals. Shared with the damage subsystem, which resolves hits in batches. */
+    static float ComputeDamageDone(float DamageBase, float DamageAdditive, float DamageMultiplier, float DamageStat);
+
+    /**
+     * Read the source attributes the spec has captured for the execution: base damage to use and damage stat. Returns
+     * false if applying the spec would do anything besides running the execution, e.g. if it has modifiers, other
+     * executions, or scoped modifiers on those attributes.
+     */
+    static bool GetSpecSourceDamage(
+        const FGameplayEffectSpec &Spec,
+        const FGameplayTagContainer *TargetTags,
+        float &OutDamageBase,
+        float &OutDamageStat);
 };
@@ -25,6 +25,9 @@ public:
     UFUNCTION(BlueprintCallable, Category="MTD|Ability System")
     FMTD_AbilityAnimations GetAbilityAnimMontages(FGameplayTag AbilityTag) const;
 
+    /** Same as GetAbilityAnimMontages, but doesn't copy the animations. */
+    const FMTD_AbilityAnimations *FindAbilityAnimMontages(const FGameplayTag &AbilityTag) const;
+
 private:
     UPROPERTY(EditDefaultsOnly, meta=(AllowPrivateAccess="true"))
     TMap<FGameplayTag,FMTD_AbilityAnimations> AbilityAnimations;
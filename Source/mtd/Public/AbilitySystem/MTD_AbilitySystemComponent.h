@@ -6,15 +6,38 @@
 #include "MTD_AbilitySystemComponent.generated.h"
 
 class UMTD_GameplayAbility;
+
+/** Value to initialize an attribute with. */
+struct FMTD_AttributeInitValue
+{
+    FGameplayAttribute Attribute;
+    float Value = 0.f;
+};
+
+/** Change of an attribute made by attribute initialization. */
+struct FMTD_AttributeInitChange
+{
+    FGameplayAttribute Attribute;
+    float OldValue = 0.f;
+    float NewValue = 0.f;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(
+    FAttributesInitializedSignature,
+    TConstArrayView<FMTD_AttributeInitChange> /*Changes*/);
+
 UCLASS()
 class MTD_API UMTD_AbilitySystemComponent : public UAbilitySystemComponent
 {
     GENERATED_BODY()
 
+private:
+    /** Handles are stored inline, since only a few abilities are pressed or bound to an input tag at once. */
+    using FSpecHandleSet = TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>>;
+    using FInputSpecHandles = TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>;
+
 public:
     void ProcessAbilityInput(float DeltaSeconds, bool bGamePaused);
-    bool SetGameplayEffectDurationHandle(FActiveGameplayEffectHandle Handle, float NewDuration);
-    bool IncreaseGameplayEffectLevelHandle(FActiveGameplayEffectHandle Handle, float IncreaseBy) const;
 
     void OnAbilityInputTagPressed(const FGameplayTag &InputTag);
     void OnAbilityInputTagReleased(const FGameplayTag &InputTag);
@@ -22,13 +45,77 @@ public:
     UFUNCTION(BlueprintCallable, Category="MTD|Ability System Component")
     void GiveTagToAbility(const FGameplayTag &Tag, UMTD_GameplayAbility *Ability);
 
+    /** Same as FindAbilitySpecFromHandle, but looks the spec up in the index instead of going through all of them. */
+    FGameplayAbilitySpec *FindIndexedAbilitySpec(const FGameplayAbilitySpecHandle &Handle);
+
+    /**
+     * Override base and current values of the attributes, in order. Attribute sets still clamp the values, but no
+     * per-attribute change delegates are fired, OnAttributesInitializedDelegate is broadcast once afterwards instead.
+     *
+     * Values are written directly only the first time, and if there are no active gameplay effects, since aggregators
+     * may exist otherwise. Otherwise, ApplyModToAttribute is used, which fires the regular change delegates.
+     */
+    void InitializeAttributeValues(TConstArrayView<FMTD_AttributeInitValue> Values);
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Route presses and releases of every input tag for a number of frames, and log the per-frame cost. Expected to be
+     * run on a scratch ability system with throwaway abilities, since pressed inputs are reset.
+     */
+    void RunAbilityInputBenchmark(int32 Frames);
+
+    /**
+     * Initialize health, mana and balance attributes of fresh scratch ability systems, half of them batched and half
+     * per attribute, and log the timings along with the amount of change delegate broadcasts.
+     */
+    static void RunAttributeInitBenchmark(UWorld *World, int32 Spawns);
+#endif
+
+public:
+    /** Broadcast once attributes have been initialized with InitializeAttributeValues. */
+    FAttributesInitializedSignature OnAttributesInitializedDelegate;
+
+protected:
+    //~UAbilitySystemComponent Interface
+    /** Damage specs abilities apply are queued into the damage subsystem on the server, if they can be batched. */
+    virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToTarget(
+        const FGameplayEffectSpec &GameplayEffect,
+        UAbilitySystemComponent *Target,
+        FPredictionKey PredictionKey = FPredictionKey()) override;
+
+    virtual void OnGiveAbility(FGameplayAbilitySpec &AbilitySpec) override;
+    virtual void OnRemoveAbility(FGameplayAbilitySpec &AbilitySpec) override;
+    virtual void OnRep_ActivateAbilities() override;
+    //~End of UAbilitySystemComponent Interface
+
 private:
-    UPROPERTY()
-    TArray<FGameplayAbilitySpecHandle> InputPressedSpecHandles;
+    /** Rebuild the input tag and spec indices if abilities have changed since they have been built. */
+    void UpdateAbilityIndex();
+
+    /** Find the specs bound to the input tag. */
+    const FInputSpecHandles *FindInputTagSpecHandles(const FGameplayTag &InputTag);
+
+    /** Write the values into attribute sets bypassing aggregators and change delegates. */
+    void WriteAttributeValues(TConstArrayView<FMTD_AttributeInitValue> Values);
+
+    UAttributeSet *FindAttributeSet(const FGameplayAttribute &Attribute) const;
+
+private:
+    FSpecHandleSet InputPressedSpecHandles;
+    FSpecHandleSet InputHeldSpecHandles;
+    FSpecHandleSet InputReleasedSpecHandles;
+
+    /** Specs each input tag activates. */
+    TMap<FGameplayTag, FInputSpecHandles> InputTagSpecHandles;
+
+    /** Index of each spec in the activatable abilities. */
+    TMap<FGameplayAbilitySpecHandle, int32> AbilitySpecIndices;
+
+    bool bAbilityIndexDirty = true;
 
-    UPROPERTY()
-    TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
+    /** Whether attributes have been initialized with InitializeAttributeValues. */
+    bool bAttributesInitialized = false;
 
-    UPROPERTY()
-    TArray<FGameplayAbilitySpecHandle> InputReleasedSpecHandles;
+    /** Changes made by the last attribute initialization. Kept around to not allocate them on each spawn. */
+    TArray<FMTD_AttributeInitChange> AttributeInitChanges;
 };
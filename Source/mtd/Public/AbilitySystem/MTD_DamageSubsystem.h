@@ -0,0 +1,149 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "GameplayEffectTypes.h"
+#include "mtd.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "MTD_DamageSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+struct FGameplayEffectSpec;
+
+/** A single hit waiting to be resolved by the damage subsystem. */
+USTRUCT(BlueprintType)
+struct FMTD_DamageHit
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadWrite)
+    TObjectPtr<UAbilitySystemComponent> Source = nullptr;
+
+    UPROPERTY(BlueprintReadWrite)
+    TObjectPtr<UAbilitySystemComponent> Target = nullptr;
+
+    /** Base damage to use. Ignored if the source damage is captured. */
+    UPROPERTY(BlueprintReadWrite)
+    float DamageBase = 0.f;
+
+    UPROPERTY(BlueprintReadWrite)
+    float DamageAdditive = 0.f;
+
+    UPROPERTY(BlueprintReadWrite)
+    float DamageMultiplier = 1.f;
+
+    /** Source damage stat. Ignored if the source damage is captured. */
+    UPROPERTY(BlueprintReadWrite)
+    float DamageStat = 0.f;
+
+    /**
+     * Whether the base damage to use and damage stat are read from the source when the hit is queued, the same way the
+     * damage execution captures them when the spec is made.
+     */
+    UPROPERTY(BlueprintReadWrite)
+    bool bCaptureSourceDamage = false;
+
+    /** Whether the source balance damage should be dealt as well. */
+    UPROPERTY(BlueprintReadWrite)
+    bool bBalanceDamage = false;
+
+    /** Balance damage to deal if the hit has no source to read it from, e.g. if it's dealt by a lite enemy. */
+    UPROPERTY(BlueprintReadWrite)
+    float BalanceDamage = 0.f;
+
+    /** Direction to knock the target back in if the balance damage surpasses its threshold. */
+    UPROPERTY(BlueprintReadWrite)
+    FVector KnockbackDirection = FVector::ZeroVector;
+
+    /** Tags to add to the gameplay effect the target receives. */
+    UPROPERTY(BlueprintReadWrite)
+    FGameplayTagContainer Tags;
+
+    /** Context of the hit. If invalid, a new one is made from the source. */
+    UPROPERTY(BlueprintReadWrite)
+    FGameplayEffectContextHandle EffectContext;
+};
+
+/**
+ * World subsystem that gathers damage dealt during a frame, and resolves it once per target: each target receives a
+ * single gameplay effect with the sum of its damage, hence its health changes only once per frame.
+ *
+ * Hit damage is computed with the same formula UMTD_DamageExecution uses, from the source attributes either the spec or
+ * the hit has captured.
+ */
+UCLASS()
+class MTD_API UMTD_DamageSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UMTD_DamageSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaSeconds) override;
+    virtual TStatId GetStatId() const override;
+    //~End of FTickableGameObject Interface
+
+    /** Add the hit to the current batch. It's going to be applied at the end of the frame. */
+    UFUNCTION(BlueprintCallable, Category="MTD|Damage")
+    void QueueDamage(const FMTD_DamageHit &Hit);
+
+    /**
+     * Add the hit the spec would deal through the damage execution to the current batch, and execute its gameplay cues.
+     * Returns false if the spec can't be batched, in which case it's expected to be applied as usual.
+     */
+    bool QueueDamageSpec(const FGameplayEffectSpec &Spec, UAbilitySystemComponent *Target);
+
+    /** Same as QueueDamageSpec, for the abilities that apply their damage in blueprints. */
+    UFUNCTION(BlueprintCallable, Category="MTD|Damage", meta=(DisplayName="Queue Damage Spec"))
+    bool K2_QueueDamageSpec(const FGameplayEffectSpecHandle &SpecHandle, UAbilitySystemComponent *Target);
+
+    /** Apply all the queued hits right away. */
+    UFUNCTION(BlueprintCallable, Category="MTD|Damage")
+    void FlushDamage();
+
+    /** Health damage a single hit deals. Matches what the damage execution computes for the same attributes. */
+    static float ComputeHitDamage(const FMTD_DamageHit &Hit);
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Deal the same damage gameplay effect specs from the first player to all the other pawns with an ability system,
+     * first by applying them one by one, then through the batch. Log the timings of both, along with how many targets
+     * have lost a different amount of health each time.
+     */
+    void RunDamageBenchmark(int32 HitCount, float Damage);
+#endif
+
+private:
+    /** Damage a single target has received during a frame. */
+    struct FTargetBatch
+    {
+        UAbilitySystemComponent *Target = nullptr;
+        float Damage = 0.f;
+        float BalanceDamage = 0.f;
+        FVector KnockbackDirection = FVector::ZeroVector;
+        float Resist = 0.f;
+        bool bBalanceDamage = false;
+        int32 LastHitIndex = INDEX_NONE;
+        FGameplayTagContainer Tags;
+    };
+
+    void ApplyBatch(const FTargetBatch &Batch, const FMTD_DamageHit &LastHit) const;
+
+private:
+    UPROPERTY()
+    TArray<FMTD_DamageHit> PendingHits;
+
+    /** Hits being resolved. Kept around to not allocate them every frame. */
+    UPROPERTY()
+    TArray<FMTD_DamageHit> ResolvingHits;
+
+    TArray<FTargetBatch> TargetBatches;
+    TMap<UAbilitySystemComponent*, int32> TargetBatchIndices;
+};
@@ -7,10 +7,16 @@ class UGameplayTagsManager;
 
 /**
  *	Singleton containing native gameplay tags.
+ *
+ *	Tags are resolved once on startup, hence reading them is as cheap as reading a member. It can't be copied, use a
+ *	reference returned by Get() instead.
  */
 struct FMTD_GameplayTags
 {
 public:
+    FMTD_GameplayTags(const FMTD_GameplayTags &) = delete;
+    FMTD_GameplayTags &operator=(const FMTD_GameplayTags &) = delete;
+
     static const FMTD_GameplayTags &Get()
     {
         return GameplayTags;
@@ -51,6 +57,15 @@ public:
     FGameplayTag SetByCaller_Damage_Base;
     FGameplayTag SetByCaller_Damage_Additive;
     FGameplayTag SetByCaller_Damage_Multiplier;
+    FGameplayTag SetByCaller_Damage_Batched;
+    FGameplayTag SetByCaller_Health_Batched;
+    FGameplayTag SetByCaller_BalanceDamage_Batched;
+    FGameplayTag SetByCaller_Balance_Damage;
+    FGameplayTag SetByCaller_KnockbackDirectionX;
+    FGameplayTag SetByCaller_KnockbackDirectionY;
+    FGameplayTag SetByCaller_KnockbackDirectionZ;
+
+    FGameplayTag GameplayCue_DamageInstant;
 
     FGameplayTag Status_Death;
     FGameplayTag Status_Death_Dying;
@@ -74,6 +89,9 @@ protected:
     void AddMovementModeTag(FGameplayTag &OutTag, const ANSICHAR *TagName, uint8 MovementMode);
     void AddCustomMovementModeTag(FGameplayTag &OutTag, const ANSICHAR *TagName, uint8 CustomMovementMode);
 
+private:
+    FMTD_GameplayTags() = default;
+
 private:
     static FMTD_GameplayTags GameplayTags;
 };
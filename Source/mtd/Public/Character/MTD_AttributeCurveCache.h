@@ -0,0 +1,77 @@
+#pragma once
+
+#include "mtd.h"
+
+class UCurveTable;
+
+/**
+ * Attribute curve table evaluated at every whole level in its key range, so that attributes are initialized with an
+ * array lookup instead of a curve evaluation by row name.
+ *
+ * Fractional levels, as well as levels outside the baked range, fall back to evaluating the curve table.
+ */
+struct MTD_API FMTD_AttributeCurveCache
+{
+public:
+    /** Maximum amount of levels baked per attribute. */
+    static constexpr int32 MaxBakedLevels = 256;
+
+    FMTD_AttributeCurveCache() = default;
+    FMTD_AttributeCurveCache(const FMTD_AttributeCurveCache &) = delete;
+    FMTD_AttributeCurveCache &operator=(const FMTD_AttributeCurveCache &) = delete;
+    ~FMTD_AttributeCurveCache();
+
+    /** Evaluate all the curves of the table. Any previously baked data is discarded. */
+    void Bake(UCurveTable *CurveTable);
+    void Reset();
+
+    /** Whether the cache has been baked from the given table, and it's up to date. */
+    bool IsBakedFrom(const UCurveTable *CurveTable) const;
+
+    /** Bake the table if the cache hasn't been baked from it yet. */
+    void BakeIfStale(UCurveTable *CurveTable);
+
+    /** Index of an attribute to get values of, or INDEX_NONE if the table has no such row. */
+    int32 FindAttributeIndex(FName AttributeName) const;
+
+    /**
+     * Get value of an attribute at a level.
+     * @return  If false, the table has no such attribute.
+     */
+    bool Evaluate(FName AttributeName, float Level, float &OutValue) const;
+    bool Evaluate(int32 AttributeIndex, float Level, float &OutValue) const;
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Compare values of every attribute at every baked level against curve table evaluations.
+     * @return  Amount of values that differ.
+     */
+    int32 Validate() const;
+#endif
+
+private:
+    struct FBakedAttribute
+    {
+        FName Name;
+
+        /** Index of the first value of the attribute in the values array. */
+        int32 FirstValue = 0;
+
+        /** Amount of baked levels, starting with level 0. */
+        int32 Levels = 0;
+    };
+
+    TWeakObjectPtr<UCurveTable> SourceTable;
+
+#if WITH_EDITOR
+    /** Curve tables may be edited while the game is running in editor, the cache is stale afterwards. */
+    TSharedPtr<bool> bSourceTableChanged;
+    FDelegateHandle SourceTableChangedHandle;
+#endif
+
+    /** Attributes in the order of the table rows. There are few of them, hence there is no need for a map. */
+    TArray<FBakedAttribute> Attributes;
+
+    /** Values of all the attributes laid out one after another. */
+    TArray<float> Values;
+};
@@ -6,10 +6,29 @@
 #include "MTD_BalanceComponent.generated.h"
 
 struct FGameplayEffectSpec;
+struct FMTD_LiteCombatStats;
 struct FOnAttributeChangeData;
 class UMTD_AbilitySystemComponent;
 class UMTD_BalanceSet;
 
+/** Balance hit that has knocked an actor back. Passed by value, hence knockbacks create no garbage. */
+USTRUCT(BlueprintType)
+struct FMTD_BalanceHit
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(BlueprintReadOnly)
+    float BalanceDamage = 0.f;
+    
+    UPROPERTY(BlueprintReadOnly)
+    FVector KnockbackDirection = FVector::ZeroVector;
+};
+
+/**
+ * Balance hit passed to knockback abilities as the second optional object of the knockback gameplay event. Each
+ * balance component keeps a single one and refills it on every knockback.
+ */
 UCLASS(BlueprintType)
 class UMTD_BalanceHitData : public UObject
 {
@@ -29,7 +48,7 @@ class MTD_API UMTD_BalanceComponent : public UActorComponent
     GENERATED_BODY()
 
 public:
-    DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBalanceDownSignature, const UMTD_BalanceHitData*, HitData);
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBalanceDownSignature, const FMTD_BalanceHit&, HitData);
 
 public:
     UMTD_BalanceComponent();
@@ -43,6 +62,19 @@ public:
     UFUNCTION(BlueprintCallable, Category="MTD|Balance")
     void UninitializeFromAbilitySystem();
 
+    /**
+     * Use the stats instead of an ability system. The stats must outlive the component, e.g. be owned by its owner.
+     * @see FMTD_LiteCombat
+     */
+    void InitializeWithLiteStats(const FMTD_LiteCombatStats *InLiteStats);
+
+    /** Resist the balance damage with lite stats, and knockback if it surpasses the threshold. */
+    void ApplyLiteBalanceDamage(float BalanceDamage, const FVector &KnockbackDirection);
+
+    /** Hit that has knocked the owner back the last time. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="MTD|Balance")
+    const FMTD_BalanceHit &GetLastBalanceHit() const;
+
 protected:
     virtual void OnUnregister() override;
 
@@ -63,9 +95,24 @@ private:
 
     UPROPERTY()
     TObjectPtr<const UMTD_BalanceSet> BalanceSet = nullptr;
+
+    /** Stats of the owner if it has no ability system. */
+    const FMTD_LiteCombatStats *LiteStats = nullptr;
+
+    UPROPERTY()
+    FMTD_BalanceHit LastBalanceHit;
+
+    /** Payload of the knockback gameplay event, reused by every knockback. */
+    UPROPERTY()
+    TObjectPtr<UMTD_BalanceHitData> BalanceHitPayload = nullptr;
 };
 
 inline UMTD_BalanceComponent *UMTD_BalanceComponent::FindBalanceComponent(const AActor *Actor)
 {
     return (IsValid(Actor)) ? (Actor->FindComponentByClass<UMTD_BalanceComponent>()) : (nullptr);
 }
+
+inline const FMTD_BalanceHit &UMTD_BalanceComponent::GetLastBalanceHit() const
+{
+    return LastBalanceHit;
+}
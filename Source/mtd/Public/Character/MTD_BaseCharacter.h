@@ -13,10 +13,12 @@
 class AMTD_PlayerState;
 class UMTD_AbilitySystemComponent;
 class UMTD_BalanceComponent;
+class UMTD_ComboComponent;
 class UMTD_EquipmentManagerComponent;
 class UMTD_HealthComponent;
 class UMTD_HeroComponent;
 class UMTD_ManaComponent;
+class UMTD_MeleeTraceSubsystem;
 class UMTD_PawnExtensionComponent;
 
 UCLASS()
@@ -28,6 +30,8 @@ class MTD_API AMTD_BaseCharacter :
 {
     GENERATED_BODY()
 
+    friend UMTD_MeleeTraceSubsystem;
+
 public:
     AMTD_BaseCharacter();
 
@@ -48,6 +52,8 @@ public:
     //~IMTD_MeleeCharacterInterface
     virtual void AddMeleeHitboxes(const TArray<FName> &HitboxNicknames) override;
     virtual void RemoveMeleeHitboxes(const TArray<FName> &HitboxNicknames) override;
+    virtual void AddMeleeHitboxesById(TConstArrayView<uint16> HitboxIds) override;
+    virtual void RemoveMeleeHitboxesById(TConstArrayView<uint16> HitboxIds) override;
 
     virtual void DisableMeleeHitboxes() override;
     virtual void ResetMeleeHitTargets() override;
@@ -56,6 +62,11 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category="MTD|Character")
     float GetMovementDirectionAngle() const;
 
+#if !UE_BUILD_SHIPPING
+    /** Activate and deactivate all the hitboxes by nicknames and by IDs, and log the timings. */
+    void RunHitboxNotifyBenchmark(int32 Iterations);
+#endif
+
 protected:
     virtual void OnAbilitySystemInitialized();
     virtual void OnAbilitySystemUninitialized();
@@ -74,10 +85,20 @@ protected:
     virtual void SetupPlayerInputComponent(UInputComponent *PlayerInputComponent) override;
     //~End of ACharacter interface
 
-    void ConstructHitboxMap();
-    void PerformHitboxTrace();
+    void BakeHitboxes();
+    uint64 GetHitboxMask(TConstArrayView<uint16> HitboxIds) const;
+    void SetMeleeInProgress(bool bInProgress);
     void PerformHit(const FHitResult &Hit);
 
+    /** Resolve the hit natively, if either this character or the hit actor has no ability system. */
+    void PerformLiteHit(const FHitResult &Hit);
+
+    /**
+     * Damage and balance damage a hit resolved natively deals. Computed from the same source attributes the damage and
+     * balance damage executions capture.
+     */
+    virtual void GetLiteHitDamage(float &OutDamage, float &OutBalanceDamage) const;
+
     virtual void InitializeAttributes();
 
     virtual void FellOutOfWorld(const UDamageType &DamageType) override;
@@ -86,6 +107,7 @@ public:
     UMTD_HealthComponent *GetHealthComponent() const;
     UMTD_ManaComponent *GetManaComponent() const;
     UMTD_BalanceComponent *GetBalanceComponent() const;
+    UMTD_ComboComponent *GetComboComponent() const;
     UMTD_EquipmentManagerComponent *GetEquipmentManagerComponent() const;
 
     UFUNCTION(BlueprintCallable, Category="MTD|Character")
@@ -117,6 +139,9 @@ private:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="MTD|Components", meta=(AllowPrivateAccess="true"))
     TObjectPtr<UMTD_BalanceComponent> BalanceComponent = nullptr;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="MTD|Components", meta=(AllowPrivateAccess="true"))
+    TObjectPtr<UMTD_ComboComponent> ComboComponent = nullptr;
+
     /** Data Asset defining all hitbox data. */
     UPROPERTY(EditAnywhere, Category="MTD|Combat System")
     TArray<TObjectPtr<UMTD_MeleeHitboxData>> HitboxData;
@@ -135,13 +160,22 @@ private:
 
     /** Targets that has been hit with active attack, and that will be ignored until the attack ends. */
     UPROPERTY()
-    TArray<TObjectPtr<AActor>> MeleeHitTargets;
+    TSet<TObjectPtr<AActor>> MeleeHitTargets;
 
-    /** Dispatched Hitbox Data. */
-    TMap<FName, FMTD_ActiveHitboxEntry> HitboxMap;
+    /** Object types to hit in a form collision queries take them. */
+    FCollisionObjectQueryParams MeleeObjectQueryParams;
 
-    /** Array of active hitbox definitions that are used to perform trace on tick. */
-    TArray<FMTD_MeleeHitSphereDefinition> ActiveHitboxes;
+    /** Maximum amount of hitboxes a character may have, one per bit of the active hitbox mask. */
+    static constexpr int32 MaxHitboxes = 64;
+
+    /** Hitbox Data baked on begin play. Index of a hitbox is its slot. */
+    TArray<FMTD_ActiveHitboxEntry> Hitboxes;
+
+    /** Hitbox slot of each hitbox ID, INDEX_NONE if the character has no hitbox with the ID. */
+    TArray<int8> HitboxSlots;
+
+    /** Bit per hitbox slot, set if the hitbox is active and is swept by melee trace subsystem each frame. */
+    uint64 ActiveHitboxMask = 0;
 
     /** Should try to perform any combat system trace? */
     bool bIsMeleeInProgress = false;
@@ -162,6 +196,11 @@ inline UMTD_BalanceComponent *AMTD_BaseCharacter::GetBalanceComponent() const
     return BalanceComponent;
 }
 
+inline UMTD_ComboComponent *AMTD_BaseCharacter::GetComboComponent() const
+{
+    return ComboComponent;
+}
+
 inline UMTD_EquipmentManagerComponent *AMTD_BaseCharacter::GetEquipmentManagerComponent() const
 {
     return EquipmentManagerComponent;
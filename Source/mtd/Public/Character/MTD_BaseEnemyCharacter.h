@@ -1,21 +1,28 @@
 #pragma once
 
+#include "Character/MTD_BalanceComponent.h"
+#include "CombatSystem/MTD_LiteCombat.h"
+#include "GenericTeamAgentInterface.h"
 #include "mtd.h"
 #include "MTD_BaseCharacter.h"
 
 #include "MTD_BaseEnemyCharacter.generated.h"
 
+class UAnimMontage;
 class UBehaviorTree;
 class UBoxComponent;
+class UMTD_EnemyCrowdSubsystem;
 class UMTD_EnemyData;
 class UMTD_EnemyExtensionComponent;
 class USphereComponent;
 
 UCLASS()
-class MTD_API AMTD_BaseEnemyCharacter : public AMTD_BaseCharacter
+class MTD_API AMTD_BaseEnemyCharacter : public AMTD_BaseCharacter, public IGenericTeamAgentInterface
 {
     GENERATED_BODY()
 
+    friend UMTD_EnemyCrowdSubsystem;
+
 public:
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNewTargetSignature, AActor*, OldTarget, AActor*, NewTarget);
     DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDynamicMulticastSignature);
@@ -25,15 +32,55 @@ public:
 
     UBehaviorTree *GetBehaviorTree() const;
 
+    /**
+     * Whether the enemy is driven by the native state machine instead of its behavior tree. Lite combat enemies always
+     * are, since the behavior tree attacks by activating abilities.
+     */
+    bool UsesNativeAi() const;
+
+    /** Whether the enemy resolves hits natively and has no ability system. */
+    bool IsLiteCombat() const;
+
+    /** Whether the enemy is spawned without an AI controller and moved by the enemy crowd subsystem instead. */
+    bool IsControllerless() const;
+
+    /**
+     * Use lite combat regardless of the enemy data, with or without a controller. Must be called before the enemy
+     * begins play, e.g. on a deferred spawn, so that the same enemy type can be compared either way.
+     */
+    void OverrideLiteCombat(bool bInControllerless);
+
+    //~IGenericTeamAgentInterface Interface
+    virtual FGenericTeamId GetGenericTeamId() const override;
+    //~End of IGenericTeamAgentInterface Interface
+
+    /**
+     * Play a random lite attack montage, or a melee attack one from the animation set if there are none. Lite enemies
+     * have no ability system to activate attack abilities with.
+     * @return True if a montage has started playing.
+     */
+    UFUNCTION(BlueprintCallable, Category="MTD|Enemy")
+    bool PlayLiteAttack();
+
+    /**
+     * Attack the way the native state machine does: play a lite attack montage for lite enemies, or activate the melee
+     * attack ability otherwise.
+     * @return True if an attack has started.
+     */
+    UFUNCTION(BlueprintCallable, Category="MTD|Enemy")
+    bool PerformNativeAttack();
+
 protected:
     //~AActor Interface
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     //~End of AActor Interface
 
     //~AMTD_BaseCharacter Interface
     virtual void InitializeAttributes() override;
     virtual void OnDeathStarted_Implementation(AActor *OwningActor) override;
     virtual void OnDeathFinished_Implementation(AActor *OwningActor) override;
+    virtual void GetLiteHitDamage(float &OutDamage, float &OutBalanceDamage) const override;
     //~End of AMTD_BaseCharacter Interface
 
     UFUNCTION(BlueprintNativeEvent)
@@ -48,6 +95,15 @@ protected:
     
 private:
     void EquipDefaultWeapon();
+    void SetupControllerless();
+
+    UFUNCTION()
+    void OnControllerlessKnockback(const FMTD_BalanceHit &HitData);
+
+    /** Play the death montage the death ability would, and finish the death once it's over. */
+    void StartLiteDeath();
+    void OnLiteDeathMontageBlendingOut(UAnimMontage *AnimMontage, bool bInterrupted);
+    void FinishLiteDeath();
 
     void SetNewTarget(APawn *Pawn);
     APawn *GetClosestTarget();
@@ -127,6 +183,21 @@ private:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="MTD|Enemy", meta=(AllowPrivateAccess="true"))
     TSubclassOf<UMTD_EquipmentDefinition> DefaultWeaponDefinitionClass = nullptr;
 
+    /** Montages to attack with if the enemy uses lite combat. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="MTD|Enemy|Lite Combat",
+        meta=(AllowPrivateAccess="true"))
+    TArray<TObjectPtr<UAnimMontage>> LiteAttackMontages;
+
+    /** Stats used instead of attribute sets if the enemy uses lite combat. */
+    FMTD_LiteCombatStats LiteCombatStats;
+
+    /** Whether lite combat is used regardless of the enemy data, and whether the enemy is controller-less then. */
+    bool bLiteCombatOverride = false;
+    bool bControllerlessOverride = false;
+
+    /** Index in the crowd subsystem's enemies if the enemy is controller-less, maintained by the subsystem. */
+    int32 CrowdIndex = INDEX_NONE;
+
     UPROPERTY()
     TObjectPtr<APawn> Target = nullptr;
 
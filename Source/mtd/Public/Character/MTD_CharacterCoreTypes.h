@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Character/MTD_AttributeCurveCache.h"
 #include "mtd.h"
 #include "Projectile/MTD_ProjectileCoreTypes.h"
 
@@ -28,6 +29,18 @@ class UMTD_ProjectileData;
         } \
     } while(0)
 
+/** Same as EVALUTE_ATTRIBUTE, but reads the value from an attribute curve cache. */
+#define EVALUATE_CACHED_ATTRIBUTE(ATTRIBUTE_CACHE, ROW_NAME, IN_XY, OUT_XY) \
+    do \
+    { \
+        if (!(ATTRIBUTE_CACHE).Evaluate(ROW_NAME, IN_XY, OUT_XY)) \
+        { \
+            MTDS_WARN("Attribute [%s] on Owner's [%s] Attribute Table could not be found.", \
+                *ROW_NAME.ToString(), *GetName()); \
+            return; \
+        } \
+    } while(0)
+
 /** Attribute names used to retrieve data from curve tables. */
 const FName HealthAttributeName = FName("Health");
 const FName ManaAttributeName = FName("Mana");
@@ -50,6 +63,14 @@ class MTD_API UMTD_PlayerData : public UDataAsset
 {
     GENERATED_BODY()
 
+public:
+    //~UObject Interface
+    virtual void PostLoad() override;
+    //~End of UObject Interface
+
+    /** Attribute Table baked on load. */
+    const FMTD_AttributeCurveCache &GetAttributeCache() const;
+
 public:
     /** Values to initialize the player attributes with. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -61,6 +82,9 @@ public:
     
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
     TArray<TObjectPtr<const UInputMappingContext>> InputContexts;
+
+private:
+    mutable FMTD_AttributeCurveCache AttributeCache;
 };
 
 UCLASS(BlueprintType, Const, meta=(ShortTooltip="Data asset used to define a Tower."))
@@ -68,6 +92,14 @@ class MTD_API UMTD_TowerData : public UDataAsset
 {
     GENERATED_BODY()
 
+public:
+    //~UObject Interface
+    virtual void PostLoad() override;
+    //~End of UObject Interface
+
+    /** Attribute Table baked on load. */
+    const FMTD_AttributeCurveCache &GetAttributeCache() const;
+
 public:
     /** Values to initialize the tower attributes with. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -75,6 +107,9 @@ public:
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
     TObjectPtr<const UMTD_ProjectileData> ProjectileData = nullptr;
+
+private:
+    mutable FMTD_AttributeCurveCache AttributeCache;
 };
 
 UCLASS(BlueprintType, Const, meta=(ShortTooltip="Data asset used to define a Pawn."))
@@ -93,6 +128,14 @@ class MTD_API UMTD_EnemyData : public UDataAsset
 {
     GENERATED_BODY()
     
+public:
+    //~UObject Interface
+    virtual void PostLoad() override;
+    //~End of UObject Interface
+
+    /** Temporary Attribute Table baked on load. */
+    const FMTD_AttributeCurveCache &GetAttributeCache() const;
+
 public:
     /** Amount of base health an enemy will be granted. The value will be scaled depending on level. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -125,8 +168,41 @@ public:
     /** Seconds an enemy will be knockback for if lost balance. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
     float KnockbackTime = 0.f;
+
+    /**
+     * Drive the enemy by the native state machine, which moves it to the game target, chases and attacks its targets,
+     * instead of running the behavior tree. Meant for common wave enemies; bosses should keep their trees. Lite combat
+     * enemies are always driven natively.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    bool bUseNativeAi = false;
+
+    /**
+     * Resolve hits natively against a compact stat block instead of granting an ability system, attribute sets and
+     * equipment abilities. Meant for horde enemies; elite and boss enemies should keep it off to use their abilities.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    bool bLiteCombat = false;
+
+    /**
+     * Seconds a lite combat enemy waits for after its death montage before the death finishes, the same way the death
+     * ability does.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(EditCondition="bLiteCombat", ClampMin="0.0"))
+    float LiteDeathDelay = 1.f;
+
+    /**
+     * Spawn the enemy without an AI controller. Team and targeting come from the enemy itself, and the movement is
+     * driven by the enemy crowd subsystem. Only applies to lite combat enemies, since the others keep their ability
+     * system on the player state the controller creates.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(EditCondition="bLiteCombat"))
+    bool bControllerless = false;
     
     /** TEMPORARY. Values to scale enemy attributes with. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
     TObjectPtr<UCurveTable> TemporaryAttributeTable = nullptr;
+
+private:
+    mutable FMTD_AttributeCurveCache AttributeCache;
 };
@@ -25,6 +25,24 @@ public:
     void StartSpawning();
     void StopSpawning();
 
+    /**
+     * Spawn a character of the spawner's class at the transform right away, the same way the waves do.
+     * @param   PreFinishSpawning   Called on the character before it begins play, e.g. to override its settings.
+     */
+    AMTD_BaseCharacter *SpawnCharacter(const FTransform &Transform,
+        const TFunction<void(AMTD_BaseCharacter*)> &PreFinishSpawning = nullptr) const;
+
+    /**
+     * Spawn a wave of characters right away, spread evenly over a disc around the spawner. Characters are spawned at
+     * the same spots every time, so that waves of the same size can be compared.
+     */
+    TArray<AMTD_BaseCharacter*> SpawnWave(int32 Count,
+        const TFunction<void(AMTD_BaseCharacter*)> &PreFinishSpawning = nullptr) const;
+
+    /** Same as the above, but over a disc of the radius around the center. */
+    TArray<AMTD_BaseCharacter*> SpawnWave(const FVector &Center, float Radius, int32 Count,
+        const TFunction<void(AMTD_BaseCharacter*)> &PreFinishSpawning = nullptr) const;
+
 protected:
     //~AActor Interface
 	virtual void BeginPlay() override;
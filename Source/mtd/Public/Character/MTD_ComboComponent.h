@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "mtd.h"
+
+#include "MTD_ComboComponent.generated.h"
+
+/**
+ * Component that keeps track of attack combos: how many attacks in a row have been made, and until when the next
+ * attack continues the combo. Nothing is ticked, the combo expires on its own when it's queried.
+ */
+UCLASS(Blueprintable, ClassGroup="Pawn", meta=(BlueprintSpawnableComponent))
+class MTD_API UMTD_ComboComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMTD_ComboComponent();
+
+    UFUNCTION(BlueprintCallable, Category="MTD|Combo")
+    static UMTD_ComboComponent *FindComboComponent(const AActor *Actor);
+
+    /**
+     * Register an attack. Continues the combo if it hasn't expired yet, starts a new one otherwise.
+     * @param   ComboWindow Seconds the next attack has to be made within to continue the combo.
+     * @return  Combo index of the attack. 0 for an attack that starts a combo.
+     */
+    UFUNCTION(BlueprintCallable, Category="MTD|Combo")
+    int32 AdvanceCombo(float ComboWindow);
+
+    UFUNCTION(BlueprintCallable, Category="MTD|Combo")
+    void ResetCombo();
+
+    UFUNCTION(BlueprintPure, Category="MTD|Combo")
+    bool IsComboActive() const;
+
+    /** Combo index of the last attack, or -1 if there is no active combo. */
+    UFUNCTION(BlueprintPure, Category="MTD|Combo")
+    int32 GetComboIndex() const;
+
+    /** Damage multiplier the last attack of the combo should deal damage with. */
+    UFUNCTION(BlueprintPure, Category="MTD|Combo")
+    float GetComboDamageMultiplier() const;
+
+private:
+    /** Damage multiplier added for each attack of the combo after the first one. */
+    UPROPERTY(EditDefaultsOnly, Category="MTD|Combo", meta=(AllowPrivateAccess="true"))
+    float DamageMultiplierPerComboStep = 0.f;
+
+    /**
+     * Amount of attacks in the current combo, 0 if there is none. Combo index is 0 for the first attack, and the level
+     * for the next ones, hence the sequence is 0, 2, 3, ...
+     */
+    int32 ComboLevel = 0;
+
+    /** World time the current combo expires at. */
+    double ComboExpireTime = 0.0;
+};
+
+inline UMTD_ComboComponent *UMTD_ComboComponent::FindComboComponent(const AActor *Actor)
+{
+    return (IsValid(Actor)) ? (Actor->FindComponentByClass<UMTD_ComboComponent>()) : (nullptr);
+}
@@ -9,6 +9,8 @@ class UMTD_AbilitySystemComponent;
 class UMTD_HealthSet;
 class UMTD_HealthComponent;
 struct FGameplayEffectSpec;
+struct FMTD_AttributeInitChange;
+struct FMTD_LiteCombatStats;
 struct FOnAttributeChangeData;
 
 UENUM(BlueprintType)
@@ -46,6 +48,21 @@ public:
     UFUNCTION(BlueprintCallable, Category="MTD|Health")
     void UninitializeFromAbilitySystem();
 
+    /**
+     * Use the stats instead of an ability system. The stats must outlive the component, e.g. be owned by its owner.
+     * @see FMTD_LiteCombat
+     */
+    void InitializeWithLiteStats(FMTD_LiteCombatStats *InLiteStats);
+
+    /** Whether the health comes from lite combat stats rather than from an ability system. */
+    bool IsLite() const;
+
+    /**
+     * Lower the lite health, and start the death if it reaches zero. There is no death ability to finish the death,
+     * hence the owner is expected to finish it once it's done dying.
+     */
+    void ApplyLiteDamage(float Damage, AActor *DamageInstigator);
+
     UFUNCTION(BlueprintCallable, Category="MTD|Health")
     float GetHealth() const;
 
@@ -74,6 +91,7 @@ protected:
 
     virtual void OnHealthChanged(const FOnAttributeChangeData &ChangeData);
     virtual void OnMaxHealthChanged(const FOnAttributeChangeData &ChangeData);
+    virtual void OnAttributesInitialized(TConstArrayView<FMTD_AttributeInitChange> Changes);
     virtual void OnOutOfHealth(
         AActor *DamageInstigator,
         AActor *DamageCauser,
@@ -102,6 +120,9 @@ private:
 
     UPROPERTY()
     EMTD_DeathState DeathState = EMTD_DeathState::NotDead;
+
+    /** Stats of the owner if it has no ability system. */
+    FMTD_LiteCombatStats *LiteStats = nullptr;
 };
 
 inline UMTD_HealthComponent *UMTD_HealthComponent::FindHealthComponent(const AActor *Actor)
@@ -109,6 +130,11 @@ inline UMTD_HealthComponent *UMTD_HealthComponent::FindHealthComponent(const AAc
     return (IsValid(Actor)) ? (Actor->FindComponentByClass<UMTD_HealthComponent>()) : (nullptr);
 }
 
+inline bool UMTD_HealthComponent::IsLite() const
+{
+    return (LiteStats != nullptr);
+}
+
 inline EMTD_DeathState UMTD_HealthComponent::GetDeathState() const
 {
     return DeathState;
@@ -8,6 +8,7 @@
 class UMTD_ManaSet;
 class UMTD_ManaComponent;
 class UMTD_AbilitySystemComponent;
+struct FMTD_AttributeInitChange;
 struct FOnAttributeChangeData;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
@@ -51,6 +52,7 @@ protected:
 
     virtual void OnManaChanged(const FOnAttributeChangeData &ChangeData);
     virtual void OnMaxManaChanged(const FOnAttributeChangeData &ChangeData);
+    virtual void OnAttributesInitialized(TConstArrayView<FMTD_AttributeInitChange> Changes);
 
 public:
     UPROPERTY(BlueprintAssignable)
@@ -35,6 +35,9 @@ public:
 
     bool CheckPawnReadyToInitialize();
 
+    /** Whether the pawn has to be possessed to be ready to initialize. Pawns nobody possesses should turn it off. */
+    void SetRequiresController(bool bInRequiresController);
+
     UFUNCTION(BlueprintCallable, Category="MTD|Pawn", meta=(ExpandBoolAsExecs="ReturnValue"))
     bool IsPawnReadyToInitialize() const;
 
@@ -48,6 +51,10 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure)
     UAnimMontage *GetRandomAnimMontage(FGameplayTag AbilityTag) const;
 
+    /** Animation montage to play for an attack with the given combo index. Montages are cycled through in order. */
+    UFUNCTION(BlueprintCallable, BlueprintPure)
+    UAnimMontage *GetComboAnimMontage(FGameplayTag AbilityTag, int32 ComboIndex) const;
+
 protected:
     virtual void OnRegister() override;
 
@@ -78,6 +85,7 @@ private:
     TObjectPtr<const UMTD_AbilityAnimationSet> AnimationSet = nullptr;
 
     bool bPawnReadyToInitialize = false;
+    bool bRequiresController = true;
 };
 
 inline UMTD_PawnExtensionComponent *UMTD_PawnExtensionComponent::FindPawnExtensionComponent(const AActor *Actor)
@@ -14,12 +14,15 @@ class AMTD_Projectile;
 class UBoxComponent;
 class UMTD_AbilityAnimationSet;
 class UMTD_AbilitySystemComponent;
+class UMTD_GameplayEffect;
 class UMTD_HealthComponent;
 class UMTD_HeroComponent;
 class UMTD_PawnExtensionComponent;
+class UMTD_ProjectileData;
 class UMTD_TowerData;
 class USphereComponent;
 struct FGameplayEffectSpecHandle;
+struct FOnAttributeChangeData;
 
 UCLASS()
 class MTD_API AMTD_Tower : public APawn, public IAbilitySystemInterface, public IMTD_GameResultInterface
@@ -103,7 +106,14 @@ private:
     void SetupProjectile(AMTD_Projectile &Projectile, AActor *FireTarget);
     void SetupProjectileCollision(AMTD_Projectile &Projectile) const;
     void SetupProjectileMovement(AMTD_Projectile &Projectile, AActor *FireTarget) const;
-    void SetupProjectileGameplayEffectClasses(AMTD_Projectile &Projectile) const;
+    void SetupProjectileGameplayEffectClasses(AMTD_Projectile &Projectile);
+
+    /** Make the specs of the gameplay effects projectiles apply on hit. They are shared by all the projectiles. */
+    void BuildProjectileGameplayEffectSpecs();
+    void GetProjectileGameplayEffectClasses(
+        const UMTD_ProjectileData &ProjectileData,
+        TArray<TSubclassOf<UMTD_GameplayEffect>> &OutGeClasses) const;
+    void OnProjectileSourceAttributeChanged(const FOnAttributeChangeData &ChangeData);
     void SetupProjectileHitCallback();
 
     virtual void OnProjectileHit(const FGameplayEventData *EventData);
@@ -132,6 +142,11 @@ public:
     virtual UAbilitySystemComponent *GetAbilitySystemComponent() const override;
     //~End IAbilitySystemInterface interface
 
+#if !UE_BUILD_SHIPPING
+    /** Compare preparing projectile specs per hit against patching the cached ones, and log timings and allocations. */
+    void RunProjectileSpecBenchmark(int32 Count);
+#endif
+
 public:
     UPROPERTY(BlueprintAssignable)
     FDynamicMulticastSignature OnAttributesChanged;
@@ -190,6 +205,13 @@ private:
 
     bool bIsReloading = false;
 
+    /** Specs every projectile applies on hit. Rebuilt once attributes or level have changed. */
+    TArray<FGameplayEffectSpecHandle> ProjectileGameplayEffectSpecs;
+
+    /** Level the projectile specs have been built with. */
+    float ProjectileGameplayEffectSpecsLevel = -1.f;
+    bool bProjectileGameplayEffectSpecsDirty = true;
+
     FTimerHandle ReloadTimerHandle;
 };
 
@@ -11,12 +11,25 @@ class MTD_API UMTD_AttackNotifyState : public UAnimNotifyState
 	GENERATED_BODY()
 
 public:
+    //~UObject Interface
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) override;
+#endif
+    //~End of UObject Interface
+
     virtual void NotifyBegin(USkeletalMeshComponent *MeshComp, UAnimSequenceBase *Animation,
         float TotalDuration) override;
     
     virtual void NotifyEnd(USkeletalMeshComponent *MeshComp, UAnimSequenceBase *Animation) override;
 
+private:
+    void CacheMeleeHitboxIds();
+
 private:
     UPROPERTY(EditAnywhere, Category="MTD|Combat System")
     TArray<FName> MeleeHitboxNicknames;
+
+    /** IDs of the hitboxes looked up on load, so that no names are looked up on each notify. */
+    TArray<uint16> MeleeHitboxIds;
 };
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "mtd.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "MTD_KnockbackSubsystem.generated.h"
+
+class AMTD_BaseEnemyCharacter;
+class AMTD_EnemyController;
+struct FMTD_BalanceHit;
+
+/**
+ * World subsystem that knocks enemies back in a single pass per frame.
+ *
+ * Knockbacks queued during a frame set the knockback blackboard key of their controllers all at once, and the key is
+ * reset once the knockback time runs out. Expiration times are kept in a single array instead of a timer per
+ * controller; every knockback lasts the same, hence the array is always sorted.
+ */
+UCLASS(Config=Game)
+class MTD_API UMTD_KnockbackSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UMTD_KnockbackSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaSeconds) override;
+    virtual TStatId GetStatId() const override;
+    //~End of FTickableGameObject Interface
+
+    /** Knock the controlled enemy back on this frame. Ignored if it's being knocked back already. */
+    void QueueKnockback(AMTD_EnemyController *Controller, const FMTD_BalanceHit &HitData);
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Knock the wave back round after round with balance hits that go the whole way real ones do, and log the timings
+     * along with how many knockbacks have been applied and how many objects have been created meanwhile.
+     */
+    void RunKnockbackBenchmark(const TArray<AMTD_BaseEnemyCharacter*> &Wave, int32 Rounds);
+#endif
+
+private:
+    /** Set the knockback key of every queued controller. Returns how many controllers have been knocked back. */
+    int32 ApplyKnockbacks(double NowSeconds);
+
+    /** Reset the knockback key of the controllers whose knockback has ended by the given time. */
+    void ExpireKnockbacks(double NowSeconds);
+
+private:
+    struct FActiveKnockback
+    {
+        TWeakObjectPtr<AMTD_EnemyController> Controller;
+        double EndSeconds = 0.0;
+    };
+
+    /** Seconds the knockback blackboard key stays set for. */
+    UPROPERTY(Config)
+    float KnockbackKeySeconds = 0.01f;
+
+    /** Controllers to knock back on this frame. */
+    TArray<TWeakObjectPtr<AMTD_EnemyController>> PendingKnockbacks;
+
+    /** Controllers being knocked back, ordered by the time their knockbacks end at. */
+    TArray<FActiveKnockback> ActiveKnockbacks;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "mtd.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Stats of a character that resolves hits natively instead of through an ability system.
+ * @see UMTD_EnemyData::bLiteCombat
+ */
+struct FMTD_LiteCombatStats
+{
+    float Health = 0.f;
+    float MaxHealth = 0.f;
+    float Damage = 0.f;
+    float BalanceDamage = 0.f;
+    float BalanceThreshold = 0.f;
+    float BalanceResist = 0.f;
+};
+
+/**
+ * Hit resolution for characters with lite combat stats. Damage is computed the same way damage and balance damage
+ * executions do, and is reported through health and balance components as if the attribute sets changed.
+ */
+struct MTD_API FMTD_LiteCombat
+{
+    /** Whether the actor resolves hits natively. */
+    static bool IsLiteTarget(const AActor *Actor);
+
+    /**
+     * Deal damage and balance damage to the actor if it resolves hits natively. The damage cue is executed on the actor
+     * the same way the damage gameplay effect would.
+     * @return True if the hit has been resolved, false if the actor has an ability system or no health at all.
+     */
+    static bool ApplyHit(
+        AActor *Target,
+        float Damage,
+        float BalanceDamage,
+        const FVector &KnockbackDirection,
+        AActor *DamageInstigator);
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Log memory an enemy takes with and without lite combat, and the cost of a hit dealt to either, by resolving the
+     * given amount of hits over the enemies in the world. Hits deal damage, so that health, death and the damage cue
+     * are paid for the same as in game.
+     */
+    static void RunLiteCombatBenchmark(UWorld *World, int32 HitCount, float Damage);
+#endif
+};
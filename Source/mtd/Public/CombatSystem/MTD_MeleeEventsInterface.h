@@ -19,6 +19,10 @@ public:
 	virtual void AddMeleeHitboxes(const TArray<FName> &HitboxNicknames) = 0;
 	virtual void RemoveMeleeHitboxes(const TArray<FName> &HitboxNicknames) = 0;
 
+	/** Same as the above, but with hitbox IDs from FMTD_MeleeHitboxIds. */
+	virtual void AddMeleeHitboxesById(TConstArrayView<uint16> HitboxIds) = 0;
+	virtual void RemoveMeleeHitboxesById(TConstArrayView<uint16> HitboxIds) = 0;
+
     virtual void DisableMeleeHitboxes() = 0;
     virtual void ResetMeleeHitTargets() = 0;
 };
@@ -34,7 +34,7 @@ class MTD_API UMTD_MeleeHitboxData : public UDataAsset
 
 public:
     UFUNCTION(BlueprintPure)
-    TArray<FMTD_MeleeHitSphereDefinition> GetMeleeHitSpheres(TArray<int32> Indices);
+    TArray<FMTD_MeleeHitSphereDefinition> GetMeleeHitSpheres(const TArray<int32> &Indices) const;
     
 public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -48,4 +48,26 @@ struct FMTD_ActiveHitboxEntry
 
 public:
     FMTD_MeleeHitSphereDefinition HitboxInfo;
+
+    /** World location the hitbox has been traced at on the previous frame. */
+    FVector PreviousLocation = FVector::ZeroVector;
+
+    /** Whether the hitbox has been traced since it was activated, i.e. if previous location is valid. */
+    bool bHasPreviousLocation = false;
+};
+
+/**
+ * Registry of small integer IDs of melee hitbox nicknames. An ID is assigned once per nickname, so that characters may
+ * find their hitboxes by index instead of hashing names on each attack.
+ */
+struct MTD_API FMTD_MeleeHitboxIds
+{
+public:
+    static constexpr uint16 InvalidId = MAX_uint16;
+
+    /** Get ID of the nickname, registering it if it's new. Safe to call while loading. */
+    static uint16 FindOrAdd(FName Nickname);
+
+    /** Get ID of the nickname, or InvalidId if it has never been registered. */
+    static uint16 Find(FName Nickname);
 };
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "mtd.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "MTD_MeleeTraceSubsystem.generated.h"
+
+class AMTD_BaseCharacter;
+struct FMTD_ActiveHitboxEntry;
+
+/**
+ * World subsystem that traces active melee hitboxes of all characters in a single pass per frame.
+ *
+ * Each hitbox is swept from where it was on the previous frame to where it's now, hence fast swings can't skip over
+ * targets in between frames.
+ *
+ * Optionally, hitboxes of non-player characters are traced with async overlaps of the capsule between the two
+ * locations, and hits are performed on the next frame. Amount of async queries per frame is limited; characters that
+ * don't fit into the budget are traced on a later frame, sweeping the whole distance their hitboxes have travelled.
+ * Attacks close to player pawns are issued first, the rest take whatever budget is left. A query that isn't done by
+ * the next frame is swept synchronously instead.
+ */
+UCLASS(Config=Game)
+class MTD_API UMTD_MeleeTraceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UMTD_MeleeTraceSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaSeconds) override;
+    virtual TStatId GetStatId() const override;
+    //~End of FTickableGameObject Interface
+
+    /** Start tracing active hitboxes of the character each frame. */
+    void RegisterMeleeCharacter(AMTD_BaseCharacter *Character);
+
+    /** Stop tracing hitboxes of the character. */
+    void UnregisterMeleeCharacter(AMTD_BaseCharacter *Character);
+
+    /** Sweep active hitboxes of all the registered characters, and perform hits on whatever they touch. */
+    void TraceMelee();
+
+    /** Whether non-player characters are traced asynchronously. */
+    void SetAsyncQueriesEnabled(bool bEnabled);
+    bool AreAsyncQueriesEnabled() const;
+
+    /** Sweep a sphere between two points. Identical points make it an overlap at the point. */
+    static bool SweepHitbox(const UWorld *World, const FVector &Start, const FVector &End, float Radius,
+        const FCollisionObjectQueryParams &ObjectParams, const FCollisionQueryParams &QueryParams,
+        TArray<FHitResult> &OutHits);
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Activate all hitboxes of every character in the world, trace them for a number of frames with per-hitbox
+     * Blueprint library traces, with the batched sweeps, and with async overlaps, and log the game thread timings. No
+     * hits are performed.
+     */
+    void RunMeleeSwarmBenchmark(int32 Frames);
+
+    /**
+     * Move a hitbox across the first player's capsule within a single frame, and check that the sweep hits it while
+     * a trace at the hitbox's current position, like it used to be made, misses.
+     */
+    void RunTunnellingCheck();
+#endif
+
+private:
+    /**
+     * Sweep active hitboxes of a single character.
+     * @param   Character       Character to sweep hitboxes of.
+     * @param   bPerformHits    If false, nothing is hit, and hit targets are left untouched.
+     */
+    void TraceCharacter(AMTD_BaseCharacter *Character, bool bPerformHits);
+
+    /**
+     * Issue async overlaps for active hitboxes of a single character. Hits are performed once the results are in.
+     * @return  Amount of issued queries.
+     */
+    int32 IssueAsyncQueries(AMTD_BaseCharacter *Character);
+
+    /** Perform hits found by the async queries issued on the previous frame. */
+    void ResolveAsyncQueries();
+
+    /** Trace the characters that may be traced asynchronously, the ones close to player pawns first. */
+    void TraceCharactersAsync(const TArray<AMTD_BaseCharacter*> &Characters);
+
+    /**
+     * Issue async overlaps for the characters in turns, starting at the offset, until the frame budget is used up.
+     * @param   InOutOffset     Character to start with. Set to the first one left out, so that no one is starved.
+     * @param   InOutQueries    Queries issued this frame so far.
+     * @return  Amount of characters left out.
+     */
+    int32 IssueAsyncQueriesWithinBudget(
+        const TArray<AMTD_BaseCharacter*> &Characters,
+        int32 &InOutOffset,
+        int32 &InOutQueries);
+
+    /** Move the hitbox to the current character's location, and get the segment it has travelled since last trace. */
+    static void AdvanceHitbox(FMTD_ActiveHitboxEntry &HitboxEntry, const FVector &ActorLocation,
+        const FRotator &ForwardRot, FVector &OutStart, FVector &OutEnd);
+
+    /** Perform hits of the character on the actors it hasn't hit yet during this attack. */
+    static void PerformHits(AMTD_BaseCharacter *Character, const TArray<FHitResult> &Hits);
+
+private:
+    /** Async overlap of a single hitbox waiting for its results. */
+    struct FAsyncMeleeQuery
+    {
+        TWeakObjectPtr<AMTD_BaseCharacter> Character;
+        FTraceHandle Handle;
+
+        /** Segment the hitbox has travelled. Swept synchronously if the query isn't done in time. */
+        FVector Start = FVector::ZeroVector;
+        FVector Location = FVector::ZeroVector;
+        float Radius = 0.f;
+    };
+
+    /** If true, hitboxes of non-player characters are traced asynchronously. */
+    UPROPERTY(Config)
+    bool bAsyncQueries = false;
+
+    /**
+     * Maximum amount of async overlaps issued per frame, including the ones of attacks close to player pawns. Every
+     * hitbox is a single overlap.
+     */
+    UPROPERTY(Config)
+    int32 MaxAsyncQueriesPerFrame = 64;
+
+    /** Attacks of characters within this distance to a player pawn are traced before any other. */
+    UPROPERTY(Config)
+    float PlayerFacingDistance = 1500.f;
+
+    UPROPERTY()
+    TArray<TObjectPtr<AMTD_BaseCharacter>> MeleeCharacters;
+
+    /** Queries issued on this frame, and the ones that have been issued on the previous one. */
+    TArray<FAsyncMeleeQuery> IssuedQueries;
+    TArray<FAsyncMeleeQuery> ResolvingQueries;
+
+    /** Characters that are traced asynchronously this frame. Kept around to not allocate them every frame. */
+    TArray<AMTD_BaseCharacter*> AsyncCharacters;
+    TArray<AMTD_BaseCharacter*> PlayerFacingCharacters;
+    TArray<AMTD_BaseCharacter*> DeferredCharacters;
+
+    /** Index of the character to start the next frame with, so that no character is starved. */
+    int32 PlayerFacingCharacterOffset = 0;
+    int32 DeferredCharacterOffset = 0;
+
+    /** Hits of a character gathered over all its hitboxes. Kept around to not allocate them every frame. */
+    TArray<FHitResult> PendingHits;
+    TArray<FHitResult> HitboxHits;
+
+    /** Whether characters are being traced. Unregistered characters are only nulled out meanwhile. */
+    bool bTracing = false;
+};
@@ -30,6 +30,12 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category="MTD|Game Mode")
     virtual AActor *GetGameTarget(APawn *Client) const;
 
+    /**
+     * Game target a pawn moves to when it has no target, looked up through the authority game mode only once the
+     * cached one is gone, since resolving it requires path finding.
+     */
+    static AActor *GetCachedGameTarget(APawn *Client, TWeakObjectPtr<AActor> &CachedGameTarget);
+
 protected:
     UFUNCTION(BlueprintCallable, Category="MTD|Game Mode")
     void TerminateGame(EMTD_GameResult Reason);
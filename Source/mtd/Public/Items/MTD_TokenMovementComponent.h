@@ -6,6 +6,8 @@
 
 #include "MTD_TokenMovementComponent.generated.h"
 
+class AWorldSettings;
+
 /**
  * TokenMovementComponent updates the position of another component during its tick.
  *
@@ -66,6 +68,7 @@ public:
 
     //~UMovementComponent Interface
     virtual void InitializeComponent() override;
+    virtual void UninitializeComponent() override;
     virtual void UpdateTickRegistration() override;
     
     virtual float GetMaxSpeed() const override;
@@ -154,18 +157,55 @@ protected:
     virtual float GetGravityZ() const override;
     bool ShouldApplyGravity() const;
 
-    /**
-     * Clears the reference to UpdatedComponent, fires stop event (OnTokenStopDelegate), and stops ticking
-     * (if bAutoUpdateTickRegistration is true).
-     */
+    /** Puts the token to sleep, and fires stop event (OnTokenStopDelegate). */
     virtual void StopSimulating(const FHitResult &HitResult);
     bool HasStoppedSimulation() const;
 
     /** Check whether the token is still in the world. Check KillZ, world bounds, and handle the situation. */
     virtual bool CheckStillInWorld();
-    
+
+    /**
+     * Accumulate time the token has spent under the sleep velocity threshold, and put it to sleep once it has been
+     * settled for long enough.
+     * @return True if the token has been put to sleep.
+     */
+    bool UpdateSleepState(float DeltaSeconds, const FHitResult &Hit);
+
 public:
-    /** Adds a force which is accumulated until next tick, used by ComputeAcceleration() to affect Velocity. */
+    /**
+     * Zero velocity and unregister the tick. A sleeping token keeps its updated component, and is woken up by a
+     * non-zero force, a new homing target, or an explicit WakeUp() call.
+     */
+    UFUNCTION(BlueprintCallable, Category="MTD|Token Movement Component")
+    void Sleep();
+
+    /** Restore the updated component if needed, and re-enable the tick. */
+    UFUNCTION(BlueprintCallable, Category="MTD|Token Movement Component")
+    void WakeUp();
+
+    UFUNCTION(BlueprintPure, Category="MTD|Token Movement Component")
+    bool IsSleeping() const;
+
+    /** Set the homing target, and wake the token up if there is something to home towards. */
+    UFUNCTION(BlueprintCallable, Category="MTD|Token Movement Component")
+    void SetHomingTarget(USceneComponent *InHomingTarget);
+
+private:
+    enum class ESleepState : uint8
+    {
+        None,
+        Awake,
+        Asleep
+    };
+
+    /** Switch sleep state, keeping awake/sleeping token counters in sync. */
+    void SetSleepState(ESleepState NewState);
+
+public:
+    /**
+     * Adds a force which is accumulated until next tick, used by ComputeAcceleration() to affect Velocity. Wakes the
+     * token up if it's sleeping.
+     */
     UFUNCTION(BlueprintCallable, Category="MTD|Token Movement Component")
     void AddForce(FVector Force);
 
@@ -201,6 +241,15 @@ private:
         meta=(AllowPrivateAccess="true"))
     FVector PendingForce = FVector::ZeroVector;
 
+    ESleepState SleepState = ESleepState::None;
+
+    /** Seconds the token has spent under SleepVelocityThreshold without a homing target. */
+    float SettledTime = 0.f;
+
+    /** World settings cached on initialization to avoid looking them up on each world bounds check. */
+    UPROPERTY(Transient)
+    TObjectPtr<AWorldSettings> CachedWorldSettings = nullptr;
+
 public:
     /** Limit on speed of the token (0 means no limit). */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MTD|Token Movement Component")
@@ -287,6 +336,25 @@ public:
         meta=(ClampMin="0.0", ClampMax="1.0"))
     float MinFrictionFraction = 0.f;
 
+    /**
+     * If true, a token that has no homing target and stays under SleepVelocityThreshold for SleepDelay seconds goes
+     * to sleep, unregistering its tick until it's woken up.
+     * @see Sleep(), WakeUp()
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MTD|Token Sleep")
+    bool bCanSleep = true;
+
+    /** Velocity magnitude under which the token is considered settled. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MTD|Token Sleep", meta=(ClampMin="0.0"))
+    float SleepVelocityThreshold = 10.f;
+
+    /**
+     * Seconds the token has to stay settled before going to sleep. Prevents tokens from falling asleep at the apex of
+     * a jump.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MTD|Token Sleep", meta=(ClampMin="0.0"))
+    float SleepDelay = 0.2f;
+
     /** If true, the token will slide / roll along a surface. */
     UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="MTD|Token Bounces")
     bool bIsSliding = false;
@@ -359,12 +427,12 @@ inline bool UMTD_TokenMovementComponent::ShouldApplyGravity() const
 
 inline bool UMTD_TokenMovementComponent::HasStoppedSimulation() const
 {
-    return ((!IsValid(UpdatedComponent)) || (!IsActive()));
+    return ((!IsValid(UpdatedComponent)) || (!IsActive()) || (IsSleeping()));
 }
 
-inline void UMTD_TokenMovementComponent::AddForce(FVector Force)
+inline bool UMTD_TokenMovementComponent::IsSleeping() const
 {
-    PendingForce += Force;
+    return (SleepState == ESleepState::Asleep);
 }
 
 inline FVector UMTD_TokenMovementComponent::GetPendingForce() const
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "mtd.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "MTD_EnemyAiSubsystem.generated.h"
+
+class AMTD_BaseCharacter;
+class AMTD_EnemyController;
+
+UENUM(BlueprintType)
+enum class EMTD_EnemyAiState : uint8
+{
+    MoveToCore,
+    ChaseTarget,
+    Attack,
+    Knockback,
+    Dead
+};
+
+/**
+ * World subsystem driving enemies with a native state machine instead of behavior trees.
+ *
+ * Enemies move towards the game target, chase their targets, attack whatever is in their attack trigger, and stand
+ * still while knocked back. All of them are updated in a single loop; at most a limited amount of enemies is updated
+ * per frame, the rest are updated on the following frames in a round-robin manner.
+ *
+ * @see UMTD_EnemyData::bUseNativeAi
+ */
+UCLASS(Config=Game)
+class MTD_API UMTD_EnemyAiSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UMTD_EnemyAiSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaSeconds) override;
+    virtual TStatId GetStatId() const override;
+    //~End of FTickableGameObject Interface
+
+    /** Start driving the controller's pawn. */
+    void RegisterController(AMTD_EnemyController *Controller);
+
+    /** Stop driving the controller's pawn. */
+    void UnregisterController(AMTD_EnemyController *Controller);
+
+    /** Knock the controller's pawn back for the given amount of seconds. */
+    void KnockBack(AMTD_EnemyController *Controller, float Seconds);
+
+    /** State the controller's pawn is in. Dead if the controller is not registered. */
+    EMTD_EnemyAiState GetState(const AMTD_EnemyController *Controller) const;
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Spawn a wave from the first character spawner, drive it by behavior trees for a number of frames, then by the
+     * state machine for as many, and log the world tick time of either.
+     */
+    void StartEnemyAiBenchmark(int32 EnemyCount, int32 Frames);
+#endif
+
+private:
+    /** Enemy driven by the state machine. */
+    struct FEnemyAgent
+    {
+        TWeakObjectPtr<AMTD_EnemyController> Controller;
+
+        /** Actor the enemy has been told to move to the last time. */
+        TWeakObjectPtr<AActor> MoveGoal;
+
+        /** @see AMTD_GameModeBase::GetCachedGameTarget */
+        TWeakObjectPtr<AActor> GameTarget;
+
+        double StateEndSeconds = 0.0;
+        EMTD_EnemyAiState State = EMTD_EnemyAiState::MoveToCore;
+    };
+
+    void UpdateAgent(FEnemyAgent &Agent, double NowSeconds) const;
+
+#if !UE_BUILD_SHIPPING
+    void SetBenchmarkWaveAi(bool bNativeAi);
+    void StopEnemyAiBenchmark();
+    void OnBenchmarkWorldTickStart(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds);
+    void OnBenchmarkWorldPostActorTick(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds);
+#endif
+
+private:
+    /** Maximum amount of enemies updated per frame. */
+    UPROPERTY(Config)
+    int32 MaxAgentsPerFrame = 100;
+
+    /** Distance to the move goal enemies stop at. */
+    UPROPERTY(Config)
+    float AcceptanceRadius = 50.f;
+
+    TArray<FEnemyAgent> Agents;
+
+    /** Index of the agent to start the next frame with. */
+    int32 NextAgentIndex = 0;
+
+#if !UE_BUILD_SHIPPING
+    /** Enemy AI benchmark in progress. The wave is driven by behavior trees first, by the state machine second. */
+    struct FEnemyAiBenchmark
+    {
+        TArray<TWeakObjectPtr<AMTD_BaseCharacter>> Wave;
+
+        int32 Frames = 0;
+
+        /** Frames measured of the current mode, negative while the wave settles. */
+        int32 Frame = 0;
+        bool bNativeAi = false;
+
+        double TickStartSeconds = 0.0;
+        double TickSeconds[2] = {0.0, 0.0};
+
+        FDelegateHandle TickStartHandle;
+        FDelegateHandle PostActorTickHandle;
+    };
+
+    TOptional<FEnemyAiBenchmark> Benchmark;
+#endif
+};
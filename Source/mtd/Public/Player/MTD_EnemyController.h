@@ -1,21 +1,30 @@
 #pragma once
 
 #include "AIController.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Character/MTD_BalanceComponent.h"
 #include "Character/MTD_TeamComponent.h"
 #include "mtd.h"
+#include "Utility/MTD_BlackboardKey.h"
 
 #include "MTD_EnemyController.generated.h"
 
-class UBehaviorTreeComponent;
-class UMTD_BalanceHitData;
 class AMTD_BaseEnemyCharacter;
+class UBehaviorTreeComponent;
 class UMovementComponent;
+class UMTD_EnemyAiSubsystem;
+class UMTD_KnockbackSubsystem;
 
 UCLASS()
 class MTD_API AMTD_EnemyController : public AAIController
 {
     GENERATED_BODY()
 
+    friend UMTD_EnemyAiSubsystem;
+    friend UMTD_KnockbackSubsystem;
+
 public:
     AMTD_EnemyController();
     virtual void Tick(float DeltaSeconds) override;
@@ -26,6 +35,10 @@ public:
     }
 
 protected:
+    //~AActor Interface
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    //~End of AActor Interface
+
     //~AAIController Interface
     virtual void OnPossess(APawn *InPawn) override;
     //~End of AAIController Interface
@@ -50,12 +63,16 @@ private:
     void OnStopAttacking();
 
     UFUNCTION()
-    void OnKnockback(const UMTD_BalanceHitData *HitData);
+    void OnKnockback(const FMTD_BalanceHit &HitData);
 
-    UFUNCTION()
-    void ResetKnockback();
+    /** Called by the knockback subsystem, which batches knockbacks of all the enemies. */
+    void SetKnockback(bool bInKnockback);
+
+    /** Switch the pawn between the native state machine and the behavior tree. */
+    void SetNativeAi(bool bInNativeAi);
 
     void StartRunningBehaviorTree(AMTD_BaseEnemyCharacter *Enemy);
+    void ResolveBlackboardKeys();
     void SetupKnockbacks(AMTD_BaseEnemyCharacter *Enemy);
 
 private:
@@ -68,7 +85,26 @@ private:
     UPROPERTY()
     TObjectPtr<UMovementComponent> OwnerMovementComponent = nullptr;
 
+    /** Blackboard keys the controller writes to, resolved once the blackboard is initialized. */
+    TMTD_BlackboardKey<UBlackboardKeyType_Object> TargetKey{ TEXT("Target") };
+    TMTD_BlackboardKey<UBlackboardKeyType_Bool> AttackKey{ TEXT("Attack") };
+    TMTD_BlackboardKey<UBlackboardKeyType_Bool> KnockbackKey{ TEXT("Knockback") };
+    TMTD_BlackboardKey<UBlackboardKeyType_Float> KnockbackTimeKey{ TEXT("KnockbackTime") };
+
+    /** Actor the pawn is targeting, read by the native state machine. */
+    UPROPERTY()
+    TObjectPtr<AActor> Target = nullptr;
+
+    /** Seconds a knockback lasts for the pawn. */
+    float KnockbackTime = 0.f;
+
     bool bAttack = false;
-    FTimerHandle KnockbackTimerHandle;
+    bool bKnockback = false;
+
+    /** Whether the pawn is driven by the native state machine instead of the behavior tree. */
+    bool bNativeAi = false;
+
+    /** Index in the native state machine's enemies, maintained by the subsystem. */
+    int32 NativeAiIndex = INDEX_NONE;
 };
 
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "mtd.h"
+#include "Player/MTD_EnemyAiSubsystem.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "MTD_EnemyCrowdSubsystem.generated.h"
+
+class AMTD_BaseCharacter;
+class AMTD_BaseEnemyCharacter;
+class AMTD_CharacterSpawner;
+
+/**
+ * World subsystem moving controller-less enemies.
+ *
+ * Enemies are steered along navigation paths towards their targets, or the game target if they have none, by writing
+ * move requests directly to their character movement components. Paths are found synchronously, hence their amount
+ * per frame is limited; steering itself is cheap and done for every enemy every frame.
+ *
+ * @see UMTD_EnemyData::bControllerless
+ */
+UCLASS(Config=Game)
+class MTD_API UMTD_EnemyCrowdSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UMTD_EnemyCrowdSubsystem *Get(const UObject *WorldContextObject);
+
+    //~USubsystem Interface
+    virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+    virtual void Deinitialize() override;
+    //~End of USubsystem Interface
+
+    //~FTickableGameObject Interface
+    virtual void Tick(float DeltaSeconds) override;
+    virtual TStatId GetStatId() const override;
+    //~End of FTickableGameObject Interface
+
+    /** Start moving the enemy. */
+    void RegisterEnemy(AMTD_BaseEnemyCharacter *Enemy);
+
+    /** Stop moving the enemy. Does nothing if the enemy is not registered. */
+    void UnregisterEnemy(AMTD_BaseEnemyCharacter *Enemy);
+
+    /** Stop the enemy for the given amount of seconds. */
+    void KnockBack(AMTD_BaseEnemyCharacter *Enemy, float Seconds);
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Spawn a wave of lite enemies from the first character spawner with controllers, then the very same wave
+     * controller-less, and log the amount of actors and the world tick time of either over a number of frames.
+     */
+    void StartCrowdBenchmark(int32 EnemyCount, int32 Frames);
+#endif
+
+private:
+    /** Enemy moved by the subsystem. */
+    struct FCrowdAgent
+    {
+        TWeakObjectPtr<AMTD_BaseEnemyCharacter> Enemy;
+
+        /** Actor the path leads to. */
+        TWeakObjectPtr<AActor> PathGoal;
+
+        /** @see AMTD_GameModeBase::GetCachedGameTarget */
+        TWeakObjectPtr<AActor> GameTarget;
+
+        TArray<FVector> PathPoints;
+        int32 PathPointIndex = 0;
+
+        double RepathSeconds = 0.0;
+        double StateEndSeconds = 0.0;
+        EMTD_EnemyAiState State = EMTD_EnemyAiState::MoveToCore;
+    };
+
+    /**
+     * Steer the agent along its path.
+     * @return True if the agent needs a new path.
+     */
+    bool UpdateAgent(FCrowdAgent &Agent, double NowSeconds) const;
+
+    void FindPath(FCrowdAgent &Agent, AActor *Goal, double NowSeconds) const;
+    AActor *GetGoal(FCrowdAgent &Agent) const;
+
+#if !UE_BUILD_SHIPPING
+    void SpawnBenchmarkWave();
+    void DestroyBenchmarkWave();
+    void StopCrowdBenchmark();
+    void OnBenchmarkWorldTickStart(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds);
+    void OnBenchmarkWorldPostActorTick(UWorld *InWorld, ELevelTick TickType, float DeltaSeconds);
+#endif
+
+private:
+    /** Maximum amount of paths found per frame. */
+    UPROPERTY(Config)
+    int32 MaxPathsPerFrame = 20;
+
+    /** Seconds a path to a moving target is kept for before it's found again. */
+    UPROPERTY(Config)
+    float RepathSeconds = 1.f;
+
+    /** Distance to a path point enemies move to the next one at. */
+    UPROPERTY(Config)
+    float PathPointRadius = 50.f;
+
+    /** Distance to the goal enemies stop at. */
+    UPROPERTY(Config)
+    float AcceptanceRadius = 50.f;
+
+    TArray<FCrowdAgent> Agents;
+
+    /** Index of the agent to start finding paths from the next frame. */
+    int32 NextPathAgentIndex = 0;
+
+#if !UE_BUILD_SHIPPING
+    /** Crowd benchmark in progress. The wave with controllers is measured first, the controller-less one second. */
+    struct FCrowdBenchmark
+    {
+        TWeakObjectPtr<AMTD_CharacterSpawner> Spawner;
+        TArray<TWeakObjectPtr<AMTD_BaseCharacter>> Wave;
+
+        int32 EnemyCount = 0;
+        int32 Frames = 0;
+
+        /** Frames measured of the current wave, negative while it settles. */
+        int32 Frame = 0;
+        bool bControllerless = false;
+
+        double TickStartSeconds = 0.0;
+        double TickSeconds[2] = {0.0, 0.0};
+        int32 Actors[2] = {0, 0};
+
+        FDelegateHandle TickStartHandle;
+        FDelegateHandle PostActorTickHandle;
+    };
+
+    TOptional<FCrowdBenchmark> Benchmark;
+#endif
+};
@@ -7,6 +7,7 @@
 
 #include "MTD_Projectile.generated.h"
 
+class AMTD_BaseCharacter;
 class UMTD_GameplayEffect;
 class UMTD_ProjectileMovementComponent;
 class UMTD_TeamComponent;
@@ -24,11 +25,48 @@ public:
     void InitializeAbilitySystem(UAbilitySystemComponent *InAbilitySystemComponent);
     
     void AddGameplayEffectClassToGrantOnHit(const TSubclassOf<UMTD_GameplayEffect> &GeClass);
+
+    /**
+     * Add specs to apply on hit. Specs are expected to be shared with other projectiles, hence they are never changed:
+     * every target gets a copy with the hit's context and SetByCaller magnitudes.
+     */
+    void AddGameplayEffectSpecsToGrantOnHit(const TArray<FGameplayEffectSpecHandle> &SpecHandles);
     void SetGameplayEffectDamageClass(const TSubclassOf<UMTD_GameplayEffect> &GeClass);
 
+    /** Gameplay effects every hit applies natively: balance damage, then damage. */
+    void GetHitGameplayEffectClasses(TArray<TSubclassOf<UMTD_GameplayEffect>> &OutGeClasses) const;
+
+    /**
+     * Make specs meant to be shared by many hits. Every SetByCaller magnitude a hit sets is added up front, so that the
+     * copies made per target don't grow the magnitude map, and their context is expected to be replaced.
+     */
+    static void MakeSharedGameplayEffectSpecs(
+        const UAbilitySystemComponent &Asc,
+        const TArray<TSubclassOf<UMTD_GameplayEffect>> &GeClasses,
+        float Level,
+        TArray<FGameplayEffectSpecHandle> &OutSpecHandles);
+
     UCapsuleComponent *GetCollisionComponent() const;
     UMTD_ProjectileMovementComponent *GetMovementComponent() const;
 
+    /**
+     * Find the actors a radial impact at the location reaches, using a single overlap query with the projectile
+     * collision profile.
+     */
+    void GatherRadialTargets(const FVector &Location, TArray<AActor*> &OutTargets) const;
+
+    /** Damage and balance damage multiplier of a target reached by a radial impact at the location. */
+    float GetRadialMultiplier(const AActor *Target, const FVector &ImpactLocation, const AActor *HitTarget) const;
+
+#if !UE_BUILD_SHIPPING
+    /**
+     * Time radial impacts at the location, and log how many targets each of them reaches. Then hit the cluster once
+     * for real, and verify that the expected characters have been hit with damage and balance damage scaled by the
+     * falloff.
+     */
+    void RunRadialImpactBenchmark(const FVector &Location, int32 Count, const TArray<AMTD_BaseCharacter*> &Cluster);
+#endif
+
 protected:
     virtual void BeginPlay() override;
 
@@ -46,11 +84,18 @@ protected:
     virtual void OnSelfDestroy_Implementation();
 
     virtual void ApplyGameplayEffectsToTarget(AActor *Target);
+
+    /** Apply the gameplay effects to every target around the impact, scaling damage down with distance. */
+    virtual void ApplyRadialGameplayEffects(AActor *HitTarget);
     
     UFUNCTION(BlueprintNativeEvent)
     void OnProjectilePostHit(const FGameplayEventData &EventData);
     virtual void OnProjectilePostHit_Implementation(const FGameplayEventData &EventData);
 
+    /**
+     * Called on every hit before the gameplay effects are applied. Projectiles with no native hit gameplay effects are
+     * expected to prepare their specs in here.
+     */
     UFUNCTION(BlueprintNativeEvent)
     void OnProjectilePreHit(const FGameplayEventData &EventData);
     virtual void OnProjectilePreHit_Implementation(const FGameplayEventData &EventData);
@@ -58,6 +103,21 @@ protected:
 private:
     FGameplayEventData PrepareGameplayEventData(FHitResult HitResult) const;
 
+    /** Whether the projectile blueprint has set any of the gameplay effects hits apply natively. */
+    bool HasNativeHitGameplayEffects() const;
+
+    /** Make the specs for projectiles that haven't been given shared ones, e.g. the ones fired by abilities. */
+    void BuildGameplayEffectSpecs();
+
+    /**
+     * Apply copies of the shared specs to the ability system component within the current hit's context, with the
+     * damage scaled by the multiplier.
+     */
+    void ApplyGameplayEffectSpecs(UAbilitySystemComponent *TargetAsc, float Multiplier) const;
+
+    /** Resolve the hit natively if the target uses lite combat. Returns false if it doesn't. */
+    bool ApplyLiteHit(AActor *Target, float Multiplier) const;
+
 public:
     UPROPERTY(BlueprintReadWrite)
     float Damage = 0.f;
@@ -68,7 +128,16 @@ public:
     UPROPERTY(BlueprintReadWrite)
     float BalanceDamage = 7.5f;
 
-    // TODO: Add radial damage
+    /** Whether the gameplay effects are applied to every target around the impact. */
+    UPROPERTY(BlueprintReadWrite)
+    bool bIsRadial = false;
+
+    UPROPERTY(BlueprintReadWrite)
+    float RadialDamageRadius = 100.f;
+
+    /** Damage multiplier on the edge of the radius. */
+    UPROPERTY(BlueprintReadWrite)
+    float RadialDamageEdgeMultiplier = 0.5f;
 
 protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="MTD|Components")
@@ -84,17 +153,29 @@ private:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="MTD|Projectile", meta=(AllowPrivateAccess="true", ClampMin="0.1"))
     float SecondsToSelfDestroy = 15.f;
     
+    /** Extra gameplay effects hits apply. They are folded into the specs once, when the first hit happens. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="MTD|Projectile", meta=(AllowPrivateAccess="true"))
     TArray<TSubclassOf<UMTD_GameplayEffect>> GameplayEffectClassesToGrantOnHit;
 
     UPROPERTY(BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
     TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent = nullptr;
     
-    UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
+    /**
+     * Damage gameplay effect every hit applies natively, set on the projectile blueprint. If neither this nor the
+     * balance one is set, OnProjectilePreHit has to prepare the specs.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="MTD|Projectile", meta=(AllowPrivateAccess="true"))
     TSubclassOf<UMTD_GameplayEffect> GameplayEffectDamageClass = nullptr;
 
+    /** Balance damage gameplay effect every hit applies natively along with the damage one, set on the blueprint. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="MTD|Projectile", meta=(AllowPrivateAccess="true"))
+    TSubclassOf<UMTD_GameplayEffect> GameplayEffectBalanceClass = nullptr;
+
     UPROPERTY(BlueprintReadWrite, meta=(AllowPrivateAccess="true"))
     TArray<FGameplayEffectSpecHandle> GameplayEffectsToGrantOnHit;
+
+    /** Context of the hit being processed, made with the hit result. */
+    FGameplayEffectContextHandle HitContextHandle;
 };
 
 inline UCapsuleComponent *AMTD_Projectile::GetCollisionComponent() const
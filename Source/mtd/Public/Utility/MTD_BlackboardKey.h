@@ -0,0 +1,69 @@
+#pragma once
+
+#include "BehaviorTree/BlackboardComponent.h"
+#include "mtd.h"
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blackboard Writes"), STAT_MtdBlackboardWrites, STATGROUP_Mtd, MTD_API);
+
+/**
+ * Blackboard key of a known type, resolved by name once rather than on every access.
+ *
+ * Key IDs are specific to a blackboard asset, hence the key has to be resolved again whenever the blackboard is
+ * initialized with a different one.
+ */
+template <class TKeyType>
+struct TMTD_BlackboardKey
+{
+public:
+    explicit TMTD_BlackboardKey(FName InName);
+
+    /** Find the key ID in the blackboard. The key stays invalid if the blackboard has no such key. */
+    void Resolve(const UBlackboardComponent &Blackboard);
+
+    bool IsValid() const;
+
+    /** Write the value. Does nothing if the key is invalid. */
+    void SetValue(UBlackboardComponent &Blackboard, typename TKeyType::FDataType Value) const;
+
+    /** Read the value. Returns the key type's default if the key is invalid. */
+    typename TKeyType::FDataType GetValue(const UBlackboardComponent &Blackboard) const;
+
+private:
+    FName Name;
+    FBlackboard::FKey Id = FBlackboard::InvalidKey;
+};
+
+template <class TKeyType>
+TMTD_BlackboardKey<TKeyType>::TMTD_BlackboardKey(FName InName)
+    : Name(InName)
+{
+}
+
+template <class TKeyType>
+void TMTD_BlackboardKey<TKeyType>::Resolve(const UBlackboardComponent &Blackboard)
+{
+    Id = Blackboard.GetKeyID(Name);
+}
+
+template <class TKeyType>
+bool TMTD_BlackboardKey<TKeyType>::IsValid() const
+{
+    return (Id != FBlackboard::InvalidKey);
+}
+
+template <class TKeyType>
+void TMTD_BlackboardKey<TKeyType>::SetValue(UBlackboardComponent &Blackboard,
+    typename TKeyType::FDataType Value) const
+{
+    if (IsValid())
+    {
+        Blackboard.SetValue<TKeyType>(Id, Value);
+        INC_DWORD_STAT(STAT_MtdBlackboardWrites);
+    }
+}
+
+template <class TKeyType>
+typename TKeyType::FDataType TMTD_BlackboardKey<TKeyType>::GetValue(const UBlackboardComponent &Blackboard) const
+{
+    return (IsValid()) ? (Blackboard.GetValue<TKeyType>(Id)) : (TKeyType::InvalidValue);
+}
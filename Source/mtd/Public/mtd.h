@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "MTD_Log.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("MTD"), STATGROUP_Mtd, STATCAT_Advanced);
 
 const FName AllyCollisionProfileName = TEXT("Ally");
 const FName PlayerCollisionProfileName = TEXT("Player");